@@ -58,9 +58,13 @@ class Queue : private NonCopyable
                                     const bool waitCompletion);
 
     // Submit given command buffers to queue and returns FenceObject for waiting
-    // submission completed
+    // submission completed. Submission waits for the given fences of the other
+    // queues before execution. Back buffer acquisition of the given swapchain is
+    // waited only by the first submission of the frame, and present is signaled
+    // only by the last one, as each binary semaphore can be used only once.
     FenceObject submitCommandBufferBatch(std::vector<std::shared_ptr<CommandBuffer>>&& batchedCommandBuffers, SwapChain* swapChain,
-                                         const FrameContext* frameContext, const bool waitAllCompletion);
+                                         const FrameContext* frameContext, const bool waitBackBufferReady, const bool signalPresentReady,
+                                         const bool waitAllCompletion, const std::vector<FenceObject>& fencesToWait = {});
 
     // Returns Timeline semaphore which synchronized with queue submission
     [[nodiscard]] inline VkSemaphore* getSubmitTimelineSemaphore()
@@ -92,6 +96,9 @@ class Queue : private NonCopyable
     // submission
     [[nodiscard]] uint64_t querySemaphoreValue();
 
+    // Block until timeline semaphore of this queue reaches the given fence value
+    void waitFenceValue(const uint64_t fenceValue);
+
  private:
     std::string _debugName;
     LogicalDevice* _logicalDevice{ nullptr };
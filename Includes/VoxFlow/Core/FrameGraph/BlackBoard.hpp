@@ -5,21 +5,55 @@
 
 #include <VoxFlow/Core/FrameGraph/Resource.hpp>
 #include <VoxFlow/Core/FrameGraph/ResourceHandle.hpp>
+#include <VoxFlow/Core/Utils/HashUtil.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
+#include <algorithm>
 #include <string_view>
-#include <unordered_map>
+#include <vector>
 
 namespace VoxFlow
 {
 namespace RenderGraph
 {
-class BlackBoard : private NonCopyable
+/**
+ * Identifier of blackboard entry. Name is hashed at compile time, so that blackboard lookup
+ * does no string operation. In debug build, name is kept to detect hash collision.
+ */
+class BlackBoardKey
 {
  public:
-    using KeyType = std::string_view;
-    using ValueType = ResourceHandle;
-    using ContainerType = std::unordered_map<KeyType, ValueType>;
+    template <std::size_t Length>
+    consteval BlackBoardKey(const char (&name)[Length])
+    {
+        const std::string_view nameView(name, Length - 1);
+        _hash = hash_fnv1a(nameView);
+#if defined(VOXFLOW_DEBUG)
+        _name = nameView;
+#endif
+    }
+
+    [[nodiscard]] inline constexpr uint32_t getHash() const
+    {
+        return _hash;
+    }
+
+#if defined(VOXFLOW_DEBUG)
+    [[nodiscard]] inline constexpr std::string_view getName() const
+    {
+        return _name;
+    }
+#endif
+
+ private:
+    uint32_t _hash = 0;
+#if defined(VOXFLOW_DEBUG)
+    std::string_view _name;
+#endif
+};
 
+class BlackBoard : private NonCopyable
+{
  public:
     BlackBoard() = default;
     ~BlackBoard() = default;
@@ -31,43 +65,221 @@ class BlackBoard : private NonCopyable
     {
         if (this != &rhs)
         {
-            _handleContainer = std::move(rhs._handleContainer);
+            _entries = std::move(rhs._entries);
+            _numEntries = rhs._numEntries;
+            _numRemovedEntries = rhs._numRemovedEntries;
+            rhs._numEntries = 0;
+            rhs._numRemovedEntries = 0;
         }
         return *this;
     }
 
  public:
-    ResourceHandle getHandle(std::string_view name) const
+    ResourceHandle getHandle(BlackBoardKey key) const
     {
-        ContainerType::const_iterator it = _handleContainer.find(name);
-        if (it != _handleContainer.cend())
+        const Entry* entry = findEntry(key);
+        if ((entry != nullptr) && (entry->_type == EntryType::ResourceHandle))
         {
-            return it->second;
+            return entry->_handle;
         }
         return INVALID_RESOURCE_HANDLE;
     }
-    ResourceHandle& operator[](std::string_view name)
+
+    ResourceHandle& operator[](BlackBoardKey key)
+    {
+        Entry& entry = insertEntry(key);
+        entry._type = EntryType::ResourceHandle;
+        entry._handle = INVALID_RESOURCE_HANDLE;
+        entry._passData = nullptr;
+        return entry._handle;
+    }
+
+    /**
+     * Publish pass data which is valid until the frame graph is reset
+     */
+    template <typename PassDataType>
+    void setPassData(BlackBoardKey key, const PassDataType& passData)
     {
-        auto [iter, _] = _handleContainer.insert_or_assign(name, INVALID_RESOURCE_HANDLE);
-        return iter->second;
+        Entry& entry = insertEntry(key);
+        entry._type = EntryType::PassData;
+        entry._handle = INVALID_RESOURCE_HANDLE;
+        entry._passData = &passData;
+        entry._passDataTypeID = getPassDataTypeID<PassDataType>();
     }
 
-    bool removeHandle(std::string_view name)
+    /**
+     * @return pass data published with the given key. nullptr if there is no such pass data
+     */
+    template <typename PassDataType>
+    [[nodiscard]] const PassDataType* getPassData(BlackBoardKey key) const
     {
-        const ContainerType::iterator iter = _handleContainer.find(name);
-        if (iter != _handleContainer.end())
+        const Entry* entry = findEntry(key);
+        if ((entry == nullptr) || (entry->_type != EntryType::PassData))
         {
-            _handleContainer.erase(iter);
+            return nullptr;
+        }
+
+        VOX_ASSERT(entry->_passDataTypeID == getPassDataTypeID<PassDataType>(), "Pass data of key({}) is requested with different type",
+                   key.getHash());
+        return static_cast<const PassDataType*>(entry->_passData);
+    }
+
+    bool remove(BlackBoardKey key)
+    {
+        Entry* entry = const_cast<Entry*>(findEntry(key));
+        if (entry != nullptr)
+        {
+            entry->_type = EntryType::Removed;
+            --_numEntries;
+            ++_numRemovedEntries;
             return true;
         }
         return false;
     }
 
+    // Overwrite entries with the ones published in the given blackboard
+    void merge(const BlackBoard& other)
+    {
+        for (const Entry& otherEntry : other._entries)
+        {
+            if ((otherEntry._type == EntryType::Empty) || (otherEntry._type == EntryType::Removed))
+            {
+                continue;
+            }
+
+            Entry& entry = insertEntry(otherEntry._key);
+            entry = otherEntry;
+        }
+    }
+
+    void clear()
+    {
+        std::fill(_entries.begin(), _entries.end(), Entry());
+        _numEntries = 0;
+        _numRemovedEntries = 0;
+    }
+
+    [[nodiscard]] inline uint32_t getNumEntries() const
+    {
+        return _numEntries;
+    }
+
  private:
-    ContainerType _handleContainer;
+    enum class EntryType : uint8_t
+    {
+        Empty = 0,
+        Removed = 1,
+        ResourceHandle = 2,
+        PassData = 3,
+    };
+
+    struct Entry
+    {
+        BlackBoardKey _key = "";
+        EntryType _type = EntryType::Empty;
+        ResourceHandle _handle;
+        const void* _passData = nullptr;
+        const void* _passDataTypeID = nullptr;
+    };
+
+    template <typename PassDataType>
+    static const void* getPassDataTypeID()
+    {
+        static const char typeID = 0;
+        return &typeID;
+    }
+
+    static void checkKeyCollision(const BlackBoardKey& lhs, const BlackBoardKey& rhs)
+    {
+#if defined(VOXFLOW_DEBUG)
+        VOX_ASSERT(lhs.getName() == rhs.getName(), "Blackboard keys({}, {}) have the same hash({})", lhs.getName(), rhs.getName(), lhs.getHash());
+#else
+        (void)lhs;
+        (void)rhs;
+#endif
+    }
+
+    // Entries are stored in flat open addressing table whose capacity is power of two
+    [[nodiscard]] const Entry* findEntry(BlackBoardKey key) const
+    {
+        if (_entries.empty())
+        {
+            return nullptr;
+        }
+
+        const uint32_t mask = static_cast<uint32_t>(_entries.size()) - 1;
+        for (uint32_t index = key.getHash() & mask;; index = (index + 1) & mask)
+        {
+            const Entry& entry = _entries[index];
+            if (entry._type == EntryType::Empty)
+            {
+                return nullptr;
+            }
+
+            if ((entry._type != EntryType::Removed) && (entry._key.getHash() == key.getHash()))
+            {
+                checkKeyCollision(entry._key, key);
+                return &entry;
+            }
+        }
+    }
+
+    Entry& insertEntry(BlackBoardKey key)
+    {
+        if (Entry* entry = const_cast<Entry*>(findEntry(key)))
+        {
+            return *entry;
+        }
+
+        // Keep load factor including removed entries under 3/4, so that probing always meets empty entry
+        if ((_numEntries + _numRemovedEntries + 1) * 4 > static_cast<uint32_t>(_entries.size()) * 3)
+        {
+            rehash(std::max(static_cast<uint32_t>(_entries.size()) * 2, MIN_CAPACITY));
+        }
+
+        const uint32_t mask = static_cast<uint32_t>(_entries.size()) - 1;
+        uint32_t index = key.getHash() & mask;
+        while ((_entries[index]._type != EntryType::Empty) && (_entries[index]._type != EntryType::Removed))
+        {
+            index = (index + 1) & mask;
+        }
+
+        if (_entries[index]._type == EntryType::Removed)
+        {
+            --_numRemovedEntries;
+        }
+        ++_numEntries;
+
+        Entry& entry = _entries[index];
+        entry = Entry();
+        entry._key = key;
+        return entry;
+    }
+
+    void rehash(const uint32_t capacity)
+    {
+        std::vector<Entry> oldEntries(capacity);
+        oldEntries.swap(_entries);
+        _numEntries = 0;
+        _numRemovedEntries = 0;
+
+        for (const Entry& oldEntry : oldEntries)
+        {
+            if ((oldEntry._type != EntryType::Empty) && (oldEntry._type != EntryType::Removed))
+            {
+                insertEntry(oldEntry._key) = oldEntry;
+            }
+        }
+    }
+
+    static constexpr uint32_t MIN_CAPACITY = 16;
+
+    std::vector<Entry> _entries;
+    uint32_t _numEntries = 0;
+    uint32_t _numRemovedEntries = 0;
 };
 }  // namespace RenderGraph
 
 }  // namespace VoxFlow
 
-#endif
\ No newline at end of file
+#endif
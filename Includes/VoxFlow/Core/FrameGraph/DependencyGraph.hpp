@@ -3,9 +3,11 @@
 #ifndef VOXEL_FLOW_DEPENDENCY_GRAPH_HPP
 #define VOXEL_FLOW_DEPENDENCY_GRAPH_HPP
 
+#include <VoxFlow/Core/Utils/MemoryAllocator.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <atomic>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace VoxFlow
@@ -20,6 +22,9 @@ class DependencyGraph : private NonCopyable
         friend class DependencyGraph;
 
      public:
+        /**
+         * @param ownerGraph graph which node is registered to. nullptr to defer registration until adoptNode is called
+         */
         explicit Node(DependencyGraph* ownerGraph);
 
         virtual ~Node()
@@ -92,6 +97,7 @@ class DependencyGraph : private NonCopyable
 
     using NodeContainer = std::vector<Node*>;
     using EdgeContainer = std::vector<Edge*>;
+    using EdgeSpan = std::span<Edge* const>;
 
  public:
     DependencyGraph();
@@ -106,20 +112,51 @@ class DependencyGraph : private NonCopyable
         {
             _nodes = std::move(rhs._nodes);
             _edges = std::move(rhs._edges);
+            _adjacentEdges = std::move(rhs._adjacentEdges);
             _nextNodeID.store(rhs._nextNodeID.load());
+            _arenaAllocator = rhs._arenaAllocator;
         }
         return *this;
     }
 
  public:
     NodeID getNextNodeID();
+
+    /**
+     * @param arenaAllocator arena where linked edges are constructed. Edges are destructed when the arena is reset
+     */
+    inline void setArenaAllocator(ArenaAllocator* arenaAllocator)
+    {
+        _arenaAllocator = arenaAllocator;
+    }
+
+    [[nodiscard]] inline ArenaAllocator* getArenaAllocator() const
+    {
+        return _arenaAllocator;
+    }
     Node* getNode(NodeID id)
     {
         return _nodes[id];
     }
 
-    EdgeContainer getIncomingEdges(NodeID id);
-    EdgeContainer getOutgoingEdges(NodeID id);
+    inline uint32_t getNumNodes() const
+    {
+        return static_cast<uint32_t>(_nodes.size());
+    }
+
+    /**
+     * @param id node id to query
+     * @return non-owning view of edges linked into given node. It is invalidated
+     * when new edge is linked to the same node.
+     */
+    EdgeSpan getIncomingEdges(NodeID id) const;
+
+    /**
+     * @param id node id to query
+     * @return non-owning view of edges linked out of given node. It is
+     * invalidated when new edge is linked from the same node.
+     */
+    EdgeSpan getOutgoingEdges(NodeID id) const;
 
     template <typename ResourceEdgeType, typename... Args, std::enable_if_t<std::is_base_of_v<Edge, ResourceEdgeType>, bool> = true>
     DependencyGraph::Edge* link(NodeID fromID, NodeID toID, Args... args)
@@ -127,14 +164,26 @@ class DependencyGraph : private NonCopyable
         Node* fromNode = getNode(fromID);
         Node* toNode = getNode(toID);
 
-        Edge* edge = new ResourceEdgeType(this, fromNode, toNode, args...);
+        Edge* edge = _arenaAllocator->construct<ResourceEdgeType>(this, fromNode, toNode, args...);
         _edges.push_back(edge);
+        _adjacentEdges[fromID]._outgoingEdges.push_back(edge);
+        _adjacentEdges[toID]._incomingEdges.push_back(edge);
 
         return edge;
     }
 
     void registerNode(Node* node, NodeID id);
+
+    /**
+     * Register node constructed without owner graph, such as pass declared on the other thread.
+     * Node ID is given in order of adoption.
+     */
+    void adoptNode(Node* node);
+
     void cullUnreferencedNodes();
+
+    // Forget all registered nodes and edges. They are owned by the caller and the arena allocator.
+    void clear();
     void insertNode(Node* node, NodeID id);
     bool isEdgeValid(const Edge* edge) const;
 
@@ -144,9 +193,24 @@ class DependencyGraph : private NonCopyable
     }
 
  private:
+    /**
+     * Prepare adjacent edges of given node, reusing the ones kept from the previous frame if exist
+     */
+    void addAdjacentEdges(NodeID id);
+
+ private:
+    struct AdjacentEdges
+    {
+        EdgeContainer _incomingEdges;
+        EdgeContainer _outgoingEdges;
+    };
+
     NodeContainer _nodes;
     EdgeContainer _edges;
+    std::vector<AdjacentEdges> _adjacentEdges;
+    NodeContainer _unreferencedNodes;
     std::atomic<NodeID> _nextNodeID;
+    ArenaAllocator* _arenaAllocator = nullptr;
 };
 
 }  // namespace VoxFlow
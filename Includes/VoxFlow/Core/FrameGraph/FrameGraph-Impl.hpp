@@ -15,41 +15,85 @@ namespace RenderGraph
 {
 constexpr uint32_t EXECUTION_LAMBDA_SIZE_LIMIT = 1024U;
 
+template <typename Type>
+inline void FrameGraphBuilder::combineStructureHash(const Type& value)
+{
+    if (_declarationScope != nullptr)
+    {
+        _declarationScope->combineStructureHash(value);
+    }
+    else
+    {
+        _frameGraph->combineStructureHash(value);
+    }
+}
+
 template <ResourceConcept ResourceDataType>
-ResourceHandle FrameGraphBuilder::allocate(std::string&& resourceName, typename ResourceDataType::Descriptor&& initArgs)
+ResourceHandle FrameGraphBuilder::allocate(std::string_view resourceName, typename ResourceDataType::Descriptor&& initArgs)
 {
-    return _frameGraph->create<ResourceDataType>(std::move(resourceName), std::move(initArgs));
+    if (_declarationScope != nullptr)
+    {
+        return _declarationScope->create<ResourceDataType>(resourceName, std::move(initArgs));
+    }
+    return _frameGraph->create<ResourceDataType>(resourceName, std::move(initArgs));
 }
 
 template <ResourceConcept ResourceDataType>
 ResourceHandle FrameGraphBuilder::read(ResourceHandle id, typename ResourceDataType::Usage usage)
 {
-    return _frameGraph->readInternal(id, _currentPassNode, [this, usage](ResourceNode* node, VirtualResource* vResource) {
-        Resource<ResourceDataType>* resource = static_cast<Resource<ResourceDataType>*>(vResource);
-        return resource->connect(_frameGraph->getDependencyGraph(), node, _currentPassNode, usage);
-    });
+    combineStructureHash(id);
+    combineStructureHash(usage);
+    combineStructureHash(false);
+
+    // Connection may be deferred until merge of declaration scope, so only the plain record of it is kept
+    if (_declarationScope != nullptr)
+    {
+        _declarationScope->_connections.push_back(
+            { ._passNode = _currentPassNode, ._resourceHandle = id, ._usage = static_cast<uint32_t>(usage), ._isWrite = false });
+        return id;
+    }
+    return _frameGraph->readInternal(id, _currentPassNode, static_cast<uint32_t>(usage));
 }
 
 template <ResourceConcept ResourceDataType>
 ResourceHandle FrameGraphBuilder::write(ResourceHandle id, typename ResourceDataType::Usage usage)
 {
-    return _frameGraph->writeInternal(id, _currentPassNode, [this, usage](ResourceNode* node, VirtualResource* vResource) {
-        Resource<ResourceDataType>* resource = static_cast<Resource<ResourceDataType>*>(vResource);
-        return resource->connect(_frameGraph->getDependencyGraph(), _currentPassNode, node, usage);
-    });
+    combineStructureHash(id);
+    combineStructureHash(usage);
+    combineStructureHash(true);
+
+    if (_declarationScope != nullptr)
+    {
+        _declarationScope->_connections.push_back(
+            { ._passNode = _currentPassNode, ._resourceHandle = id, ._usage = static_cast<uint32_t>(usage), ._isWrite = true });
+        return id;
+    }
+    return _frameGraph->writeInternal(id, _currentPassNode, static_cast<uint32_t>(usage));
+}
+
+template <ResourceConcept ResourceDataType>
+ResourceHandle FrameGraphBuilder::readHistory(ResourceHandle id, typename ResourceDataType::Usage usage)
+{
+    // History is declared before concurrent declaration, so its resource is already visible from the scopes
+    VOX_ASSERT(_frameGraph->getVirtualResource(id)->isReadOnly(), "ResourceHandle({}) is not history of the previous frame", id.get());
+
+    return read<ResourceDataType>(id, usage);
 }
 
 template <typename PassDataType, typename SetupPhase, typename ExecutePhase>
 const PassDataType& FrameGraph::addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute)
 {
     static_assert(sizeof(ExecutePhase) < EXECUTION_LAMBDA_SIZE_LIMIT, "ExecutePhase() lambda captures too much data");
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "Pass({}) must be declared into declaration scope until the scopes are merged", passName);
 
-    std::unique_ptr<FrameGraphPass<PassDataType, ExecutePhase>> pass =
-        std::make_unique<FrameGraphPass<PassDataType, ExecutePhase>>(std::forward<ExecutePhase>(execute));
+    FrameGraphPass<PassDataType, ExecutePhase>* pass =
+        _frameArena.construct<FrameGraphPass<PassDataType, ExecutePhase>>(std::forward<ExecutePhase>(execute));
 
     PassDataType& passData = pass->getPassData();
 
-    _passNodes.emplace_back(new RenderPassNode(this, std::move(passName), std::move(pass)));
+    combineStructureHash(passName);
+
+    _passNodes.emplace_back(_frameArena.construct<RenderPassNode>(this, &_frameArena, std::move(passName), pass));
 
     FrameGraphBuilder builder(this, _passNodes.back());
     std::invoke(setup, builder, passData);
@@ -64,13 +108,25 @@ void FrameGraph::addCallbackPass(std::string_view&& passName, SetupPhase&& setup
     {
     };
 
-    [[maybe_unused]] auto _ = addCallbackPass<EmptyPassData, SetupPhase, ExecutePhase>(std::move(passName), std::move(setup), std::move(execute));
+    // Adapt phase lambdas which do not take pass data to the typed pass interface
+    auto setupWithoutData = [&setup](FrameGraphBuilder& builder, EmptyPassData&) { std::invoke(setup, builder); };
+    auto executeWithoutData = [execute = std::forward<ExecutePhase>(execute)](const FrameGraphResources* resources, EmptyPassData&,
+                                                                             CommandStream* cmdStream) mutable { std::invoke(execute, resources, cmdStream); };
+
+    [[maybe_unused]] auto _ = addCallbackPass<EmptyPassData>(std::move(passName), std::move(setupWithoutData), std::move(executeWithoutData));
 }
 
 template <typename SetupPhase>
 void FrameGraph::addPresentPass(std::string_view&& passName, SetupPhase&& setup, SwapChain* swapChain, const FrameContext& frameContext)
 {
-    _passNodes.emplace_back(new PresentPassNode(this, std::move(passName), swapChain, frameContext));
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "Pass({}) must be declared into declaration scope until the scopes are merged", passName);
+
+    combineStructureHash(passName);
+
+    _swapChainToPresent = swapChain;
+    _frameContextToPresent = frameContext;
+
+    _passNodes.emplace_back(_frameArena.construct<PresentPassNode>(this, &_frameArena, std::move(passName), swapChain, frameContext));
 
     FrameGraphBuilder builder(this, _passNodes.back());
     std::invoke(setup, builder);
@@ -78,23 +134,89 @@ void FrameGraph::addPresentPass(std::string_view&& passName, SetupPhase&& setup,
 }
 
 template <ResourceConcept ResourceDataType>
-ResourceHandle FrameGraph::create(std::string&& resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs)
+ResourceHandle FrameGraph::create(std::string_view resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs)
 {
-    VirtualResource* virtualResource = new Resource<ResourceDataType>(std::move(resourceName), std::move(resourceDescArgs));
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "Resource({}) must be created in declaration scope until the scopes are merged", resourceName);
+
+    combineStructureHash(resourceName);
+    combineStructureHash(resourceDescArgs);
+
+    // Name given by caller may be temporary, so it is kept in the arena until the frame ends
+    VirtualResource* virtualResource = _frameArena.construct<Resource<ResourceDataType>>(_frameArena.copyString(resourceName), std::move(resourceDescArgs));
 
-    ResourceHandle resourceHandle(_resources.size());
+    ResourceHandle resourceHandle(_resourceSlots.size());
 
-    _resourceSlots.push_back({ ._resourceIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size()),
-                               ._nodeIndex = static_cast<ResourceSlot::IndexType>(_resources.size()),
+    _resourceSlots.push_back({ ._resourceIndex = static_cast<ResourceSlot::IndexType>(_resources.size()),
+                               ._nodeIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size()),
                                ._version = static_cast<ResourceSlot::VersionType>(0) });
     _resources.push_back(virtualResource);
 
-    ResourceNode* resourceNode = new ResourceNode(&_dependencyGraph, resourceHandle);
+    ResourceNode* resourceNode = _frameArena.construct<ResourceNode>(&_dependencyGraph, resourceHandle);
     _resourceNodes.push_back(resourceNode);
 
     return resourceHandle;
 }
 
+template <typename PassDataType, typename SetupPhase, typename ExecutePhase>
+const PassDataType& FrameGraphDeclarationScope::addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute)
+{
+    static_assert(sizeof(ExecutePhase) < EXECUTION_LAMBDA_SIZE_LIMIT, "ExecutePhase() lambda captures too much data");
+
+    FrameGraphPass<PassDataType, ExecutePhase>* pass = _arena.construct<FrameGraphPass<PassDataType, ExecutePhase>>(std::forward<ExecutePhase>(execute));
+
+    PassDataType& passData = pass->getPassData();
+
+    combineStructureHash(passName);
+
+    // Pass node is registered to the dependency graph when the scope is merged
+    _passNodes.emplace_back(_arena.construct<RenderPassNode>(nullptr, &_arena, std::move(passName), pass));
+
+    FrameGraphBuilder builder(_frameGraph, _passNodes.back(), this);
+    std::invoke(setup, builder, passData);
+
+    return passData;
+}
+
+template <typename SetupPhase, typename ExecutePhase>
+void FrameGraphDeclarationScope::addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute)
+{
+    struct EmptyPassData
+    {
+    };
+
+    // Adapt phase lambdas which do not take pass data to the typed pass interface
+    auto setupWithoutData = [&setup](FrameGraphBuilder& builder, EmptyPassData&) { std::invoke(setup, builder); };
+    auto executeWithoutData = [execute = std::forward<ExecutePhase>(execute)](const FrameGraphResources* resources, EmptyPassData&,
+                                                                             CommandStream* cmdStream) mutable { std::invoke(execute, resources, cmdStream); };
+
+    [[maybe_unused]] auto _ = addCallbackPass<EmptyPassData>(std::move(passName), std::move(setupWithoutData), std::move(executeWithoutData));
+}
+
+template <ResourceConcept ResourceDataType>
+ResourceHandle FrameGraphDeclarationScope::create(std::string_view resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs)
+{
+    VOX_ASSERT(_numResources < MAX_DECLARATION_SCOPE_RESOURCES, "Declaration scope can not create more than {} resources",
+               MAX_DECLARATION_SCOPE_RESOURCES);
+
+    combineStructureHash(resourceName);
+    combineStructureHash(resourceDescArgs);
+
+    VirtualResource* virtualResource = _arena.construct<Resource<ResourceDataType>>(_arena.copyString(resourceName), std::move(resourceDescArgs));
+
+    // Slot and resource index reserved for this scope are written only by the owner thread, so that resources
+    // declared by this scope are addressable from the following scopes before merge. Resource node is created at merge.
+    const ResourceHandle resourceHandle(_resourceHandleBase + _numResources);
+    const uint32_t resourceIndex = _resourceIndexBase + _numResources;
+
+    _frameGraph->_resources[resourceIndex] = virtualResource;
+    _frameGraph->_resourceSlots[resourceHandle.get()] = { ._resourceIndex = static_cast<FrameGraph::ResourceSlot::IndexType>(resourceIndex),
+                                                          ._nodeIndex = UINT32_MAX,
+                                                          ._version = static_cast<FrameGraph::ResourceSlot::VersionType>(0) };
+    ++_numResources;
+
+    return resourceHandle;
+}
+
 template <ResourceConcept ResourceDataType>
 const typename ResourceDataType::Descriptor FrameGraph::getResourceDescriptor(ResourceHandle id) const
 {
@@ -111,12 +233,12 @@ bool Resource<ResourceDataType>::connect(DependencyGraph* dependencyGraph, Resou
     if (edge == nullptr)
     {
         edge = static_cast<ResourceEdge*>(dependencyGraph->link<ResourceEdge>(node->getNodeID(), passNode->getNodeID(), usage));
+        node->addOutgoingEdge(edge);
     }
     else
     {
         *edge |= usage;
     }
-    node->addOutgoingEdge(edge);
 
     return true;
 }
@@ -129,18 +251,18 @@ bool Resource<ResourceDataType>::connect(DependencyGraph* dependencyGraph, PassN
     if (edge == nullptr)
     {
         edge = static_cast<ResourceEdge*>(dependencyGraph->link<ResourceEdge>(passNode->getNodeID(), node->getNodeID(), usage));
+        node->setIncomingEdge(edge);
     }
     else
     {
         *edge |= usage;
     }
-    node->setIncomingEdge(edge);
 
     return true;
 }
 
 template <ResourceConcept ResourceDataType>
-void Resource<ResourceDataType>::resolveUsage(DependencyGraph* dependencyGraph, const DependencyGraph::EdgeContainer& edges, DependencyGraph::Edge* writerEdge)
+void Resource<ResourceDataType>::resolveUsage(DependencyGraph* dependencyGraph, DependencyGraph::EdgeSpan edges, DependencyGraph::Edge* writerEdge)
 {
     for (DependencyGraph::Edge* edge : edges)
     {
@@ -161,8 +283,7 @@ template <ResourceConcept ResourceDataType>
 [[nodiscard]] inline const Resource<ResourceDataType>& FrameGraphResources::getResource(ResourceHandle handle) const
 {
 #if defined(VOXFLOW_DEBUG)
-    auto declaredHandles = _passNode->getDeclaredHandles();
-    VOX_ASSERT(declaredHandles.find(handle) != declaredHandles.end(), "Should not try to get resource that is not declared in this pass");
+    VOX_ASSERT(_passNode->isDeclaredHandle(handle), "Should not try to get resource that is not declared in this pass");
 #endif
 
     VirtualResource* vresource = _frameGraph->getVirtualResource(handle);
@@ -173,8 +294,7 @@ template <ResourceConcept ResourceDataType>
 [[nodiscard]] inline const typename ResourceDataType::Descriptor FrameGraphResources::getResourceDescriptor(ResourceHandle handle) const
 {
 #if defined(VOXFLOW_DEBUG)
-    auto declaredHandles = _passNode->getDeclaredHandles();
-    VOX_ASSERT(declaredHandles.find(handle) != declaredHandles.end(), "Should not try to get resource that is not declared in this pass");
+    VOX_ASSERT(_passNode->isDeclaredHandle(handle), "Should not try to get resource that is not declared in this pass");
 #endif
 
     return _frameGraph->getResourceDescriptor<ResourceDataType>(handle);
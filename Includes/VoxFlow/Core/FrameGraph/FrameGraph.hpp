@@ -10,14 +10,24 @@
 #include <VoxFlow/Core/FrameGraph/Resource.hpp>
 #include <VoxFlow/Core/FrameGraph/ResourceHandle.hpp>
 #include <VoxFlow/Core/FrameGraph/TypeTraits.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
 #include <VoxFlow/Core/Utils/FenceObject.hpp>
+#include <VoxFlow/Core/Utils/HashUtil.hpp>
+#include <array>
 #include <functional>
 #include <istream>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace tf
+{
+class Executor;
+}
+
 namespace VoxFlow
 {
 class LogicalDevice;
@@ -30,10 +40,21 @@ namespace RenderGraph
 {
 
 class FrameGraph;
+class FrameGraphDeclarationScope;
+
+// Graphics, compute and transfer queues which pass can declare affinity to
+constexpr uint32_t NUM_COMMAND_QUEUE_TYPES = static_cast<uint32_t>(CommandStreamUsage::Transfer) + 1;
+
+// Size of memory block where per-frame nodes, edges and passes are allocated from
+constexpr uint64_t FRAME_ARENA_BLOCK_SIZE = 64U * 1024U;
+
+// Number of resource handles reserved for each declaration scope
+constexpr uint32_t MAX_DECLARATION_SCOPE_RESOURCES = 256U;
 
 class FrameGraphBuilder
 {
     friend class FrameGraph;
+    friend class FrameGraphDeclarationScope;
 
  public:
     FrameGraphBuilder() = delete;
@@ -44,13 +65,17 @@ class FrameGraphBuilder
     FrameGraphBuilder& operator=(FrameGraphBuilder&&) = delete;
 
  private:
-    FrameGraphBuilder(FrameGraph* frameGraph, PassNode* passNode) : _frameGraph(frameGraph), _currentPassNode(passNode)
+    FrameGraphBuilder(FrameGraph* frameGraph, PassNode* passNode, FrameGraphDeclarationScope* declarationScope = nullptr)
+        : _frameGraph(frameGraph), _currentPassNode(passNode), _declarationScope(declarationScope)
     {
     }
 
+    template <typename Type>
+    inline void combineStructureHash(const Type& value);
+
  public:
     template <ResourceConcept ResourceDataType>
-    [[nodiscard]] ResourceHandle allocate(std::string&& resourceName, typename ResourceDataType::Descriptor&& initArgs);
+    [[nodiscard]] ResourceHandle allocate(std::string_view resourceName, typename ResourceDataType::Descriptor&& initArgs);
 
     template <ResourceConcept ResourceDataType>
     ResourceHandle read(ResourceHandle id, typename ResourceDataType::Usage usage);
@@ -58,17 +83,120 @@ class FrameGraphBuilder
     template <ResourceConcept ResourceDataType>
     ResourceHandle write(ResourceHandle id, typename ResourceDataType::Usage usage);
 
+    /**
+     * Read content of history resource written in the previous frame
+     * @param id history handle returned by FrameGraph::createHistory
+     */
+    template <ResourceConcept ResourceDataType>
+    ResourceHandle readHistory(ResourceHandle id, typename ResourceDataType::Usage usage);
+
     [[nodiscard]] uint32_t declareRenderPass(std::string_view&& passName, typename FrameGraphRenderPass::Descriptor&& initArgs);
 
-    inline void setSideEffectPass()
-    {
-        _currentPassNode->setSideEffectPass();
-    }
+    void setSideEffectPass();
+
+    /**
+     * Declare the queue which the current pass prefers to be executed on. Falls back to
+     * graphics queue if frame graph has no command stream for the given queue.
+     * @param queueAffinity one of graphics, compute and transfer
+     */
+    void setQueueAffinity(CommandStreamUsage queueAffinity);
+
+    /**
+     * Set predicate which is evaluated at every execute. Disabled pass is skipped and resources referenced only by
+     * disabled passes are not devirtualized, without recompiling the frame graph when the predicate is toggled.
+     * Passes reading resources written by disabled pass see undefined content.
+     * @param enablePredicate returns whether the current pass is executed in this frame
+     */
+    void setEnablePredicate(std::function<bool()>&& enablePredicate);
 
  protected:
  private:
     FrameGraph* _frameGraph = nullptr;
     PassNode* _currentPassNode = nullptr;
+    FrameGraphDeclarationScope* _declarationScope = nullptr;
+};
+
+/**
+ * Passes and resources declared by a single thread while concurrent declaration is open. Each scope is only
+ * touched by its owner thread and merged into the frame graph in order of scope index, so passes can be
+ * declared on different threads without lock and the merged graph does not depend on thread scheduling.
+ */
+class FrameGraphDeclarationScope : private NonCopyable
+{
+    friend class FrameGraph;
+    friend class FrameGraphBuilder;
+
+ public:
+    explicit FrameGraphDeclarationScope(FrameGraph* frameGraph);
+    ~FrameGraphDeclarationScope() = default;
+
+ public:
+    template <typename PassDataType, typename SetupPhase, typename ExecutePhase>
+    const PassDataType& addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute);
+
+    template <typename SetupPhase, typename ExecutePhase>
+    void addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute);
+
+    template <ResourceConcept ResourceDataType>
+    [[nodiscard]] ResourceHandle create(std::string_view resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs);
+
+    /**
+     * Declare that the given scope is completely declared before this scope starts, so that
+     * handles published by the scope are visible from this scope.
+     * @param scope preceding scope which must have smaller scope index
+     */
+    void addPrecedingScope(const FrameGraphDeclarationScope* scope);
+
+    /**
+     * @return handle published by this scope, the preceding scopes or frame graph before concurrent declaration in order
+     */
+    [[nodiscard]] ResourceHandle getHandle(BlackBoardKey key) const;
+
+    // Handles published in this blackboard are merged into blackboard of frame graph
+    inline BlackBoard& getBlackBoard()
+    {
+        return _blackBoard;
+    }
+
+    inline FrameGraph* getFrameGraph() const
+    {
+        return _frameGraph;
+    }
+
+    inline uint32_t getScopeIndex() const
+    {
+        return _scopeIndex;
+    }
+
+ private:
+    template <typename Type>
+    inline void combineStructureHash(const Type& value)
+    {
+        hash_combine(_structureHash, value);
+    }
+
+    void begin(const uint32_t scopeIndex, const uint32_t resourceHandleBase, const uint32_t resourceIndexBase);
+
+    // Read or write of resource which is connected to the pass when the scope is merged
+    struct DeferredConnection
+    {
+        PassNode* _passNode = nullptr;
+        ResourceHandle _resourceHandle;
+        uint32_t _usage = 0;
+        bool _isWrite = false;
+    };
+
+    FrameGraph* _frameGraph = nullptr;
+    ArenaAllocator _arena;
+    BlackBoard _blackBoard;
+    std::vector<const FrameGraphDeclarationScope*> _precedingScopes;
+    std::vector<PassNode*> _passNodes;
+    std::vector<DeferredConnection> _connections;
+    uint32_t _scopeIndex = 0;
+    uint32_t _resourceHandleBase = 0;
+    uint32_t _resourceIndexBase = 0;
+    uint32_t _numResources = 0;
+    uint64_t _structureHash = 0;
 };
 
 class FrameGraph : private NonCopyable
@@ -80,14 +208,38 @@ class FrameGraph : private NonCopyable
  public:
     struct ResourceSlot
     {
-        using IndexType = uint16_t;
+        using IndexType = uint32_t;
         using VersionType = uint8_t;
 
-        IndexType _resourceIndex = UINT16_MAX;
-        IndexType _nodeIndex = UINT16_MAX;
+        IndexType _resourceIndex = UINT32_MAX;
+        IndexType _nodeIndex = UINT32_MAX;
         VersionType _version = UINT8_MAX;
     };
 
+    struct TransientMemoryStats
+    {
+        uint32_t _numTransientResources = 0;
+        uint32_t _numMemorySlots = 0;
+        uint64_t _peakBytesWithoutAliasing = 0;
+        uint64_t _peakBytesWithAliasing = 0;
+    };
+
+    struct CompileCacheStats
+    {
+        uint32_t _numHits = 0;
+        uint32_t _numMisses = 0;
+    };
+
+    struct HistoryHandles
+    {
+        // Texture written in the current frame which becomes history of the next frame
+        ResourceHandle _current;
+        // Texture written in the previous frame. Only readable with FrameGraphBuilder::readHistory
+        ResourceHandle _history;
+        // Whether the history is written in the previous frame with the same descriptor and usage
+        bool _isHistoryValid = false;
+    };
+
  public:
     template <typename PassDataType, typename SetupPhase, typename ExecutePhase>
     const PassDataType& addCallbackPass(std::string_view&& passName, SetupPhase&& setup, ExecutePhase&& execute);
@@ -99,11 +251,20 @@ class FrameGraph : private NonCopyable
     void addPresentPass(std::string_view&& passName, SetupPhase&& setup, SwapChain* swapChain, const FrameContext& frameContext);
 
     template <ResourceConcept ResourceDataType>
-    [[nodiscard]] ResourceHandle create(std::string&& resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs);
+    [[nodiscard]] ResourceHandle create(std::string_view resourceName, typename ResourceDataType::Descriptor&& resourceDescArgs);
 
-    [[nodiscard]] ResourceHandle importRenderTarget(std::string&& resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs,
+    [[nodiscard]] ResourceHandle importRenderTarget(std::string_view resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs,
                                                     typename FrameGraphRenderPass::ImportedDescriptor&& importedDesc, TextureView* textureView);
 
+    /**
+     * Declare texture which persists across frames for temporal techniques. Backing textures are ping-ponged
+     * every frame and allocated only once unless the descriptor or usage is changed. Must be declared at most once per frame.
+     * @param resourceName name which identifies the history across frames
+     * @param usage every usage of the texture, both written in a frame and read as history in the next frame
+     * @return handles of the texture written in this frame and the one written in the previous frame
+     */
+    [[nodiscard]] HistoryHandles createHistory(std::string_view resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs, const TextureUsage usage);
+
     // Compile given frame graph
     bool compile();
 
@@ -113,22 +274,134 @@ class FrameGraph : private NonCopyable
     // Clear per-frame frame graph metadata
     void clear();
 
+    /**
+     * Open declaration scopes which passes and resources can be declared into from different threads at the same time.
+     * Frame graph itself must not be declared into until the scopes are merged.
+     * @param numScopes number of scopes. Usually one per declaring task
+     */
+    void beginConcurrentDeclaration(const uint32_t numScopes);
+
+    /**
+     * @return declaration scope of the given index opened by beginConcurrentDeclaration
+     */
+    [[nodiscard]] FrameGraphDeclarationScope* getDeclarationScope(const uint32_t scopeIndex);
+
+    /**
+     * Merge passes, resources and blackboards of the declaration scopes in order of scope index.
+     * Must be called after all declaring threads are finished.
+     */
+    void endConcurrentDeclaration();
+
     //
     void reset(CommandStream* cmdStream, RenderResourceAllocator* renderResourceAllocator);
 
+    /**
+     * Set command stream of the asynchronous queue which passes with the corresponding affinity are recorded into.
+     * Unlike the graphics command stream, it is kept across reset.
+     * @param queueAffinity compute or transfer
+     * @param cmdStream command stream of the queue. nullptr to execute such passes on graphics queue
+     */
+    void setAsyncCommandStream(CommandStreamUsage queueAffinity, CommandStream* cmdStream);
+
     /**
      * Dump compiled graph as graphviz text into given string stream
      * @param isstr output string stream where compiled graph dumped at
      */
     void dumpGraphViz(std::ostringstream& osstr);
 
-    inline void setLastSubmitFence(const FenceObject& fenceObject)
+    /**
+     * Run the given task for each index on the recording workers and return once every task completes.
+     * Tasks run in order on the calling thread when it is one of the recording workers already.
+     * @param numTasks number of tasks
+     * @param task callable of (uint32_t taskIndex)
+     */
+    void runRecordingTasks(const uint32_t numTasks, const std::function<void(uint32_t)>& task);
+
+    /**
+     * Record the fence of a submission made on the given queue in the current frame.
+     * Later submission on the same queue supersedes the earlier one as it completes after.
+     * @param queueAffinity queue which the submission is made on
+     * @param fenceObject fence signaled when the submission is completed
+     */
+    inline void setFrameSubmitFence(const CommandStreamUsage queueAffinity, const FenceObject& fenceObject)
+    {
+        if (fenceObject.isValid())
+        {
+            _frameSubmitFences[static_cast<uint32_t>(queueAffinity)] = fenceObject;
+        }
+    }
+
+    /**
+     * @return fences of the last submissions on each queue in the current frame. Invalid for queues not submitted.
+     */
+    [[nodiscard]] inline const std::array<FenceObject, NUM_COMMAND_QUEUE_TYPES>& getFrameSubmitFences() const
+    {
+        return _frameSubmitFences;
+    }
+
+    /**
+     * @return statistics of transient memory aliasing planned at the last compile
+     */
+    [[nodiscard]] inline const TransientMemoryStats& getTransientMemoryStats() const
+    {
+        return _transientMemoryStats;
+    }
+
+    /**
+     * @return number of compiles which reused the result of the previous frame with identical structure
+     */
+    [[nodiscard]] inline const CompileCacheStats& getCompileCacheStats() const
+    {
+        return _compileCacheStats;
+    }
+
+    /**
+     * @return number of batches of passes recorded in parallel at the last compile.
+     * Passes in the same batch share dependency level and never touch same resource.
+     */
+    [[nodiscard]] inline uint32_t getNumExecutionBatches() const
+    {
+        return _executionBatchOffsets.empty() ? 0 : static_cast<uint32_t>(_executionBatchOffsets.size() - 1);
+    }
+
+    /**
+     * @return number of queue family ownership transfers planned at the last compile
+     */
+    [[nodiscard]] inline uint32_t getNumQueueOwnershipTransfers() const
+    {
+        return static_cast<uint32_t>(_queueOwnershipTransfers.size());
+    }
+
+    /**
+     * @return number of resource barriers planned at the last compile including split ones
+     */
+    [[nodiscard]] inline uint32_t getNumPlannedBarriers() const
+    {
+        return static_cast<uint32_t>(_passBarriers.size());
+    }
+
+    /**
+     * @return number of barriers split into signal after producer and wait before consumer
+     */
+    [[nodiscard]] inline uint32_t getNumSplitBarriers() const
+    {
+        return _numSplitBarriers;
+    }
+
+    /**
+     * @return number of passes merged into the render pass of the previous pass as its subpass
+     */
+    [[nodiscard]] inline uint32_t getNumMergedSubpasses() const
     {
-        _lastSubmitFence = fenceObject;
+        return _numMergedSubpasses;
     }
-    inline FenceObject getLastSubmitFence() const
+
+    /**
+     * @return structural hash of passes, resource descriptors and their usages declared so far
+     */
+    [[nodiscard]] inline uint64_t getStructureHash() const
     {
-        return _lastSubmitFence;
+        return _structureHash;
     }
 
  public:
@@ -137,6 +410,14 @@ class FrameGraph : private NonCopyable
         return &_dependencyGraph;
     }
 
+    /**
+     * @return arena allocator where per-frame nodes, edges and passes are allocated from
+     */
+    [[nodiscard]] inline const ArenaAllocator& getFrameArena() const
+    {
+        return _frameArena;
+    }
+
     inline const BlackBoard& getBlackBoard() const
     {
         return _blackBoard;
@@ -175,15 +456,64 @@ class FrameGraph : private NonCopyable
     void buildAdjacencyLists(const uint32_t numPassNodes);
     bool topologicalSortPassNodes(const uint32_t numPassNodes);
     void calcDependencyLevels(const uint32_t numPassNodes);
+    void buildExecutionBatches(const uint32_t numPassNodes);
+    // Move culled pass nodes behind the live ones keeping their declaration order
+    void partitionLivePassNodes();
+    void applyExecutionOrder();
     void allotCommandQueueIndices(const uint32_t numPassNodes);
+    void mergeSubpasses(const uint32_t numPassNodes);
+    void applySubpassMerges();
+    void inferAttachmentOperations(const uint32_t numPassNodes);
+    void markTransientAttachments(const uint32_t numPassNodes);
     void buildSSIS(const uint32_t numPassNodes);
+    void buildQueueOwnershipTransfers(const uint32_t numPassNodes);
+    void evaluateEnablePredicates(const uint32_t numPassNodes);
+    void submitQueueOwnershipTransfers(const uint32_t passBegin, const uint32_t passEnd);
+    // Submit commands recorded so far on the given queue in the middle of the frame
+    FenceObject flushCommandStreamBeforePresent(const uint32_t queueIndex);
+    void sealCommandStreams();
+    // Recording workers are also used for translation of secondary command buffers in command streams
+    tf::Executor* getOrCreateRecordingExecutor();
+    void setTranslationExecutor(tf::Executor* translationExecutor);
+    void submitPassBarriers(const uint32_t passBegin, const uint32_t passEnd);
+    void signalSplitBarriers(const uint32_t passBegin, const uint32_t passEnd);
     void calcResourceLifetimes(const uint32_t numPassNodes);
+    void allotTransientMemorySlots();
+
+    // Restore compile result of the previous frame if declared structure is identical
+    bool replayCompileCache();
+    void recordCompileCache();
+
+    // Endpoints and usage of every linked edge, compared byte-wise on cache hit to reject hash collisions
+    struct EdgeFingerprint
+    {
+        DependencyGraph::NodeID _fromNodeID = UINT32_MAX;
+        DependencyGraph::NodeID _toNodeID = UINT32_MAX;
+        uint32_t _usage = 0;
+    };
+    void collectEdgeFingerprints(std::vector<EdgeFingerprint>& outFingerprints) const;
+
+    // Index of resource which given resource node refers to
+    uint32_t getResourceIndex(DependencyGraph::NodeID resourceNodeID);
+
+    // Queue index where the pass with given affinity actually runs on
+    inline uint32_t resolveCommandQueueIndex(const uint32_t queueIndex) const
+    {
+        return (_cmdStreams[queueIndex] != nullptr) ? queueIndex : static_cast<uint32_t>(CommandStreamUsage::Graphics);
+    }
+
+    template <typename Type>
+    inline void combineStructureHash(const Type& value)
+    {
+        hash_combine(_structureHash, value);
+    }
 
  private:
     friend class FrameGraphBuilder;
+    friend class FrameGraphDeclarationScope;
 
-    ResourceHandle readInternal(ResourceHandle id, [[maybe_unused]] PassNode* passNode, std::function<bool(ResourceNode*, VirtualResource*)>&& connect);
-    ResourceHandle writeInternal(ResourceHandle id, PassNode* passNode, std::function<bool(ResourceNode*, VirtualResource*)>&& connect);
+    ResourceHandle readInternal(ResourceHandle id, PassNode* passNode, const uint32_t usage);
+    ResourceHandle writeInternal(ResourceHandle id, PassNode* passNode, const uint32_t usage);
 
  private:
     std::vector<ResourceSlot> _resourceSlots;
@@ -196,13 +526,110 @@ class FrameGraph : private NonCopyable
     std::vector<std::vector<uint32_t>> _passNodeAdjacencyList;
     std::vector<uint32_t> _topologicalSortedPassNodes;
     std::vector<std::vector<uint32_t>> _dependencyLevels;
+    std::vector<uint32_t> _executionOrder;
+    std::vector<uint32_t> _executionBatchOffsets;
     std::vector<uint32_t> _commandQueueIndices;
 
+    // Whether each live pass is enabled at the current execute
+    std::vector<bool> _isPassEnabled;
+
+    // Scratch buffers kept across frames, so that compile of steady-state frame does not allocate
+    std::vector<PassNode*> _scratchPassNodes;
+    std::vector<uint32_t> _scratchRenderPassIndices;
+    std::vector<bool> _scratchAttachmentOnlyMarks;
+
+    // Index of subpass in the render pass merged with the previous passes. Zero if pass begins its own render pass.
+    std::vector<uint32_t> _subpassIndices;
+    uint32_t _numMergedSubpasses = 0;
+
+    // Ownership transfer of resource between queues right before pass which uses it on the other queue
+    struct QueueOwnershipTransfer
+    {
+        uint32_t _resourceIndex = 0;
+        uint32_t _srcQueueIndex = 0;
+        uint32_t _dstQueueIndex = 0;
+    };
+    std::vector<uint32_t> _queueOwnershipTransferOffsets;
+    std::vector<QueueOwnershipTransfer> _queueOwnershipTransfers;
+
+    // Barrier recorded right before pass which transits resource to the usage of the pass.
+    // Split barrier is signaled right after the previous pass accessing the resource instead.
+    struct PassBarrier
+    {
+        uint32_t _resourceIndex = 0;
+        uint32_t _usage = 0;
+        uint32_t _splitBarrierIndex = UINT32_MAX;
+    };
+    std::vector<uint32_t> _passBarrierOffsets;
+    std::vector<PassBarrier> _passBarriers;
+    std::vector<uint32_t> _splitBarrierSignalOffsets;
+    std::vector<uint32_t> _splitBarrierSignals;
+    uint32_t _numSplitBarriers = 0;
+
+    struct ResourceLifetime
+    {
+        VirtualResource* _resource = nullptr;
+        uint32_t _firstBatchIndex = 0;
+        uint32_t _lastBatchIndex = 0;
+        uint64_t _memorySize = 0;
+    };
+    std::vector<ResourceLifetime> _resourceLifetimes;
+    TransientMemoryStats _transientMemoryStats;
+
+    // Compile result stored by indices so that it can be applied to nodes re-declared in the next frame
+    struct CompileCache
+    {
+        uint64_t _structureHash = 0;
+        uint32_t _numNodes = 0;
+        uint32_t _numEdges = 0;
+        bool _isValid = false;
+        std::vector<EdgeFingerprint> _edgeFingerprints;
+        std::vector<uint32_t> _nodeRefCounts;
+        std::vector<uint32_t> _executionOrder;
+        std::vector<uint32_t> _executionBatchOffsets;
+        std::vector<uint32_t> _commandQueueIndices;
+        std::vector<uint32_t> _subpassIndices;
+        std::vector<uint32_t> _queueOwnershipTransferOffsets;
+        std::vector<QueueOwnershipTransfer> _queueOwnershipTransfers;
+        std::vector<uint32_t> _passBarrierOffsets;
+        std::vector<PassBarrier> _passBarriers;
+        std::vector<uint32_t> _splitBarrierSignalOffsets;
+        std::vector<uint32_t> _splitBarrierSignals;
+        uint32_t _numSplitBarriers = 0;
+        std::vector<uint32_t> _declaredHandleOffsets;
+        std::vector<ResourceHandle> _declaredHandles;
+        std::vector<uint32_t> _devirtualizeOffsets;
+        std::vector<uint32_t> _devirtualizes;
+        std::vector<uint32_t> _destroyOffsets;
+        std::vector<uint32_t> _destroyes;
+        std::vector<uint32_t> _transientMemorySlots;
+        TransientMemoryStats _transientMemoryStats;
+    };
+    CompileCache _compileCache;
+    CompileCacheStats _compileCacheStats;
+    std::vector<EdgeFingerprint> _edgeFingerprints;
+    uint64_t _structureHash = 0;
+
  private:
+    ArenaAllocator _frameArena;
     DependencyGraph _dependencyGraph;
-    CommandStream* _cmdStream = nullptr;
+
+    // History textures are kept across frames by name, so references to the storage stay valid
+    std::unordered_map<std::string, HistoryTextureStorage, TransparentStringHash, std::equal_to<>> _historyTextureStorages;
+    uint64_t _frameIndex = 0;
+
+    // Scopes are kept across frames so that their arenas are reused
+    std::vector<std::unique_ptr<FrameGraphDeclarationScope>> _declarationScopes;
+    uint32_t _numOpenDeclarationScopes = 0;
+
+    std::array<CommandStream*, NUM_COMMAND_QUEUE_TYPES> _cmdStreams{};
+    // Intermediate graphics submissions must wait for back buffer acquisition of the swapchain presented at the end
+    SwapChain* _swapChainToPresent = nullptr;
+    FrameContext _frameContextToPresent;
     RenderResourceAllocator* _renderResourceAllocator = nullptr;
-    FenceObject _lastSubmitFence = FenceObject::Default();
+    std::unique_ptr<tf::Executor> _recordingExecutor;
+    // Cleared at the start of each frame so that a frame without submission on a queue does not carry the old fence
+    std::array<FenceObject, NUM_COMMAND_QUEUE_TYPES> _frameSubmitFences{ FenceObject::Default(), FenceObject::Default(), FenceObject::Default() };
 };
 }  // namespace RenderGraph
 }  // namespace VoxFlow
@@ -0,0 +1,82 @@
+// Author : snowapril
+
+#ifndef VOXEL_FLOW_FRAME_GRAPH_BUFFER_HPP
+#define VOXEL_FLOW_FRAME_GRAPH_BUFFER_HPP
+
+#include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
+#include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <functional>
+#include <string_view>
+
+namespace VoxFlow
+{
+
+class RenderResourceAllocator;
+class CommandStream;
+class BufferView;
+
+namespace RenderGraph
+{
+struct FrameGraphBuffer
+{
+    struct Descriptor
+    {
+        uint64_t _size = 0;
+    };
+
+    using Usage = BufferUsage;
+
+    /**
+     * Suballocate buffer region from the transient buffer ring of the allocator.
+     * The region is valid until the end of the current frame.
+     * @return whether buffer suballocation is successful or not
+     */
+    bool create(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage);
+
+    /**
+     * Record release or acquire half of queue family ownership transfer of this buffer
+     * @param cmdStream command stream of the queue which records this half of the transfer
+     */
+    void transferQueueOwnership(CommandStream* cmdStream, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex, bool isRelease) const;
+
+    /**
+     * @return whether the given usage only reads buffer so that consecutive same usages need no barrier
+     */
+    static bool isReadOnlyUsage(Usage usage);
+
+    /**
+     * Record barrier planned at frame graph compile which transits this buffer to the given usage
+     * @param queueUsage usage of the queue which executes the pass accessing with the given usage
+     */
+    void addPlannedBarrier(CommandStream* cmdStream, Usage usage, CommandStreamUsage queueUsage) const;
+
+    /**
+     * Record signal half of the split barrier right after the producer pass
+     * @param splitBarrierIndex index of split barrier allotted at frame graph compile
+     */
+    void signalSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex, Usage usage, CommandStreamUsage queueUsage) const;
+
+    /**
+     * Record wait half of the split barrier right before the consumer pass
+     */
+    void waitSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex) const;
+
+    /**
+     * Suballocated region is reclaimed by the allocator once the frame is completed on GPU,
+     * so only the view is detached here.
+     */
+    void destroy(RenderResourceAllocator* resourceAllocator);
+
+    BufferView* _bufferView = nullptr;
+};
+}  // namespace RenderGraph
+
+}  // namespace VoxFlow
+
+template <>
+struct std::hash<VoxFlow::RenderGraph::FrameGraphBuffer::Descriptor>
+{
+    std::size_t operator()(VoxFlow::RenderGraph::FrameGraphBuffer::Descriptor const& descriptor) const noexcept;
+};
+
+#endif
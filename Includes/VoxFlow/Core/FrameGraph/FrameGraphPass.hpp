@@ -6,14 +6,13 @@
 #include <VoxFlow/Core/FrameGraph/DependencyGraph.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphRenderPass.hpp>
 #include <VoxFlow/Core/FrameGraph/Resource.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
 #include <VoxFlow/Core/Graphics/RenderPass/RenderPassParams.hpp>
 #include <VoxFlow/Core/Graphics/RenderPass/RenderTargetGroup.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <functional>
 #include <memory>
-#include <string>
 #include <string_view>
-#include <unordered_set>
 #include <vector>
 
 namespace VoxFlow
@@ -29,6 +28,7 @@ class FrameGraphBuilder;
 class FrameGraphResources;
 class PassNode;
 class VirtualResource;
+struct RenderPassData;
 
 class FrameGraphPassBase : private NonCopyable
 {
@@ -68,34 +68,78 @@ class FrameGraphPass : public FrameGraphPassBase
 class PassNode : public DependencyGraph::Node
 {
  public:
-    explicit PassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName);
+    /**
+     * Pass declared in declaration scope has no owner frame graph until the scope is merged.
+     * @param arenaAllocator arena where the pass is constructed. Pass name and containers of the pass are served from it
+     */
+    explicit PassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName);
     ~PassNode() override;
     PassNode(PassNode&& passNode);
     PassNode& operator=(PassNode&& passNode);
 
     virtual void execute(const FrameGraphResources* resources, CommandStream* cmdStream) = 0;
 
+    // Pass which flushes command stream must not be recorded concurrently with other passes
+    [[nodiscard]] virtual bool isSubmissionPass() const
+    {
+        return false;
+    }
+
+    // Render pass of the pass which can be merged with the adjacent passes as subpasses
+    [[nodiscard]] virtual RenderPassData* getMergeableRenderPassData()
+    {
+        return nullptr;
+    }
+
     void setSideEffectPass()
     {
         _refCount = UINT32_MAX;
     }
 
-    inline const std::string& getPassName() const
+    inline void setQueueAffinity(CommandStreamUsage queueAffinity)
+    {
+        _queueAffinity = queueAffinity;
+    }
+
+    [[nodiscard]] inline CommandStreamUsage getQueueAffinity() const
+    {
+        return _queueAffinity;
+    }
+
+    inline void setEnablePredicate(std::function<bool()>&& enablePredicate)
+    {
+        _enablePredicate = std::move(enablePredicate);
+    }
+
+    [[nodiscard]] inline bool hasEnablePredicate() const
+    {
+        return _enablePredicate != nullptr;
+    }
+
+    // Predicate is evaluated every execute, so that toggling it does not change the compiled graph
+    [[nodiscard]] inline bool isEnabled() const
+    {
+        return (_enablePredicate == nullptr) || _enablePredicate();
+    }
+
+    inline std::string_view getPassName() const
     {
         return _passName;
     }
 
-    inline const std::unordered_set<ResourceHandle>& getDeclaredHandles() const
+    inline const ArenaVector<ResourceHandle>& getDeclaredHandles() const
     {
         return _declaredHandles;
     }
 
-    inline const std::vector<VirtualResource*>& getDevirtualizes() const
+    [[nodiscard]] bool isDeclaredHandle(ResourceHandle resourceHandle) const;
+
+    inline const ArenaVector<VirtualResource*>& getDevirtualizes() const
     {
         return _devirtualizes;
     }
 
-    inline const std::vector<VirtualResource*>& getDestroyes() const
+    inline const ArenaVector<VirtualResource*>& getDestroyes() const
     {
         return _destroyes;
     }
@@ -105,11 +149,23 @@ class PassNode : public DependencyGraph::Node
     void addDestroy(VirtualResource* resource);
     virtual void resolve(FrameGraph* frameGraph) = 0;
 
+    /**
+     * Infer load and store operations of attachments from whether they are written before and
+     * referenced after this pass. Must be called after all live passes registered their resources.
+     */
+    virtual void inferAttachmentOperations(FrameGraph* frameGraph)
+    {
+        (void)frameGraph;
+    }
+
  protected:
-    std::unordered_set<ResourceHandle> _declaredHandles;
-    std::vector<VirtualResource*> _devirtualizes;
-    std::vector<VirtualResource*> _destroyes;
-    std::string _passName;
+    // Each pass declares only a few handles, so that linear search is cheaper than hashing
+    ArenaVector<ResourceHandle> _declaredHandles;
+    ArenaVector<VirtualResource*> _devirtualizes;
+    ArenaVector<VirtualResource*> _destroyes;
+    std::string_view _passName;
+    std::function<bool()> _enablePredicate;
+    CommandStreamUsage _queueAffinity = CommandStreamUsage::Graphics;
     bool _hasSideEffect = false;
 };
 
@@ -121,6 +177,13 @@ struct RenderPassData
     AttachmentGroup _attachmentGroup;
     RenderPassParams _passParams;
 
+    // Attachments in the slot order of attachment group, resolved at compile. Input attachments
+    // which are not written by this render pass follow the color attachments.
+    std::vector<ResourceHandle> _colorAttachmentHandles;
+    ResourceHandle _depthStencilHandle;
+
+    [[nodiscard]] bool hasAttachment(ResourceHandle handle) const;
+
     void devirtualize(FrameGraph* frameGraph, RenderResourceAllocator* allocator);
     void destroy(RenderResourceAllocator* allocator);
 };
@@ -128,7 +191,7 @@ struct RenderPassData
 class RenderPassNode final : public PassNode
 {
  public:
-    explicit RenderPassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName, std::unique_ptr<FrameGraphPassBase>&& pass);
+    explicit RenderPassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName, FrameGraphPassBase* pass);
     ~RenderPassNode() override;
     RenderPassNode(RenderPassNode&& passNode);
     RenderPassNode& operator=(RenderPassNode&& passNode);
@@ -159,22 +222,37 @@ class RenderPassNode final : public PassNode
      */
     void resolve(FrameGraph* frameGraph) final;
 
+    void inferAttachmentOperations(FrameGraph* frameGraph) final;
+
+    // Only pass with a single render pass is merged, as recording between render passes is unknown
+    [[nodiscard]] RenderPassData* getMergeableRenderPassData() final
+    {
+        return (_renderPassDatas.size() == 1) ? &_renderPassDatas.front() : nullptr;
+    }
+
  protected:
  private:
-    std::unique_ptr<FrameGraphPassBase> _passImpl = nullptr;
-    std::vector<RenderPassData> _renderPassDatas;
+    // Pass implementation is owned by the frame arena of owner frame graph
+    FrameGraphPassBase* _passImpl = nullptr;
+    ArenaVector<RenderPassData> _renderPassDatas;
 };
 
 class PresentPassNode final : public PassNode
 {
  public:
-    explicit PresentPassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName, SwapChain* swapChainToPresent, const FrameContext& frameContext);
+    explicit PresentPassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName, SwapChain* swapChainToPresent,
+                             const FrameContext& frameContext);
     ~PresentPassNode() final;
     PresentPassNode(PresentPassNode&& passNode);
     PresentPassNode& operator=(PresentPassNode&& passNode);
 
     void execute(const FrameGraphResources* resources, CommandStream* cmdStream) final;
 
+    [[nodiscard]] bool isSubmissionPass() const final
+    {
+        return true;
+    }
+
     void resolve(FrameGraph* frameGraph) final
     {
         (void)frameGraph;
@@ -23,6 +23,11 @@ struct FrameGraphRenderPass
         std::array<ResourceHandle, MAX_RENDER_TARGET_COUNTS + 1> _attachments = {
             INVALID_RESOURCE_HANDLE,
         };
+        // Color attachments of the previous passes read at the same pixel, in order of input attachment index.
+        // Must be also declared as read with TextureUsage::InputAttachment.
+        std::array<ResourceHandle, MAX_RENDER_TARGET_COUNTS> _inputAttachments = {
+            INVALID_RESOURCE_HANDLE,
+        };
         glm::uvec2 _viewportSize = glm::uvec2(0U, 0U);
         std::array<glm::vec4, MAX_RENDER_TARGET_COUNTS> _clearColors;
         float _clearDepth = 0.0f;
@@ -30,6 +35,8 @@ struct FrameGraphRenderPass
         AttachmentMaskFlags _clearFlags = AttachmentMaskFlags::None;
         AttachmentMaskFlags _writableAttachment = AttachmentMaskFlags::All;
         uint8_t _numSamples = 1;
+        // Draws are recorded by multiple threads with FrameGraphResources::recordSecondaryCommands instead of inline
+        bool _useSecondaryCommandBuffers = false;
     };
 
     struct ImportedDescriptor
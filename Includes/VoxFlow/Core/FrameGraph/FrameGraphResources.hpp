@@ -7,10 +7,13 @@
 #include <VoxFlow/Core/FrameGraph/Resource.hpp>
 #include <VoxFlow/Core/FrameGraph/ResourceHandle.hpp>
 #include <VoxFlow/Core/FrameGraph/TypeTraits.hpp>
+#include <functional>
 
 namespace VoxFlow
 {
 class TextureView;
+class CommandStream;
+class SecondaryCommandGroup;
 
 namespace RenderGraph
 {
@@ -49,6 +52,17 @@ class FrameGraphResources
         return static_cast<RenderPassNode*>(_passNode)->getRenderPassData(rpID);
     }
 
+    /**
+     * Record draws of the current subpass into secondary command buffers on the recording workers, and execute them
+     * from the given command stream. Subpass must be declared with _useSecondaryCommandBuffers and begun before.
+     * Resources bound by chunks must be declared by the pass, as they are transited only by its planned barriers before the render pass.
+     * @param numItems number of items such as draws which are split into chunks
+     * @param numItemsPerChunk number of items recorded into a single secondary command buffer
+     * @param recordChunk callable of (SecondaryCommandGroup* group, uint32_t chunkIndex, uint32_t itemBegin, uint32_t itemEnd)
+     */
+    void recordSecondaryCommands(CommandStream* cmdStream, const uint32_t numItems, const uint32_t numItemsPerChunk,
+                                 const std::function<void(SecondaryCommandGroup*, uint32_t, uint32_t, uint32_t)>& recordChunk) const;
+
  private:
     FrameGraph* _frameGraph = nullptr;
     PassNode* _passNode = nullptr;
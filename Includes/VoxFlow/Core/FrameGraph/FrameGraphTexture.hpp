@@ -3,15 +3,19 @@
 #ifndef VOXEL_FLOW_FRAME_GRAPH_TEXTURE_HPP
 #define VOXEL_FLOW_FRAME_GRAPH_TEXTURE_HPP
 
+#include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
 #include <VoxFlow/Core/Resources/Handle.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <functional>
 #include <string_view>
 
 namespace VoxFlow
 {
 
 class RenderResourceAllocator;
+class CommandStream;
 class Texture;
+class TextureView;
 
 namespace RenderGraph
 {
@@ -25,19 +29,94 @@ struct FrameGraphTexture
         uint8_t _level = 0;
         uint8_t _sampleCounts = 0;
         VkFormat _format = VK_FORMAT_UNDEFINED;
+
+        bool operator==(const Descriptor& rhs) const = default;
     };
 
     using Usage = TextureUsage;
 
-    bool create(RenderResourceAllocator* resourceAllocator, std::string&& debugName, Descriptor descriptor, Usage usage);
+    /**
+     * Acquire texture from the transient texture pool which is shared across frames.
+     * @return whether texture creation is successful or not
+     */
+    bool create(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage);
+
+    /**
+     * Allocate texture which is owned by this object rather than the transient texture pool, so that
+     * its content persists across frames. Destroying it keeps the texture alive.
+     * @return whether texture creation is successful or not
+     */
+    bool createPersistent(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage);
+
+    /**
+     * Create texture placed at the transient memory slot shared with other textures whose lifetimes do not overlap.
+     * Content of aliased memory is undefined, so aliasing barrier must be recorded before the first access.
+     * @param transientSlot transient memory slot index allotted at frame graph compile
+     * @return whether texture creation is successful or not
+     */
+    bool createAliased(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage, uint32_t transientSlot);
+
+    /**
+     * Record barrier which waits for every access to the transient memory slot recorded before, and discards content of this texture
+     */
+    void addAliasingBarrier(CommandStream* cmdStream) const;
+
+    /**
+     * @return estimated number of bytes which texture with given descriptor occupies
+     */
+    static uint64_t estimateMemorySize(const Descriptor& descriptor);
+
+    /**
+     * @return usage of texture which is used only within a render pass, so that it can be placed on lazily allocated memory
+     */
+    static Usage makeTransientAttachmentUsage(Usage usage);
+
+    /**
+     * Record release or acquire half of queue family ownership transfer of this texture
+     * @param cmdStream command stream of the queue which records this half of the transfer
+     */
+    void transferQueueOwnership(CommandStream* cmdStream, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex, bool isRelease) const;
 
+    /**
+     * @return whether the given usage only reads texture so that consecutive same usages need no barrier
+     */
+    static bool isReadOnlyUsage(Usage usage);
+
+    /**
+     * Record barrier planned at frame graph compile which transits this texture to the given usage
+     * @param queueUsage usage of the queue which executes the pass accessing with the given usage
+     */
+    void addPlannedBarrier(CommandStream* cmdStream, Usage usage, CommandStreamUsage queueUsage) const;
+
+    /**
+     * Record signal half of the split barrier right after the producer pass
+     * @param splitBarrierIndex index of split barrier allotted at frame graph compile
+     */
+    void signalSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex, Usage usage, CommandStreamUsage queueUsage) const;
+
+    /**
+     * Record wait half of the split barrier right before the consumer pass
+     */
+    void waitSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex) const;
+
+    /**
+     * Return pooled texture to the transient texture pool. Aliased texture is kept
+     * in its transient memory slot instead.
+     */
     void destroy(RenderResourceAllocator* resourceAllocator);
 
     std::shared_ptr<Texture> _texture;
     TextureView* _textureView = nullptr;
+    bool _isPooled = false;
 };
 }  // namespace RenderGraph
 
 }  // namespace VoxFlow
 
+template <>
+struct std::hash<VoxFlow::RenderGraph::FrameGraphTexture::Descriptor>
+{
+    std::size_t operator()(VoxFlow::RenderGraph::FrameGraphTexture::Descriptor const& descriptor) const noexcept;
+};
+
 #endif
\ No newline at end of file
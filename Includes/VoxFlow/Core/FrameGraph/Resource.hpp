@@ -5,40 +5,69 @@
 
 #include <VoxFlow/Core/FrameGraph/DependencyGraph.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphRenderPass.hpp>
+#include <VoxFlow/Core/FrameGraph/FrameGraphBuffer.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphTexture.hpp>
 #include <VoxFlow/Core/FrameGraph/ResourceHandle.hpp>
 #include <VoxFlow/Core/FrameGraph/TypeTraits.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
+#include <array>
 #include <memory>
+#include <string>
 #include <string_view>
 
 namespace VoxFlow
 {
 class Texture;
+class CommandStream;
 
 namespace RenderGraph
 {
 class PassNode;
 class FrameGraph;
 
+constexpr uint32_t INVALID_TRANSIENT_MEMORY_SLOT = UINT32_MAX;
+
 class ResourceEdgeBase : public DependencyGraph::Edge
 {
  public:
     explicit ResourceEdgeBase(DependencyGraph* ownerGraph, DependencyGraph::Node* from, DependencyGraph::Node* to) : DependencyGraph::Edge(ownerGraph, from, to)
     {
     }
+
+    /**
+     * @return usage of the edge regardless of the resource type
+     */
+    [[nodiscard]] virtual uint32_t getUsageBits() const = 0;
 };
 
 class ResourceNode : public DependencyGraph::Node
 {
  public:
-    explicit ResourceNode(DependencyGraph* dependencyGraph, ResourceHandle resourceHandle);
+    explicit ResourceNode(DependencyGraph* dependencyGraph, ResourceHandle resourceHandle, ResourceNode* previousVersionNode = nullptr);
 
     inline ResourceHandle getResourceHandle() const
     {
         return _resourceHandle;
     }
 
+    /**
+     * @return node of the same resource before the write which produced this version. nullptr for the first version.
+     */
+    [[nodiscard]] inline const ResourceNode* getPreviousVersionNode() const
+    {
+        return _previousVersionNode;
+    }
+
+    [[nodiscard]] inline bool hasWriterPass() const
+    {
+        return _incomingEdge != nullptr;
+    }
+
+    [[nodiscard]] inline bool hasReaderPasses() const
+    {
+        return _outgoingEdges.empty() == false;
+    }
+
     ResourceEdgeBase* getReaderEdgeForPassNode(const PassNode* passNode);
     ResourceEdgeBase* getWriterEdgeForPassNode(const PassNode* passNode);
 
@@ -48,14 +77,16 @@ class ResourceNode : public DependencyGraph::Node
 
  private:
     ResourceHandle _resourceHandle;
-    std::vector<DependencyGraph::Edge*> _outgoingEdges;
+    ResourceNode* _previousVersionNode = nullptr;
+    ArenaVector<DependencyGraph::Edge*> _outgoingEdges;
     DependencyGraph::Edge* _incomingEdge = nullptr;
 };
 
 class VirtualResource : private NonCopyable
 {
  public:
-    VirtualResource(std::string&& name);
+    // Name must be valid until the resource is destructed, such as the one copied into the frame arena
+    VirtualResource(std::string_view name);
     virtual ~VirtualResource();
 
     virtual bool isImported() const
@@ -63,6 +94,23 @@ class VirtualResource : private NonCopyable
         return false;
     }
 
+    /**
+     * @return whether memory of the resource outlives the frame, so that its content is kept before
+     * and after the frame and must not be shared with transient resources.
+     */
+    [[nodiscard]] virtual bool isPersistent() const
+    {
+        return isImported();
+    }
+
+    /**
+     * @return whether passes are only allowed to read the resource
+     */
+    [[nodiscard]] virtual bool isReadOnly() const
+    {
+        return false;
+    }
+
     void isReferencedByPass(PassNode* passNode);
 
     [[nodiscard]] inline uint32_t isCulled() const
@@ -70,6 +118,20 @@ class VirtualResource : private NonCopyable
         return _refCount == 0;
     }
 
+    /**
+     * Mark whether any pass enabled at the current execute references this resource.
+     * Resource referenced only by disabled passes stays virtual and has no barriers recorded.
+     */
+    inline void setReferencedByEnabledPass(const bool isReferenced)
+    {
+        _isReferencedByEnabledPass = isReferenced;
+    }
+
+    [[nodiscard]] inline bool isReferencedByEnabledPass() const
+    {
+        return _isReferencedByEnabledPass;
+    }
+
     [[nodiscard]] inline PassNode* getFirstReferencedPassNode() const
     {
         return _firstPass;
@@ -80,32 +142,160 @@ class VirtualResource : private NonCopyable
         return _lastPass;
     }
 
-    [[nodiscard]] inline const std::string& getResourceName() const
+    [[nodiscard]] inline std::string_view getResourceName() const
     {
         return _resourceName;
     }
 
+    /**
+     * @return estimated memory size in bytes used for planning transient memory aliasing.
+     * zero if the resource can not share its memory with others.
+     */
+    [[nodiscard]] virtual uint64_t getEstimatedMemorySize() const
+    {
+        return 0;
+    }
+
+    /**
+     * Place this resource at the given transient memory slot which is shared with other resources
+     * whose lifetimes do not overlap with this one.
+     * @param slot transient memory slot index
+     */
+    inline void setTransientMemorySlot(const uint32_t slot)
+    {
+        _transientMemorySlot = slot;
+    }
+
+    [[nodiscard]] inline uint32_t getTransientMemorySlot() const
+    {
+        return _transientMemorySlot;
+    }
+
+    /**
+     * Let the resource which is used only within a render pass be transient attachment.
+     * It never shares transient memory slot with others as its memory might be lazily allocated.
+     */
+    virtual void makeTransientAttachment()
+    {
+    }
+
+    [[nodiscard]] inline bool isTransientAttachment() const
+    {
+        return _isTransientAttachment;
+    }
+
+    /**
+     * Record release or acquire half of queue family ownership transfer of the devirtualized resource
+     * @param cmdStream command stream of the queue which records this half of the transfer
+     * @param srcQueueFamilyIndex queue family index which owned the resource so far
+     * @param dstQueueFamilyIndex queue family index which will own the resource
+     * @param isRelease whether to record release half on source queue or acquire half on destination queue
+     */
+    virtual void transferQueueOwnership(CommandStream* cmdStream, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                        const bool isRelease)
+    {
+        (void)cmdStream;
+        (void)srcQueueFamilyIndex;
+        (void)dstQueueFamilyIndex;
+        (void)isRelease;
+    }
+
+    /**
+     * @return whether barriers of this resource can be planned at frame graph compile
+     */
+    [[nodiscard]] virtual bool isBarrierPlannable() const
+    {
+        return false;
+    }
+
+    /**
+     * @return usage of the given edge connected to the node of this resource in bits
+     */
+    [[nodiscard]] virtual uint32_t getEdgeUsage(const DependencyGraph::Edge* edge) const
+    {
+        (void)edge;
+        return 0;
+    }
+
+    /**
+     * @return whether the given usage only reads the resource so that consecutive same usages need no barrier
+     */
+    [[nodiscard]] virtual bool isReadOnlyUsage(const uint32_t usage) const
+    {
+        (void)usage;
+        return false;
+    }
+
+    /**
+     * Record barrier which transits the devirtualized resource to the given usage
+     */
+    virtual void addPlannedBarrier(CommandStream* cmdStream, const uint32_t usage, const CommandStreamUsage queueUsage)
+    {
+        (void)cmdStream;
+        (void)usage;
+        (void)queueUsage;
+    }
+
+    /**
+     * Record signal half of the split barrier which transits the devirtualized resource to the given usage
+     */
+    virtual void signalSplitBarrier(CommandStream* cmdStream, const uint32_t splitBarrierIndex, const uint32_t usage, const CommandStreamUsage queueUsage)
+    {
+        (void)cmdStream;
+        (void)splitBarrierIndex;
+        (void)usage;
+        (void)queueUsage;
+    }
+
+    /**
+     * Record wait half of the split barrier signaled by the previous accessing pass
+     */
+    virtual void waitSplitBarrier(CommandStream* cmdStream, const uint32_t splitBarrierIndex)
+    {
+        (void)cmdStream;
+        (void)splitBarrierIndex;
+    }
+
+    /**
+     * Connect the given pass to the node of this resource with usage in bits, so that the connection
+     * can be recorded without the resource type and made later
+     * @param isWrite whether the pass writes to the node or reads from it
+     */
+    virtual bool connectUsage(DependencyGraph* dependencyGraph, ResourceNode* node, PassNode* passNode, const uint32_t usage, const bool isWrite) = 0;
+
     virtual void devirtualize(RenderResourceAllocator*) = 0;
 
+    /**
+     * Record barrier which makes accesses of the previous occupants of the transient memory slot finish
+     * before the first access of the devirtualized resource. Resolved in translation order of the command stream.
+     */
+    virtual void addAliasingBarrier(CommandStream* cmdStream)
+    {
+        (void)cmdStream;
+    }
+
     virtual void destroy(RenderResourceAllocator*) = 0;
 
-    virtual void resolveUsage(DependencyGraph* dependencyGraph, const DependencyGraph::EdgeContainer& edges, DependencyGraph::Edge* writerEdge) = 0;
+    virtual void resolveUsage(DependencyGraph* dependencyGraph, DependencyGraph::EdgeSpan edges, DependencyGraph::Edge* writerEdge) = 0;
 
  protected:
-    std::string _resourceName;
+    std::string_view _resourceName;
     PassNode* _firstPass = nullptr;
     PassNode* _lastPass = nullptr;
     uint32_t _refCount = 0;
+    uint32_t _transientMemorySlot = INVALID_TRANSIENT_MEMORY_SLOT;
+    bool _isTransientAttachment = false;
+    bool _isReferencedByEnabledPass = true;
 };
 
 template <ResourceConcept ResourceDataType>
 class Resource : public VirtualResource
 {
  public:
-    explicit Resource(std::string&& name, typename ResourceDataType::Descriptor&& resourceArgs);
-    explicit Resource(std::string&& name, typename ResourceDataType::Descriptor&& resourceArgs, const ResourceDataType& resource);
-    explicit Resource(std::string&& name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage);
-    explicit Resource(std::string&& name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage,
+    explicit Resource(std::string_view name, typename ResourceDataType::Descriptor&& resourceArgs);
+    explicit Resource(std::string_view name, typename ResourceDataType::Descriptor&& resourceArgs, const ResourceDataType& resource);
+    explicit Resource(std::string_view name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage);
+    explicit Resource(std::string_view name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage,
                       const ResourceDataType& resource);
     ~Resource() = default;
 
@@ -125,9 +315,46 @@ class Resource : public VirtualResource
         return _descriptor;
     }
 
+    [[nodiscard]] uint64_t getEstimatedMemorySize() const override
+    {
+        if constexpr (TransientAliasableConcept<ResourceDataType>)
+        {
+            return ResourceDataType::estimateMemorySize(_descriptor);
+        }
+        return 0;
+    }
+
+    void makeTransientAttachment() override
+    {
+        if constexpr (TransientAttachmentConcept<ResourceDataType>)
+        {
+            _usage = ResourceDataType::makeTransientAttachmentUsage(_usage);
+            _isTransientAttachment = true;
+        }
+    }
+
     void devirtualize(RenderResourceAllocator* allocator) override
     {
-        _resource.create(allocator, std::move(_resourceName), _descriptor, _usage);
+        if constexpr (TransientAliasableConcept<ResourceDataType>)
+        {
+            if (_transientMemorySlot != INVALID_TRANSIENT_MEMORY_SLOT)
+            {
+                _resource.createAliased(allocator, _resourceName, _descriptor, _usage, _transientMemorySlot);
+                return;
+            }
+        }
+        _resource.create(allocator, _resourceName, _descriptor, _usage);
+    }
+
+    void addAliasingBarrier(CommandStream* cmdStream) override
+    {
+        if constexpr (TransientAliasableConcept<ResourceDataType>)
+        {
+            if (_transientMemorySlot != INVALID_TRANSIENT_MEMORY_SLOT)
+            {
+                _resource.addAliasingBarrier(cmdStream);
+            }
+        }
     }
 
     void destroy(RenderResourceAllocator* allocator) override
@@ -135,6 +362,58 @@ class Resource : public VirtualResource
         _resource.destroy(allocator);
     }
 
+    void transferQueueOwnership(CommandStream* cmdStream, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                const bool isRelease) override
+    {
+        if constexpr (QueueOwnershipTransferableConcept<ResourceDataType>)
+        {
+            _resource.transferQueueOwnership(cmdStream, srcQueueFamilyIndex, dstQueueFamilyIndex, isRelease);
+        }
+    }
+
+    [[nodiscard]] bool isBarrierPlannable() const override
+    {
+        return BarrierPlannableConcept<ResourceDataType>;
+    }
+
+    [[nodiscard]] uint32_t getEdgeUsage(const DependencyGraph::Edge* edge) const override
+    {
+        return static_cast<uint32_t>(static_cast<const ResourceEdge*>(edge)->getUsage());
+    }
+
+    [[nodiscard]] bool isReadOnlyUsage(const uint32_t usage) const override
+    {
+        if constexpr (BarrierPlannableConcept<ResourceDataType>)
+        {
+            return ResourceDataType::isReadOnlyUsage(static_cast<typename ResourceDataType::Usage>(usage));
+        }
+        return false;
+    }
+
+    void addPlannedBarrier(CommandStream* cmdStream, const uint32_t usage, const CommandStreamUsage queueUsage) override
+    {
+        if constexpr (BarrierPlannableConcept<ResourceDataType>)
+        {
+            _resource.addPlannedBarrier(cmdStream, static_cast<typename ResourceDataType::Usage>(usage), queueUsage);
+        }
+    }
+
+    void signalSplitBarrier(CommandStream* cmdStream, const uint32_t splitBarrierIndex, const uint32_t usage, const CommandStreamUsage queueUsage) override
+    {
+        if constexpr (BarrierPlannableConcept<ResourceDataType>)
+        {
+            _resource.signalSplitBarrier(cmdStream, splitBarrierIndex, static_cast<typename ResourceDataType::Usage>(usage), queueUsage);
+        }
+    }
+
+    void waitSplitBarrier(CommandStream* cmdStream, const uint32_t splitBarrierIndex) override
+    {
+        if constexpr (BarrierPlannableConcept<ResourceDataType>)
+        {
+            _resource.waitSplitBarrier(cmdStream, splitBarrierIndex);
+        }
+    }
+
  public:
     class ResourceEdge : public ResourceEdgeBase
     {
@@ -149,6 +428,11 @@ class Resource : public VirtualResource
             return _usage;
         }
 
+        [[nodiscard]] uint32_t getUsageBits() const override
+        {
+            return static_cast<uint32_t>(_usage);
+        }
+
         ResourceEdge& operator|=(typename ResourceDataType::Usage usage)
         {
             _usage |= usage;
@@ -164,7 +448,13 @@ class Resource : public VirtualResource
     // Make connection to given resource node from pass node with specific usage
     bool connect(DependencyGraph* dependencyGraph, PassNode* passNode, ResourceNode* node, typename ResourceDataType::Usage usage);
 
-    void resolveUsage(DependencyGraph* dependencyGraph, const DependencyGraph::EdgeContainer& edges, DependencyGraph::Edge* writerEdge) override final;
+    bool connectUsage(DependencyGraph* dependencyGraph, ResourceNode* node, PassNode* passNode, const uint32_t usage, const bool isWrite) override final
+    {
+        const typename ResourceDataType::Usage typedUsage = static_cast<typename ResourceDataType::Usage>(usage);
+        return isWrite ? connect(dependencyGraph, passNode, node, typedUsage) : connect(dependencyGraph, node, passNode, typedUsage);
+    }
+
+    void resolveUsage(DependencyGraph* dependencyGraph, DependencyGraph::EdgeSpan edges, DependencyGraph::Edge* writerEdge) override final;
 
  protected:
     typename ResourceDataType::Descriptor _descriptor;
@@ -177,9 +467,9 @@ template <ResourceConcept ResourceDataType>
 class ImportedResource : public Resource<ResourceDataType>
 {
  public:
-    ImportedResource(std::string&& name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage,
+    ImportedResource(std::string_view name, typename ResourceDataType::Descriptor&& resourceArgs, typename ResourceDataType::Usage usage,
                      const ResourceDataType& resource)
-        : Resource<ResourceDataType>(std::move(name), std::move(resourceArgs), usage, resource)
+        : Resource<ResourceDataType>(name, std::move(resourceArgs), usage, resource)
     {
     }
     ~ImportedResource()
@@ -200,7 +490,7 @@ class ImportedResource : public Resource<ResourceDataType>
 class ImportedRenderTarget : public ImportedResource<FrameGraphTexture>
 {
  public:
-    ImportedRenderTarget(std::string&& name, FrameGraphTexture::Descriptor&& resourceArgs, FrameGraphRenderPass::ImportedDescriptor&& importedDesc,
+    ImportedRenderTarget(std::string_view name, FrameGraphTexture::Descriptor&& resourceArgs, FrameGraphRenderPass::ImportedDescriptor&& importedDesc,
                          const FrameGraphTexture& resource, TextureView* textureView);
     ~ImportedRenderTarget();
 
@@ -213,6 +503,69 @@ class ImportedRenderTarget : public ImportedResource<FrameGraphTexture>
  private:
     TextureView* _textureViewHandle = nullptr;
 };
+
+/**
+ * Pair of textures persisting across frames. One of them is written in the current frame
+ * while the other keeps content written in the previous frame, and they are swapped every frame.
+ */
+struct HistoryTextureStorage
+{
+    std::string _historyName;
+    std::array<FrameGraphTexture, 2> _textures;
+    FrameGraphTexture::Descriptor _descriptor;
+    // Usage declared at createHistory which both textures are allocated with
+    TextureUsage _usage = TextureUsage::Unknown;
+    TextureUsage _allocatedUsage = TextureUsage::Unknown;
+    bool _isAllocationDirty = true;
+    uint32_t _currentIndex = 0;
+    uint64_t _lastDeclaredFrameIndex = UINT64_MAX;
+};
+
+class HistoryTexture : public Resource<FrameGraphTexture>
+{
+ public:
+    HistoryTexture(std::string_view name, FrameGraphTexture::Descriptor&& resourceArgs, HistoryTextureStorage* storage, const uint32_t textureIndex);
+    ~HistoryTexture() = default;
+
+ public:
+    inline bool isPersistent() const final
+    {
+        return true;
+    }
+
+    // Texture written in the previous frame must not be overwritten
+    inline bool isReadOnly() const final
+    {
+        return _textureIndex != _storage->_currentIndex;
+    }
+
+    /**
+     * @param pairedTexture history texture declared in the same frame with the other texture of the storage
+     */
+    inline void setPairedTexture(const HistoryTexture* pairedTexture)
+    {
+        _pairedTexture = pairedTexture;
+    }
+
+    /**
+     * @return usage both textures of the storage are allocated with. It covers usages of the current and the
+     * history texture in every frame, so that it stays same across frames while the declared usage is same.
+     */
+    [[nodiscard]] TextureUsage getAllocationUsage() const;
+
+    /**
+     * Allocate both textures of the storage at the first use or when declared descriptor or usage is changed.
+     * Otherwise the texture allocated in the previous frames is used as is.
+     */
+    void devirtualize(RenderResourceAllocator* allocator) final;
+
+    void destroy(RenderResourceAllocator*) final{};
+
+ private:
+    HistoryTextureStorage* _storage = nullptr;
+    const HistoryTexture* _pairedTexture = nullptr;
+    uint32_t _textureIndex = 0;
+};
 }  // namespace RenderGraph
 }  // namespace VoxFlow
 
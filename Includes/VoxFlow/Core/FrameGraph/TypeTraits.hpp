@@ -3,14 +3,17 @@
 #ifndef VOXEL_FLOW_FRAME_GRAPH_CONCEPT_HPP
 #define VOXEL_FLOW_FRAME_GRAPH_CONCEPT_HPP
 
+#include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
 #include <concepts>
-#include <string>
+#include <cstdint>
+#include <string_view>
 #include <type_traits>
 
 namespace VoxFlow
 {
 
 class RenderResourceAllocator;
+class CommandStream;
 
 namespace RenderGraph
 {
@@ -23,13 +26,60 @@ concept ResourceConcept = requires(Type resource)
     requires std::is_default_constructible_v<Type> and std::is_move_constructible_v<Type>;
 
     {
-        resource.create((RenderResourceAllocator *)nullptr, std::string{}, typename Type::Descriptor{}, typename Type::Usage{})
+        resource.create((RenderResourceAllocator *)nullptr, std::string_view{}, typename Type::Descriptor{}, typename Type::Usage{})
         } -> std::same_as<bool>;
     {
         resource.destroy((RenderResourceAllocator *)nullptr)
         } -> std::same_as<void>;
 };
 
+template <typename Type>
+concept TransientAliasableConcept = ResourceConcept<Type> and requires(Type resource)
+{
+    {
+        Type::estimateMemorySize(typename Type::Descriptor{})
+        } -> std::convertible_to<uint64_t>;
+    {
+        resource.createAliased((RenderResourceAllocator *)nullptr, std::string_view{}, typename Type::Descriptor{}, typename Type::Usage{}, uint32_t{})
+        } -> std::same_as<bool>;
+    {
+        resource.addAliasingBarrier((CommandStream *)nullptr)
+        } -> std::same_as<void>;
+};
+
+template <typename Type>
+concept TransientAttachmentConcept = ResourceConcept<Type> and requires
+{
+    {
+        Type::makeTransientAttachmentUsage(typename Type::Usage{})
+        } -> std::same_as<typename Type::Usage>;
+};
+
+template <typename Type>
+concept QueueOwnershipTransferableConcept = ResourceConcept<Type> and requires(const Type resource)
+{
+    {
+        resource.transferQueueOwnership((CommandStream *)nullptr, uint32_t{}, uint32_t{}, bool{})
+        } -> std::same_as<void>;
+};
+
+template <typename Type>
+concept BarrierPlannableConcept = ResourceConcept<Type> and requires(const Type resource)
+{
+    {
+        Type::isReadOnlyUsage(typename Type::Usage{})
+        } -> std::same_as<bool>;
+    {
+        resource.addPlannedBarrier((CommandStream *)nullptr, typename Type::Usage{}, CommandStreamUsage{})
+        } -> std::same_as<void>;
+    {
+        resource.signalSplitBarrier((CommandStream *)nullptr, uint32_t{}, typename Type::Usage{}, CommandStreamUsage{})
+        } -> std::same_as<void>;
+    {
+        resource.waitSplitBarrier((CommandStream *)nullptr, uint32_t{})
+        } -> std::same_as<void>;
+};
+
 template <typename Type>
 concept RenderPassConcept = requires(Type resource)
 {
@@ -14,7 +14,11 @@
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <array>
+#include <memory>
+#include <numeric>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace VoxFlow
 {
@@ -31,6 +35,49 @@ class BasePipeline;
 class ResourceView;
 class LogicalDevice;
 
+// State commands which are dropped by command buffer when the same state is already set
+enum class StateCommandType : uint32_t
+{
+    BindPipeline = 0,
+    BindVertexBuffer = 1,
+    BindIndexBuffer = 2,
+    SetViewport = 3,
+    BindDescriptorSet = 4,
+    Count = 5
+};
+
+// Number of state commands emitted into or skipped by command buffers
+struct StateCommandStats
+{
+    std::array<uint32_t, static_cast<uint32_t>(StateCommandType::Count)> _numEmitted{};
+    std::array<uint32_t, static_cast<uint32_t>(StateCommandType::Count)> _numSkipped{};
+    // Descriptor sets written for bindings, and the ones found already written with the same bindings
+    uint32_t _numDescriptorSetWrites = 0;
+    uint32_t _numDescriptorSetCacheHits = 0;
+
+    inline StateCommandStats& operator+=(const StateCommandStats& rhs)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(StateCommandType::Count); ++i)
+        {
+            _numEmitted[i] += rhs._numEmitted[i];
+            _numSkipped[i] += rhs._numSkipped[i];
+        }
+        _numDescriptorSetWrites += rhs._numDescriptorSetWrites;
+        _numDescriptorSetCacheHits += rhs._numDescriptorSetCacheHits;
+        return *this;
+    }
+
+    [[nodiscard]] inline uint32_t getNumEmitted() const
+    {
+        return std::accumulate(_numEmitted.begin(), _numEmitted.end(), 0U);
+    }
+
+    [[nodiscard]] inline uint32_t getNumSkipped() const
+    {
+        return std::accumulate(_numSkipped.begin(), _numSkipped.end(), 0U);
+    }
+};
+
 class CommandBuffer : private NonCopyable
 {
  public:
@@ -45,15 +92,27 @@ class CommandBuffer : private NonCopyable
     // Begin command buffer to record new commands
     void beginCommandBuffer(const FenceObject& fenceToSignal, const std::string& debugName);
 
+    /**
+     * Begin secondary command buffer which continues the current subpass of the given primary command buffer.
+     * Render pass, frame buffer and fence to signal are inherited from the primary one.
+     */
+    void beginSecondaryCommandBuffer(const CommandBuffer& primaryCmdBuffer, const std::string& debugName);
+
     // End command buffer recording
     void endCommandBuffer();
 
-    // Begin RenderPass scope
+    // Begin RenderPass scope, or step to the next subpass if pass is merged into the bound render pass
     void beginRenderPass(const AttachmentGroup& attachmentGroup, const RenderPassParams& passParams);
 
-    // End RenderPass scope
+    // End RenderPass scope. Deferred until the last subpass of the bound render pass
     void endRenderPass();
 
+    /**
+     * Execute secondary command buffers in the current subpass which begins with secondary command buffer contents.
+     * Pipeline and resource bindings of this command buffer are invalidated after execution.
+     */
+    void executeSecondaryCommandBuffers(const std::vector<std::shared_ptr<CommandBuffer>>& secondaryCmdBuffers);
+
     /**
      * @param vertexBuffer to bind as vertex buffer usage
      */
@@ -81,6 +140,16 @@ class CommandBuffer : private NonCopyable
     // layout informations
     void bindResourceGroup(SetSlotCategory setSlotCategory, std::vector<ShaderVariableBinding>&& bindGroup);
 
+    // Bind resources into the slots resolved from the pipeline. Descriptor set of each binding is given by its slot
+    void bindResourceSlots(std::span<const ShaderSlotBinding> bindings);
+
+    /**
+     * Update push constants of the bound pipeline with all stages of its push constant range
+     * @param offset byte offset in the push constant block. Must be a multiple of 4
+     * @param size byte size of the given data. Must be a multiple of 4
+     */
+    void pushConstants(const uint32_t offset, const uint32_t size, const void* data);
+
     // Commit pending resource bindings to command buffer
     void commitPendingResourceBindings();
 
@@ -89,6 +158,12 @@ class CommandBuffer : private NonCopyable
         return _fenceToSignal;
     }
 
+    // Statistics of state commands since the command buffer began
+    [[nodiscard]] inline const StateCommandStats& getStateCommandStats() const
+    {
+        return _stateCommandStats;
+    }
+
     void uploadBuffer(Buffer* dstBuffer, StagingBuffer* srcBuffer, const uint32_t dstOffset, const uint32_t srcOffset, const uint32_t size);
 
     void uploadTexture(Texture* dstTexture, StagingBuffer* srcBuffer, const uint32_t dstOffset, const uint32_t srcOffset, const uint32_t size);
@@ -103,22 +178,107 @@ class CommandBuffer : private NonCopyable
 
     void addExecutionBarrier(VkPipelineStageFlags prevStages, VkPipelineStageFlags nextStages);
 
+    /**
+     * Release ownership of the given texture or buffer from the queue family of this command buffer.
+     * Must be paired with acquireQueueOwnership recorded on the destination queue family.
+     * @param view texture or buffer view whose ownership is transferred
+     * @param srcQueueFamilyIndex queue family index of this command buffer
+     * @param dstQueueFamilyIndex queue family index which acquires ownership
+     */
+    void releaseQueueOwnership(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex);
+
+    /**
+     * Acquire ownership of the given texture or buffer released by the other queue family.
+     * @param view texture or buffer view whose ownership is transferred
+     * @param srcQueueFamilyIndex queue family index which released ownership
+     * @param dstQueueFamilyIndex queue family index of this command buffer
+     */
+    void acquireQueueOwnership(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex);
+
+    /**
+     * Add barrier planned ahead by frame graph. Barrier of the same access requested
+     * while recording the pass is skipped afterward.
+     */
+    void addPlannedMemoryBarrier(ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStages);
+
+    /**
+     * Record barrier which waits for every previous access to the memory aliased by the given view, and discard its content
+     */
+    void addAliasingBarrier(ResourceView* view);
+
+    // Record signal half of the split barrier right after the producer of the texture or buffer
+    void signalSplitBarrier(SplitBarrier* splitBarrier, ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStages);
+
+    // Add wait half of the split barrier which is recorded at the next barrier commit
+    void waitSplitBarrier(SplitBarrier* splitBarrier);
+
+    // Record all pending barriers in a batch
+    void commitPendingBarriers();
+
+ private:
+    // Clear states of the previous recording as command buffer is reused after its pool is reset
+    void resetRecordingStates(const FenceObject& fenceToSignal, const std::string& debugName);
+
+    // Resolve variable names bound by bindResourceGroup into slots of the bound pipeline
+    void resolvePendingVariableBindings();
+
+    // Write bound views into descriptor set. Entries of the binding key are in the same order as bindings
+    void writeDescriptorSet(VkDescriptorSet vkDescriptorSet, const DescriptorSetBindingKey& bindingKey, const std::vector<ShaderSlotBinding>& bindGroup);
+
+    // Count state command and return whether it must be emitted
+    inline bool filterStateCommand(StateCommandType commandType, const bool isRedundant)
+    {
+        const uint32_t commandIndex = static_cast<uint32_t>(commandType);
+        if (isRedundant)
+        {
+            ++_stateCommandStats._numSkipped[commandIndex];
+            return false;
+        }
+        ++_stateCommandStats._numEmitted[commandIndex];
+        return true;
+    }
+
+    // Add release or acquire half of queue family ownership transfer according to the type of given view
+    void addQueueOwnershipTransfer(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex, const bool isRelease);
+
  private:
     LogicalDevice* _logicalDevice = nullptr;
     RenderPass* _boundRenderPass = nullptr;
+    VkFramebuffer _boundFrameBuffer = VK_NULL_HANDLE;
     BasePipeline* _boundPipeline = nullptr;
     RenderTargetsInfo _boundRenderTargetsInfo;
     FenceObject _fenceToSignal = FenceObject::Default();
     VkCommandBuffer _vkCommandBuffer = VK_NULL_HANDLE;
-    std::array<std::vector<ShaderVariableBinding>, MAX_NUM_SET_SLOTS> _pendingResourceBindings;
+    std::array<std::vector<ShaderSlotBinding>, MAX_NUM_SET_SLOTS> _pendingResourceBindings;
+    // Bound by variable name, and resolved into _pendingResourceBindings right before committing them
+    std::array<std::vector<ShaderVariableBinding>, MAX_NUM_SET_SLOTS> _pendingVariableBindings;
     std::string _debugName;
     bool _hasBegun = false;
 
     // TODO(snowapril) : temporary member variable
     class Sampler* _sampler = nullptr;
 
+    // States set into the vulkan command buffer so far, which redundant state commands are compared against
+    struct ShadowState
+    {
+        VkPipeline _pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
+        VkBuffer _vertexBuffer = VK_NULL_HANDLE;
+        VkBuffer _indexBuffer = VK_NULL_HANDLE;
+        glm::uvec2 _viewportSize = glm::uvec2(0U, 0U);
+        bool _hasViewport = false;
+        std::array<VkDescriptorSet, MAX_NUM_SET_SLOTS> _descriptorSets{};
+    };
+
+    ShadowState _shadowState;
+    StateCommandStats _stateCommandStats;
+
     ResourceBarrierManager _resourceBarrierManager;
     bool _isInRenderPassScope = false;
+    // Secondary command buffer only accesses resources already transited by the primary one before its render pass
+    bool _isSecondary = false;
+    uint32_t _currentSubpassIndex = 0;
+    uint32_t _numSubpasses = 1;
 };
 }  // namespace VoxFlow
 
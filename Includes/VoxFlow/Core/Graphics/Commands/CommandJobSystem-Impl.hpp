@@ -5,102 +5,36 @@
 
 #include <VoxFlow/Core/Graphics/Commands/CommandBuffer.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandPacket.hpp>
 #include <VoxFlow/Core/Graphics/Pipelines/ResourceBindingLayout.hpp>
-#include <type_traits>
+#include <VoxFlow/Core/Utils/Logger.hpp>
 
 namespace VoxFlow
 {
-
-template <typename...>
-struct CommandParameterIndex;
-
-template <typename T, typename... R>
-struct CommandParameterIndex<T, T, R...> : std::integral_constant<size_t, 0>
-{
-};
-
-template <typename T, typename F, typename... R>
-struct CommandParameterIndex<T, F, R...> : std::integral_constant<size_t, 1 + CommandParameterIndex<T, R...>::value>
-{
-};
-
-class CommandParameterPacker
+inline CommandPacketBuffer* CommandStream::getOrRegisterPacketBuffer()
 {
- public:
-    template <typename... ParamTypes>
-    CommandParameterPacker(ParamTypes&&... params) : _params{ static_cast<void*>(&params)... }
+    const uint32_t workerIndex = Thread::GetWorkerIndex();
+    if (CommandPacketBuffer* packetBuffer = _packetBufferSlots[workerIndex].load(std::memory_order_acquire))
     {
+        return packetBuffer;
     }
+    return registerPacketBuffer(workerIndex);
+}
 
-    template <typename ParamType>
-    ParamType getParam(const uint32_t index)
-    {
-        return *(static_cast<ParamType*>(_params[index]));
-    }
-
- private:
-    std::vector<void*> _params;
-};
-
-template <typename... CommandJobArgs>
-void CommandStream::addJob(CommandJobType jobType, CommandJobArgs&&... args)
+template <CommandJobType JobType, typename... CommandJobArgs>
+void CommandStream::addJob(CommandJobArgs&&... args)
 {
-    CommandBuffer* cmdBuffer = getOrAllocateCommandBuffer();
-
-    CommandParameterPacker params(std::forward<CommandJobArgs>(args)...);
-
-    switch (jobType)
-    {
-        case CommandJobType::BeginRenderPass:
-            cmdBuffer->beginRenderPass(params.getParam<AttachmentGroup>(0), params.getParam<RenderPassParams>(1));
-            break;
-        case CommandJobType::EndRenderPass:
-            cmdBuffer->endRenderPass();
-            break;
-        case CommandJobType::BindPipeline:
-            cmdBuffer->bindPipeline(params.getParam<BasePipeline*>(0));
-            break;
-
-        case CommandJobType::SetViewport:
-            cmdBuffer->setViewport(params.getParam<glm::uvec2>(0));
-            break;
-
-        case CommandJobType::BindResourceGroup:
-            cmdBuffer->bindResourceGroup(params.getParam<SetSlotCategory>(0), params.getParam<std::vector<ShaderVariableBinding>>(1));
-            break;
-
-        case CommandJobType::UploadBuffer:
-            cmdBuffer->uploadBuffer(params.getParam<Buffer*>(0), params.getParam<StagingBuffer*>(1), params.getParam<uint32_t>(2), params.getParam<uint32_t>(3),
-                                    params.getParam<uint32_t>(4));
-            break;
-
-        case CommandJobType::UploadTexture:
-            cmdBuffer->uploadTexture(params.getParam<Texture*>(0), params.getParam<StagingBuffer*>(1), params.getParam<uint32_t>(2),
-                                     params.getParam<uint32_t>(3), params.getParam<uint32_t>(4));
-            break;
-
-        case CommandJobType::Draw:
-            cmdBuffer->draw(params.getParam<uint32_t>(0), params.getParam<uint32_t>(1), params.getParam<uint32_t>(2), params.getParam<uint32_t>(3));
-            break;
-
-        case CommandJobType::DrawIndexed:
-            cmdBuffer->drawIndexed(params.getParam<uint32_t>(0), params.getParam<uint32_t>(1), params.getParam<uint32_t>(2), params.getParam<uint32_t>(3),
-                                   params.getParam<uint32_t>(4));
-            break;
-
-        case CommandJobType::MakeSwapChainFinalLayout:
-            cmdBuffer->makeSwapChainFinalLayout(params.getParam<SwapChain*>(0), params.getParam<uint32_t>(1));
-            break;
+    recordCommandPacket<JobType>(getOrRegisterPacketBuffer(), std::forward<CommandJobArgs>(args)...);
+}
 
-        case CommandJobType::BindVertexBuffer:
-            cmdBuffer->bindVertexBuffer(params.getParam<Buffer*>(0));
-            break;
+template <CommandJobType JobType, typename... CommandJobArgs>
+void SecondaryCommandGroup::addJob(const uint32_t chunkIndex, CommandJobArgs&&... args)
+{
+    static_assert(isSecondaryCommandJob(JobType), "Job must be recordable inside render pass of the primary command buffer");
 
-        case CommandJobType::BindIndexBuffer:
-            cmdBuffer->bindIndexBuffer(params.getParam<Buffer*>(0));
-            break;
-    }
+    VOX_ASSERT(chunkIndex < _numChunks, "Chunk index({}) exceeds the number of chunks({})", chunkIndex, _numChunks);
+    recordCommandPacket<JobType>(_chunkPacketBuffers[chunkIndex].get(), std::forward<CommandJobArgs>(args)...);
 }
 }  // namespace VoxFlow
 
-#endif
\ No newline at end of file
+#endif
@@ -4,15 +4,26 @@
 #define VOXEL_FLOW_COMMAND_JOB_SYSTEM_HPP
 
 #include <volk/volk.h>
+#include <VoxFlow/Core/Graphics/Commands/CommandBuffer.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandConfig.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandPacket.hpp>
 #include <VoxFlow/Core/Utils/FenceObject.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <VoxFlow/Core/Utils/Thread.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <unordered_map>
+#include <vector>
+
+namespace tf
+{
+class Executor;
+}
 
 namespace VoxFlow
 {
@@ -22,46 +33,196 @@ class CommandBuffer;
 class SwapChain;
 class CommandPool;
 class Queue;
+struct SplitBarrier;
 
-enum class CommandJobType
+// Statistics of packets translated into vulkan commands since the last reset
+struct CommandStreamStats
 {
-    BeginRenderPass,
-    EndRenderPass,
-    BindPipeline,
-    SetViewport,
-    BindResourceGroup,
-    UploadBuffer,
-    UploadTexture,
-    Draw,
-    DrawIndexed,
-    MakeSwapChainFinalLayout,
-    BindVertexBuffer,
-    BindIndexBuffer
+    uint64_t _numTranslatedPackets = 0;
+    uint64_t _numTranslatedBytes = 0;
+    uint32_t _numTranslatedCommandBuffers = 0;
+    // Command buffers newly allocated by translation. Stays zero in steady state as pools are reused
+    uint32_t _numAllocatedCommandBuffers = 0;
+    std::chrono::nanoseconds _translationTime{ 0 };
+    // State commands emitted into or dropped as redundant by the translated command buffers
+    StateCommandStats _stateCommandStats;
+
+    inline CommandStreamStats& operator+=(const CommandStreamStats& rhs)
+    {
+        _numTranslatedPackets += rhs._numTranslatedPackets;
+        _numTranslatedBytes += rhs._numTranslatedBytes;
+        _numTranslatedCommandBuffers += rhs._numTranslatedCommandBuffers;
+        _numAllocatedCommandBuffers += rhs._numAllocatedCommandBuffers;
+        _translationTime += rhs._translationTime;
+        _stateCommandStats += rhs._stateCommandStats;
+        return *this;
+    }
 };
 
-class CommandStream final : private NonCopyable
+/**
+ * Draws of a render pass recorded by multiple threads. Each chunk is recorded by a single thread and translated into
+ * its own secondary command buffer which inherits render pass and frame buffer of the primary one executing it.
+ * Chunks are executed in order of their indices regardless of the order they were recorded in.
+ */
+class SecondaryCommandGroup final : private NonCopyable
 {
  public:
-    using CommandPoolStorage = std::unordered_map<std::thread::id, std::unique_ptr<CommandPool>>;
-    using CommandBufferStorage = std::unordered_map<std::thread::id, std::shared_ptr<CommandBuffer>>;
+    SecondaryCommandGroup() = default;
+    ~SecondaryCommandGroup() = default;
+
+    /**
+     * Record job into the given chunk. Only jobs recordable inside render pass are allowed, and states such as
+     * pipeline are not inherited from the primary command buffer nor the other chunks.
+     */
+    template <CommandJobType JobType, typename... CommandJobArgs>
+    void addJob(const uint32_t chunkIndex, CommandJobArgs&&... args);
+
+    [[nodiscard]] inline uint32_t getNumChunks() const
+    {
+        return _numChunks;
+    }
+
+ private:
+    friend class CommandStream;
 
+    // Resize to the given number of chunks while keeping memory blocks of packet buffers
+    void reset(const uint32_t numChunks);
+
+ private:
+    std::vector<std::unique_ptr<CommandPacketBuffer>> _chunkPacketBuffers;
+    std::vector<std::shared_ptr<CommandBuffer>> _secondaryCmdBuffers;
+    uint32_t _numChunks = 0;
+};
+
+/**
+ * Jobs are recorded as command packets into linear memory of the recording thread without lock,
+ * and translated into vulkan commands when the stream is sealed or flushed.
+ * Packet buffers and command pools are found by worker index of the calling thread.
+ */
+class CommandStream final : private NonCopyable
+{
  public:
     explicit CommandStream(LogicalDevice* logicalDevice, Queue* queue);
     ~CommandStream();
 
     FenceObject flush(SwapChain* swapChain, const FrameContext* frameContext, const bool waitAllCompletion);
 
-    template <typename... CommandJobArgs>
-    void addJob(CommandJobType jobType, CommandJobArgs&&... args);
+    /**
+     * Submit commands recorded so far without presenting, ahead of the flush which presents the given swapchain.
+     * Whichever submission of the frame comes first waits for back buffer acquisition, as any of them may touch it.
+     */
+    FenceObject flushBeforePresent(SwapChain* swapChain, const FrameContext* frameContext);
+
+    /**
+     * Translate packets recorded so far by every thread into command buffers and keep them until the next flush.
+     * Jobs added after sealing are translated into new command buffers which are submitted after the sealed ones.
+     * Must not be called while other threads add jobs to this stream.
+     */
+    void sealCommandBuffers();
+
+    /**
+     * Move on to the command pools of the next frame in flight. Waits until command buffers allocated
+     * from them in the previous round complete, and resets the pools so that the command buffers are reused.
+     * Every sealed command buffer must be flushed before. Must not be called while other threads add jobs.
+     */
+    void beginFrame();
+
+    /**
+     * Make the next flush of this stream wait for the given fence of the other queue.
+     * @param fenceToWait fence returned by flushing command stream of the other queue
+     */
+    void addWaitFence(const FenceObject& fenceToWait);
+
+    [[nodiscard]] inline Queue* getQueue() const
+    {
+        return _queue;
+    }
+
+    /**
+     * Create split barrier events of this stream up to the given number. Must not be called while
+     * other threads add jobs to this stream.
+     * @param numSplitBarriers number of split barriers used by the frame
+     */
+    void prepareSplitBarriers(const uint32_t numSplitBarriers);
+
+    [[nodiscard]] inline SplitBarrier* getSplitBarrier(const uint32_t index) const
+    {
+        return _splitBarriers[index].get();
+    }
+
+    /**
+     * Record job as command packet into the linear memory of the calling thread. Never locks nor
+     * allocates once the packet buffer of the thread has grown to the size of a frame.
+     */
+    template <CommandJobType JobType, typename... CommandJobArgs>
+    void addJob(CommandJobArgs&&... args);
+
+    /**
+     * Acquire group of chunks recorded by multiple threads and executed by ExecuteSecondaryCommands job.
+     * The job must be recorded inside render pass which begins with secondary command buffer contents.
+     * Group is returned to this stream once translated.
+     * @param numChunks number of secondary command buffers the draws are split into
+     */
+    SecondaryCommandGroup* acquireSecondaryCommandGroup(const uint32_t numChunks);
+
+    /**
+     * Translate chunks of secondary command groups in parallel on the given executor. Translation falls back to
+     * the calling thread when the executor is null or the stream is sealed by one of its workers.
+     */
+    void setTranslationExecutor(tf::Executor* translationExecutor);
+
+    // Statistics accumulated since the last reset, including the current frame
+    [[nodiscard]] CommandStreamStats getStats() const;
+
+    // Statistics of the frame which ended at the last beginFrame
+    [[nodiscard]] CommandStreamStats getLastFrameStats() const;
+
+    void resetStats();
 
  private:
-    CommandBuffer* getOrAllocateCommandBuffer();
+    // Find packet buffer of the calling thread from the worker slot or register new one
+    inline CommandPacketBuffer* getOrRegisterPacketBuffer();
+    CommandPacketBuffer* registerPacketBuffer(const uint32_t workerIndex);
+
+    // Translate packets of every thread into command buffers. _streamMutex must be locked
+    void translatePendingPackets();
+    void translatePackets(const CommandPacketBuffer& packetBuffer, CommandBuffer* cmdBuffer);
+    // Translate chunks into secondary command buffers and execute them from the given primary one
+    void translateSecondaryCommandGroup(SecondaryCommandGroup* secondaryCmdGroup, CommandBuffer* primaryCmdBuffer);
+
+    // _streamMutex must be locked by the calling thread or the one waiting for its translation
     CommandPool* getOrAllocateCommandPool();
 
+    FenceObject submitPendingCommandBuffers(SwapChain* swapChain, const FrameContext* frameContext, const bool signalPresentReady,
+                                            const bool waitAllCompletion);
+
  private:
-    std::recursive_mutex _streamMutex;
-    CommandPoolStorage _cmdPoolStorage;
-    CommandBufferStorage _cmdBufferStorage;
+    mutable std::mutex _streamMutex;
+    // Written once per worker under _streamMutex, read by the recording thread without lock
+    std::array<std::atomic<CommandPacketBuffer*>, Thread::MAX_NUM_WORKER_THREADS> _packetBufferSlots{};
+    std::vector<std::unique_ptr<CommandPacketBuffer>> _packetBuffers;
+    // Command pools of a frame in flight indexed by worker index of the translating thread
+    struct FrameCommandPools
+    {
+        std::array<std::unique_ptr<CommandPool>, Thread::MAX_NUM_WORKER_THREADS> _cmdPoolSlots;
+        // Signaled once every command buffer allocated from the pools completes
+        uint64_t _lastFenceValue = 0;
+    };
+
+    std::array<FrameCommandPools, FRAME_BUFFER_COUNT> _frameCmdPools;
+    uint32_t _currentFrameIndex = 0;
+    std::vector<std::shared_ptr<CommandBuffer>> _sealedCmdBuffers;
+    std::vector<FenceObject> _pendingWaitFences;
+    // Back buffer acquisition is waited once per frame by the first submission with swapchain
+    bool _isBackBufferReadyWaited = false;
+    std::vector<std::unique_ptr<SplitBarrier>> _splitBarriers;
+    std::vector<std::unique_ptr<SecondaryCommandGroup>> _secondaryCmdGroups;
+    std::vector<SecondaryCommandGroup*> _freeSecondaryCmdGroups;
+    tf::Executor* _translationExecutor = nullptr;
+    // Translation of the current frame is accumulated into _frameStats, and moved to the others at beginFrame
+    CommandStreamStats _stats;
+    CommandStreamStats _frameStats;
+    CommandStreamStats _lastFrameStats;
     LogicalDevice* _logicalDevice = nullptr;
     Queue* _queue = nullptr;
 };
@@ -79,6 +240,9 @@ class CommandJobSystem final : private NonCopyable
     void createCommandStream(const CommandStreamKey& streamKey, Queue* queue);
     CommandStream* getCommandStream(const CommandStreamKey& streamKey);
 
+    // Begin new frame of every command stream. See CommandStream::beginFrame
+    void beginFrame();
+
  private:
     void processJob();
 
@@ -0,0 +1,496 @@
+// Author : snowapril
+
+#ifndef VOXEL_FLOW_COMMAND_PACKET_HPP
+#define VOXEL_FLOW_COMMAND_PACKET_HPP
+
+#include <volk/volk.h>
+#include <VoxFlow/Core/Graphics/Descriptors/DescriptorSet.hpp>
+#include <VoxFlow/Core/Utils/NonCopyable.hpp>
+#include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <cstddef>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace VoxFlow
+{
+class Buffer;
+class Texture;
+class StagingBuffer;
+class SwapChain;
+class BasePipeline;
+class ResourceView;
+class AttachmentGroup;
+class CommandPacketBuffer;
+class SecondaryCommandGroup;
+struct RenderPassParams;
+struct ShaderVariableBinding;
+struct ShaderSlotBinding;
+struct SplitBarrier;
+
+enum class CommandJobType : uint32_t
+{
+    BeginRenderPass,
+    EndRenderPass,
+    BindPipeline,
+    SetViewport,
+    BindResourceGroup,
+    BindResourceSlots,
+    PushConstants,
+    UploadBuffer,
+    UploadTexture,
+    Draw,
+    DrawIndexed,
+    MakeSwapChainFinalLayout,
+    BindVertexBuffer,
+    BindIndexBuffer,
+    ReleaseQueueOwnership,
+    AcquireQueueOwnership,
+    AddPlannedBarrier,
+    AddAliasingBarrier,
+    SignalSplitBarrier,
+    WaitSplitBarrier,
+    CommitPendingBarriers,
+    ExecuteSecondaryCommands
+};
+
+// Jobs which can be recorded into secondary command buffer inheriting the render pass of the primary one
+constexpr bool isSecondaryCommandJob(const CommandJobType jobType)
+{
+    switch (jobType)
+    {
+        case CommandJobType::BindPipeline:
+        case CommandJobType::SetViewport:
+        case CommandJobType::BindResourceGroup:
+        case CommandJobType::BindResourceSlots:
+        case CommandJobType::PushConstants:
+        case CommandJobType::Draw:
+        case CommandJobType::DrawIndexed:
+        case CommandJobType::BindVertexBuffer:
+        case CommandJobType::BindIndexBuffer:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Header of command packet recorded in CommandPacketBuffer. Payload of the job type follows the header,
+ * and packet size includes both of them so that packets can be walked without knowing payload types.
+ */
+struct CommandPacketHeader
+{
+    CommandJobType _jobType;
+    uint32_t _packetSize;
+};
+
+struct EmptyPacket
+{
+};
+
+/**
+ * Attachment group and render pass parameters are referenced, not copied. They are kept in
+ * frame graph render pass data which outlives translation of the packet.
+ */
+struct BeginRenderPassPacket
+{
+    BeginRenderPassPacket(const AttachmentGroup& attachmentGroup, const RenderPassParams& passParams)
+        : _attachmentGroup(&attachmentGroup), _passParams(&passParams)
+    {
+    }
+
+    const AttachmentGroup* _attachmentGroup;
+    const RenderPassParams* _passParams;
+};
+
+struct BindPipelinePacket
+{
+    BindPipelinePacket(BasePipeline* pipeline) : _pipeline(pipeline)
+    {
+    }
+
+    BasePipeline* _pipeline;
+};
+
+struct SetViewportPacket
+{
+    SetViewportPacket(const glm::uvec2& viewportSize) : _viewportSize(viewportSize)
+    {
+    }
+
+    glm::uvec2 _viewportSize;
+};
+
+/**
+ * Variable sized packet. Bindings follow this payload and variable names of them are packed right after.
+ */
+struct BindResourceGroupPacket
+{
+    struct Binding
+    {
+        ResourceView* _view;
+        ResourceAccessMask _usage;
+        uint32_t _variableNameLength;
+    };
+
+    SetSlotCategory _setSlotCategory;
+    uint32_t _numBindings;
+
+    static void record(CommandPacketBuffer* packetBuffer, SetSlotCategory setSlotCategory, const std::vector<ShaderVariableBinding>& bindGroup);
+
+    [[nodiscard]] std::vector<ShaderVariableBinding> unpackBindGroup() const;
+};
+
+/**
+ * Variable sized packet. Bindings to resolved slots are copied right after this payload,
+ * so that they are translated without any allocation nor variable name lookup.
+ */
+struct alignas(alignof(void*)) BindResourceSlotsPacket
+{
+    uint32_t _numBindings;
+
+    static void record(CommandPacketBuffer* packetBuffer, std::span<const ShaderSlotBinding> bindings);
+
+    [[nodiscard]] std::span<const ShaderSlotBinding> getBindings() const;
+};
+
+/**
+ * Variable sized packet. Constant data is copied right after this payload.
+ */
+struct PushConstantsPacket
+{
+    uint32_t _offset;
+    uint32_t _size;
+
+    static void record(CommandPacketBuffer* packetBuffer, const uint32_t offset, const void* data, const uint32_t size);
+
+    // Record constants of trivially copyable type placed at the given offset of push constant block
+    template <typename ConstantType>
+    static void record(CommandPacketBuffer* packetBuffer, const uint32_t offset, const ConstantType& constants)
+    {
+        static_assert(std::is_trivially_copyable_v<ConstantType> && (std::is_pointer_v<ConstantType> == false),
+                      "Push constants are copied into packet as they are");
+        record(packetBuffer, offset, &constants, static_cast<uint32_t>(sizeof(ConstantType)));
+    }
+
+    [[nodiscard]] inline const void* getData() const
+    {
+        return reinterpret_cast<const std::byte*>(this) + sizeof(PushConstantsPacket);
+    }
+};
+
+struct UploadPacket
+{
+    UploadPacket(Buffer* dstBuffer, StagingBuffer* srcBuffer, const uint32_t dstOffset, const uint32_t srcOffset, const uint32_t size)
+        : _dstBuffer(dstBuffer), _srcBuffer(srcBuffer), _dstOffset(dstOffset), _srcOffset(srcOffset), _size(size)
+    {
+    }
+    UploadPacket(Texture* dstTexture, StagingBuffer* srcBuffer, const uint32_t dstOffset, const uint32_t srcOffset, const uint32_t size)
+        : _dstTexture(dstTexture), _srcBuffer(srcBuffer), _dstOffset(dstOffset), _srcOffset(srcOffset), _size(size)
+    {
+    }
+
+    union
+    {
+        Buffer* _dstBuffer;
+        Texture* _dstTexture;
+    };
+    StagingBuffer* _srcBuffer;
+    uint32_t _dstOffset;
+    uint32_t _srcOffset;
+    uint32_t _size;
+};
+
+struct DrawPacket
+{
+    DrawPacket(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t firstVertex, const uint32_t firstInstance)
+        : _vertexCount(vertexCount), _instanceCount(instanceCount), _firstVertex(firstVertex), _firstInstance(firstInstance)
+    {
+    }
+
+    uint32_t _vertexCount;
+    uint32_t _instanceCount;
+    uint32_t _firstVertex;
+    uint32_t _firstInstance;
+};
+
+struct DrawIndexedPacket
+{
+    DrawIndexedPacket(const uint32_t indexCount, const uint32_t instanceCount, const uint32_t firstIndex, const int32_t vertexOffset,
+                      const uint32_t firstInstance)
+        : _indexCount(indexCount), _instanceCount(instanceCount), _firstIndex(firstIndex), _vertexOffset(vertexOffset), _firstInstance(firstInstance)
+    {
+    }
+
+    uint32_t _indexCount;
+    uint32_t _instanceCount;
+    uint32_t _firstIndex;
+    int32_t _vertexOffset;
+    uint32_t _firstInstance;
+};
+
+struct MakeSwapChainFinalLayoutPacket
+{
+    MakeSwapChainFinalLayoutPacket(SwapChain* swapChain, const uint32_t backBufferIndex) : _swapChain(swapChain), _backBufferIndex(backBufferIndex)
+    {
+    }
+
+    SwapChain* _swapChain;
+    uint32_t _backBufferIndex;
+};
+
+struct BindBufferPacket
+{
+    BindBufferPacket(Buffer* buffer) : _buffer(buffer)
+    {
+    }
+
+    Buffer* _buffer;
+};
+
+struct QueueOwnershipPacket
+{
+    QueueOwnershipPacket(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex)
+        : _view(view), _srcQueueFamilyIndex(srcQueueFamilyIndex), _dstQueueFamilyIndex(dstQueueFamilyIndex)
+    {
+    }
+
+    ResourceView* _view;
+    uint32_t _srcQueueFamilyIndex;
+    uint32_t _dstQueueFamilyIndex;
+};
+
+struct PlannedBarrierPacket
+{
+    PlannedBarrierPacket(ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStages)
+        : _view(view), _accessMask(accessMask), _nextStages(nextStages)
+    {
+    }
+
+    ResourceView* _view;
+    ResourceAccessMask _accessMask;
+    VkPipelineStageFlags _nextStages;
+};
+
+struct AliasingBarrierPacket
+{
+    explicit AliasingBarrierPacket(ResourceView* view) : _view(view)
+    {
+    }
+
+    ResourceView* _view;
+};
+
+struct SignalSplitBarrierPacket
+{
+    SignalSplitBarrierPacket(SplitBarrier* splitBarrier, ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStages)
+        : _splitBarrier(splitBarrier), _view(view), _accessMask(accessMask), _nextStages(nextStages)
+    {
+    }
+
+    SplitBarrier* _splitBarrier;
+    ResourceView* _view;
+    ResourceAccessMask _accessMask;
+    VkPipelineStageFlags _nextStages;
+};
+
+struct WaitSplitBarrierPacket
+{
+    WaitSplitBarrierPacket(SplitBarrier* splitBarrier) : _splitBarrier(splitBarrier)
+    {
+    }
+
+    SplitBarrier* _splitBarrier;
+};
+
+/**
+ * Secondary command group is owned by the command stream and returned to it once translated.
+ */
+struct ExecuteSecondaryCommandsPacket
+{
+    ExecuteSecondaryCommandsPacket(SecondaryCommandGroup* secondaryCmdGroup) : _secondaryCmdGroup(secondaryCmdGroup)
+    {
+    }
+
+    SecondaryCommandGroup* _secondaryCmdGroup;
+};
+
+template <CommandJobType JobType>
+struct CommandPacketTraits;
+
+#define DECLARE_COMMAND_PACKET_TYPE(jobType, packetType)       \
+    template <>                                                \
+    struct CommandPacketTraits<CommandJobType::jobType>        \
+    {                                                          \
+        using PacketType = packetType;                         \
+    };
+
+DECLARE_COMMAND_PACKET_TYPE(BeginRenderPass, BeginRenderPassPacket)
+DECLARE_COMMAND_PACKET_TYPE(EndRenderPass, EmptyPacket)
+DECLARE_COMMAND_PACKET_TYPE(BindPipeline, BindPipelinePacket)
+DECLARE_COMMAND_PACKET_TYPE(SetViewport, SetViewportPacket)
+DECLARE_COMMAND_PACKET_TYPE(BindResourceGroup, BindResourceGroupPacket)
+DECLARE_COMMAND_PACKET_TYPE(BindResourceSlots, BindResourceSlotsPacket)
+DECLARE_COMMAND_PACKET_TYPE(PushConstants, PushConstantsPacket)
+DECLARE_COMMAND_PACKET_TYPE(UploadBuffer, UploadPacket)
+DECLARE_COMMAND_PACKET_TYPE(UploadTexture, UploadPacket)
+DECLARE_COMMAND_PACKET_TYPE(Draw, DrawPacket)
+DECLARE_COMMAND_PACKET_TYPE(DrawIndexed, DrawIndexedPacket)
+DECLARE_COMMAND_PACKET_TYPE(MakeSwapChainFinalLayout, MakeSwapChainFinalLayoutPacket)
+DECLARE_COMMAND_PACKET_TYPE(BindVertexBuffer, BindBufferPacket)
+DECLARE_COMMAND_PACKET_TYPE(BindIndexBuffer, BindBufferPacket)
+DECLARE_COMMAND_PACKET_TYPE(ReleaseQueueOwnership, QueueOwnershipPacket)
+DECLARE_COMMAND_PACKET_TYPE(AcquireQueueOwnership, QueueOwnershipPacket)
+DECLARE_COMMAND_PACKET_TYPE(AddPlannedBarrier, PlannedBarrierPacket)
+DECLARE_COMMAND_PACKET_TYPE(AddAliasingBarrier, AliasingBarrierPacket)
+DECLARE_COMMAND_PACKET_TYPE(SignalSplitBarrier, SignalSplitBarrierPacket)
+DECLARE_COMMAND_PACKET_TYPE(WaitSplitBarrier, WaitSplitBarrierPacket)
+DECLARE_COMMAND_PACKET_TYPE(CommitPendingBarriers, EmptyPacket)
+DECLARE_COMMAND_PACKET_TYPE(ExecuteSecondaryCommands, ExecuteSecondaryCommandsPacket)
+
+#undef DECLARE_COMMAND_PACKET_TYPE
+
+/**
+ * Linear memory where a single thread records command packets. Memory blocks are kept across reset,
+ * so that recording allocates nothing once the buffer has grown to the size of a frame.
+ * Not thread-safe. Packets are translated into vulkan commands after recording is done.
+ * Aligned to cache line so that buffers of different recording threads never share one.
+ */
+class alignas(64) CommandPacketBuffer : private NonCopyable
+{
+ public:
+    static constexpr uint32_t BLOCK_SIZE = 64 * 1024;
+    static constexpr uint32_t PACKET_ALIGNMENT = alignof(uint64_t);
+
+ public:
+    CommandPacketBuffer() = default;
+    ~CommandPacketBuffer() = default;
+
+    /**
+     * Allocate packet of the given job type
+     * @param payloadSize size of payload following packet header
+     * @return payload memory aligned to PACKET_ALIGNMENT
+     */
+    inline void* allocatePacket(CommandJobType jobType, const uint32_t payloadSize)
+    {
+        const uint32_t packetSize = (static_cast<uint32_t>(sizeof(CommandPacketHeader)) + payloadSize + PACKET_ALIGNMENT - 1) & ~(PACKET_ALIGNMENT - 1);
+        if (_blocks.empty() || (_blocks[_currentBlockIndex]._usedBytes + packetSize > BLOCK_SIZE))
+        {
+            advanceBlock(packetSize);
+        }
+
+        Block& block = _blocks[_currentBlockIndex];
+        std::byte* packet = block._memory.get() + block._usedBytes;
+        block._usedBytes += packetSize;
+        ++_numPackets;
+        _numBytes += packetSize;
+
+        new (packet) CommandPacketHeader{ jobType, packetSize };
+        return packet + sizeof(CommandPacketHeader);
+    }
+
+    template <typename PacketType, typename... PacketArgs>
+    inline void emplacePacket(CommandJobType jobType, PacketArgs&&... args)
+    {
+        static_assert(std::is_trivially_copyable_v<PacketType> && std::is_trivially_destructible_v<PacketType>, "Command packet must be POD");
+        static_assert(alignof(PacketType) <= PACKET_ALIGNMENT, "Command packet is over-aligned");
+
+        if constexpr (std::is_empty_v<PacketType>)
+        {
+            allocatePacket(jobType, 0);
+        }
+        else
+        {
+            new (allocatePacket(jobType, sizeof(PacketType))) PacketType(std::forward<PacketArgs>(args)...);
+        }
+    }
+
+    /**
+     * Visit recorded packets in order of recording
+     * @param visitor callable of (CommandJobType jobType, const void* payload)
+     */
+    template <typename Visitor>
+    void forEachPacket(Visitor&& visitor) const
+    {
+        for (uint32_t blockIndex = 0; blockIndex < _blocks.size() && blockIndex <= _currentBlockIndex; ++blockIndex)
+        {
+            const Block& block = _blocks[blockIndex];
+            for (uint32_t offset = 0; offset < block._usedBytes;)
+            {
+                const std::byte* packet = block._memory.get() + offset;
+                const CommandPacketHeader* header = reinterpret_cast<const CommandPacketHeader*>(packet);
+                visitor(header->_jobType, static_cast<const void*>(packet + sizeof(CommandPacketHeader)));
+                offset += header->_packetSize;
+            }
+        }
+    }
+
+    // Discard recorded packets while keeping memory blocks
+    void reset();
+
+    [[nodiscard]] inline bool empty() const
+    {
+        return _numPackets == 0;
+    }
+
+    [[nodiscard]] inline uint32_t getNumPackets() const
+    {
+        return _numPackets;
+    }
+
+    [[nodiscard]] inline uint64_t getNumBytes() const
+    {
+        return _numBytes;
+    }
+
+ private:
+    // Move to the next block which can hold packet of the given size. Allocate new one if there is no retained block.
+    void advanceBlock(const uint32_t packetSize);
+
+ private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> _memory;
+        uint32_t _usedBytes = 0;
+    };
+
+    std::vector<Block> _blocks;
+    uint32_t _currentBlockIndex = 0;
+    uint32_t _numPackets = 0;
+    uint64_t _numBytes = 0;
+};
+
+static_assert(sizeof(CommandPacketHeader) % CommandPacketBuffer::PACKET_ALIGNMENT == 0, "Payload following packet header must be aligned");
+
+// Record job as command packet into the given packet buffer
+template <CommandJobType JobType, typename... CommandJobArgs>
+inline void recordCommandPacket(CommandPacketBuffer* packetBuffer, CommandJobArgs&&... args)
+{
+    static_assert((JobType != CommandJobType::BeginRenderPass) || (std::is_lvalue_reference_v<CommandJobArgs> && ...),
+                  "Render pass parameters are referenced until translation and must not be temporaries");
+
+    if constexpr (JobType == CommandJobType::BindResourceGroup)
+    {
+        BindResourceGroupPacket::record(packetBuffer, std::forward<CommandJobArgs>(args)...);
+    }
+    else if constexpr (JobType == CommandJobType::BindResourceSlots)
+    {
+        BindResourceSlotsPacket::record(packetBuffer, std::forward<CommandJobArgs>(args)...);
+    }
+    else if constexpr (JobType == CommandJobType::PushConstants)
+    {
+        PushConstantsPacket::record(packetBuffer, std::forward<CommandJobArgs>(args)...);
+    }
+    else
+    {
+        using PacketType = typename CommandPacketTraits<JobType>::PacketType;
+        packetBuffer->template emplacePacket<PacketType>(JobType, std::forward<CommandJobArgs>(args)...);
+    }
+}
+
+}  // namespace VoxFlow
+
+#endif
@@ -7,9 +7,10 @@
 #include <VoxFlow/Core/Graphics/Commands/CommandBuffer.hpp>
 #include <VoxFlow/Core/Utils/FenceObject.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
-#include <queue>
+#include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace VoxFlow
 {
@@ -26,26 +27,44 @@ class CommandPool : private NonCopyable
     CommandPool& operator=(CommandPool&& other) noexcept;
 
  public:
-    // Create new command buffer or get a freed one
+    // Get command buffer which is not used since the last reset, or allocate new one
     std::shared_ptr<CommandBuffer> getOrCreateCommandBuffer();
 
-    // Release command buffer to the freed pool
-    void releaseCommandBuffer(std::shared_ptr<CommandBuffer>&& commandBuffer);
+    // Get secondary command buffer which is not used since the last reset, or allocate new one
+    std::shared_ptr<CommandBuffer> getOrCreateSecondaryCommandBuffer();
 
- private:
-    struct CommandBufferComparator
+    /**
+     * Reset every command buffer allocated from this pool in a single call, so that they are reused
+     * without allocation. Submissions of the command buffers must be completed.
+     */
+    void reset();
+
+    // Hand over this pool to the calling thread. Previous owner thread must not use this pool anymore
+    void transferOwnership();
+
+    [[nodiscard]] inline std::thread::id getOwnerThreadId() const
+    {
+        return _creationThreadId;
+    }
+
+    [[nodiscard]] inline uint32_t getNumAllocatedCommandBuffers() const
     {
-        bool operator()(const std::shared_ptr<CommandBuffer>& lhs, const std::shared_ptr<CommandBuffer>& rhs)
-        {
-            return lhs->getFenceToSignal().getFenceValue() > rhs->getFenceToSignal().getFenceValue();
-        }
-    };
+        return static_cast<uint32_t>(_commandBuffers.size() + _secondaryCommandBuffers.size());
+    }
+
+ private:
+    std::shared_ptr<CommandBuffer> allocateCommandBuffer(VkCommandBufferLevel level);
 
+ private:
     std::thread::id _creationThreadId;
     LogicalDevice* _logicalDevice = nullptr;
     Queue* _ownerQueue = nullptr;
     VkCommandPool _commandPool = VK_NULL_HANDLE;
-    std::priority_queue<std::shared_ptr<CommandBuffer>, std::vector<std::shared_ptr<CommandBuffer>>, CommandBufferComparator> _freedCommandBuffers;
+    // Command buffers in front of _numUsedCommandBuffers are handed out since the last reset
+    std::vector<std::shared_ptr<CommandBuffer>> _commandBuffers;
+    std::vector<std::shared_ptr<CommandBuffer>> _secondaryCommandBuffers;
+    uint32_t _numUsedCommandBuffers = 0;
+    uint32_t _numUsedSecondaryCommandBuffers = 0;
 };
 }  // namespace VoxFlow
 
@@ -13,6 +13,21 @@ class CommandBuffer;
 class TextureView;
 class StagingBufferView;
 class BufferView;
+class ResourceView;
+
+/**
+ * Image or buffer barrier split into signal half recorded right after the producer and wait half recorded
+ * right before the consumer, so that unrelated commands between them can overlap with the transition.
+ */
+struct SplitBarrier
+{
+    VkEvent _vkEvent = VK_NULL_HANDLE;
+    VkPipelineStageFlags _srcStageFlags = VK_PIPELINE_STAGE_NONE;
+    VkPipelineStageFlags _dstStageFlags = VK_PIPELINE_STAGE_NONE;
+    VkImageMemoryBarrier _imageBarrier{};
+    VkBufferMemoryBarrier _bufferBarrier{};
+    bool _isBufferBarrier = false;
+};
 
 class ResourceBarrierManager : private NonCopyable
 {
@@ -27,12 +42,60 @@ class ResourceBarrierManager : private NonCopyable
 
     void addTextureMemoryBarrier(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
 
+    /**
+     * Add texture barrier planned ahead by frame graph. Following barrier of the same access
+     * requested while recording the pass is skipped.
+     */
+    void addPlannedTextureMemoryBarrier(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
+
+    /**
+     * Add conservative memory barrier against every previous command, as the memory of the given texture was
+     * used by the other textures. Content of the texture is discarded, so the next barrier transits it from undefined layout.
+     */
+    void addTextureAliasingBarrier(TextureView* textureView);
+
+    /**
+     * Record signal half of the split barrier which transits the given texture or buffer to the next access.
+     * The resource must not be accessed until the wait half is recorded.
+     */
+    void signalSplitBarrier(SplitBarrier* splitBarrier, ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
+
+    /**
+     * Add wait half of the split barrier which is recorded at the next commit with other pending barriers
+     */
+    void waitSplitBarrier(SplitBarrier* splitBarrier);
+
     void addBufferMemoryBarrier(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
 
+    /**
+     * Add buffer barrier planned ahead by frame graph. Following barrier of the same access
+     * requested while recording the pass is skipped.
+     */
+    void addPlannedBufferMemoryBarrier(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
+
     void addStagingBufferMemoryBarrier(StagingBufferView* stagingBufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags);
 
     void addExecutionBarrier(VkPipelineStageFlags prevStageFlags, VkPipelineStageFlags nextStageFlags);
 
+    /**
+     * Add release or acquire half of queue family ownership transfer of the given texture.
+     * Both halves keep the current image layout so that they match each other.
+     */
+    void addTextureOwnershipTransfer(TextureView* textureView, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                     const bool isRelease);
+
+    /**
+     * Add release or acquire half of queue family ownership transfer of the given buffer region.
+     */
+    void addBufferOwnershipTransfer(BufferView* bufferView, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                    const bool isRelease);
+
+    /**
+     * Query whether accessing the given view needs a barrier from its current state, without recording nor consuming anything.
+     * Read-only access same as the last one, or access planned ahead, is already visible to the next commands.
+     */
+    [[nodiscard]] bool isTransitionRequired(ResourceView* view, ResourceAccessMask accessMask) const;
+
     void commitPendingBarriers(const bool inRenderPassScope);
 
  private:
@@ -91,6 +154,8 @@ class ResourceBarrierManager : private NonCopyable
         }
     } _executionBarrier;
 
+    std::vector<SplitBarrier*> _pendingSplitBarriers;
+
     CommandBuffer* _commandBuffer = nullptr;
 };
 }  // namespace VoxFlow
@@ -25,7 +25,8 @@ enum class DescriptorCategory : uint8_t
     CombinedImage = 0,
     UniformBuffer = 1,
     StorageBuffer = 2,
-    Undefined = 3,
+    InputAttachment = 3,
+    Undefined = 4,
     Count = Undefined
 };
 
@@ -60,6 +61,35 @@ struct DescriptorSetLayoutDesc
     }
 };
 
+// Resource written into a single binding of descriptor set
+struct DescriptorBindingEntry
+{
+    uint32_t _binding = 0;
+    // See ResourceView::getViewId
+    uint64_t _viewId = 0;
+    ResourceAccessMask _usage = ResourceAccessMask::Undefined;
+    VkImageLayout _vkImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkSampler _vkSampler = VK_NULL_HANDLE;
+
+    inline bool operator==(const DescriptorBindingEntry& rhs) const
+    {
+        return (_binding == rhs._binding) && (_viewId == rhs._viewId) && (_usage == rhs._usage) && (_vkImageLayout == rhs._vkImageLayout) &&
+               (_vkSampler == rhs._vkSampler);
+    }
+};
+
+// Every resource written into descriptor set in order of binding calls. Same key written into the same set layout
+// always results in the same descriptor set contents.
+struct DescriptorSetBindingKey
+{
+    std::vector<DescriptorBindingEntry> _entries;
+
+    inline bool operator==(const DescriptorSetBindingKey& rhs) const
+    {
+        return _entries == rhs._entries;
+    }
+};
+
 }  // namespace VoxFlow
 
 template <>
@@ -74,4 +104,10 @@ struct std::hash<VoxFlow::DescriptorSetLayoutDesc>
     std::size_t operator()(VoxFlow::DescriptorSetLayoutDesc const& setLayout) const noexcept;
 };
 
+template <>
+struct std::hash<VoxFlow::DescriptorSetBindingKey>
+{
+    std::size_t operator()(VoxFlow::DescriptorSetBindingKey const& bindingKey) const noexcept;
+};
+
 #endif
\ No newline at end of file
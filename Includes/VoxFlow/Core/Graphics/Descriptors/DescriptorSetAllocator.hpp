@@ -9,6 +9,8 @@
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace VoxFlow
 {
@@ -47,6 +49,8 @@ class DescriptorSetAllocator : private NonCopyable
     {
         VkDescriptorSet _vkDescriptorSet = VK_NULL_HANDLE;
         FenceObject _lastAccessedFenceObject = FenceObject::Default();
+        // Key of bindings this set is cached for. Points to the key stored in the cache of pooled allocator
+        const DescriptorSetBindingKey* _cachedBindingKey = nullptr;
     };
 
     LogicalDevice* _logicalDevice = nullptr;
@@ -70,6 +74,27 @@ class PooledDescriptorSetAllocator final : public DescriptorSetAllocator
     // binding infos. Allocated descriptor set will be reused when the given
     // fence object is completed.
     [[nodiscard]] VkDescriptorSet getOrCreatePooledDescriptorSet(const FenceObject& fenceObject);
+
+    /**
+     * Find descriptor set already written with the given bindings. Found set is shared with the command buffers
+     * in flight, and is not rewritten for the other bindings until the given fence object is completed.
+     * @return cached descriptor set or VK_NULL_HANDLE if none is written with the bindings
+     */
+    [[nodiscard]] VkDescriptorSet getCachedDescriptorSet(const DescriptorSetBindingKey& bindingKey, const FenceObject& fenceObject);
+
+    /**
+     * Cache pooled descriptor set written with the given bindings so that the following binds of them skip writing.
+     * Must be called after writing descriptor set as other threads bind it as soon as it is cached.
+     */
+    void cacheDescriptorSet(const DescriptorSetBindingKey& bindingKey, VkDescriptorSet vkDescriptorSet);
+
+ private:
+    // Find node not accessed by GPU anymore or allocate new one. _pooledSetLock must be locked
+    uint32_t acquireCompletedNode(const FenceObject& fenceObject);
+
+ private:
+    std::mutex _pooledSetLock;
+    std::unordered_map<DescriptorSetBindingKey, uint32_t> _cachedNodeIndices;
 };
 
 class BindlessDescriptorSetAllocator final : public DescriptorSetAllocator
@@ -14,6 +14,7 @@ constexpr std::array<uint32_t, static_cast<uint32_t>(DescriptorCategory::Count)>
     100000,
     100000,
     100000,
+    0,  // Input attachment can not be bound in bindless manner
 };
 
 }  // namespace VoxFlow
@@ -5,9 +5,12 @@
 
 #include <volk/volk.h>
 #include <VoxFlow/Core/Graphics/Commands/CommandBuffer.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/ResourceBindingLayout.hpp>
 #include <VoxFlow/Core/Graphics/Pipelines/ShaderUtil.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace VoxFlow
@@ -57,6 +60,14 @@ class BasePipeline : NonCopyable
      */
     [[nodiscard]] virtual VkPipelineBindPoint getBindPoint() const noexcept = 0;
 
+    /**
+     * Resolve shader variable into binding slot which can be bound by BindResourceSlots job.
+     * Slots are resolved from shader reflection when this pipeline is created, so that
+     * it can be called before the pipeline layout is created at the first bind.
+     * @return binding slot of the variable, or invalid one if no shader module declares it
+     */
+    [[nodiscard]] ShaderBindingSlot findBindingSlot(const std::string& variableName) const;
+
     /**
      * @brief set pipeline cache for this pipeline
      */
@@ -80,6 +91,7 @@ class BasePipeline : NonCopyable
     std::unique_ptr<PipelineLayout> _pipelineLayout;
     std::unique_ptr<PipelineCache> _pipelineCache;
     std::vector<std::unique_ptr<ShaderModule>> _shaderModules;
+    std::unordered_map<std::string, ShaderBindingSlot> _bindingSlots;
     VkPipeline _pipeline{ VK_NULL_HANDLE };
 };
 }  // namespace VoxFlow
@@ -47,8 +47,10 @@ class GraphicsPipeline : public BasePipeline
  public:
     /**
      * Create graphics pipeline with given renderpass and owned shader modules
+     * @param renderPass render pass which this pipeline is used in
+     * @param subpassIndex index of subpass in the render pass where this pipeline is used
      */
-    bool initialize(RenderPass* renderPass);
+    bool initialize(RenderPass* renderPass, const uint32_t subpassIndex);
 
  private:
     GraphicsPipelineState _pipelineState;
@@ -63,6 +63,14 @@ class PipelineLayout : NonCopyable
         return _combinedPipelineLayoutDesc;
     }
 
+    /**
+     * @return push constant range merged from every shader module. Invalid if no stage accesses push constants
+     */
+    [[nodiscard]] const PushConstantRange& getPushConstantRange() const
+    {
+        return _combinedPipelineLayoutDesc._pushConstantRange;
+    }
+
  public:
     /**
      * Combine given shader layout bindings into descriptor set layouts with conflict resolved.
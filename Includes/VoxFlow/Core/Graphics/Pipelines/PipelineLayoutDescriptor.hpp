@@ -29,12 +29,25 @@ struct FragmentOutputLayout
     VkFormat _format = VK_FORMAT_UNDEFINED;
 };
 
+// Bytes of push constant block accessed by shader stages
+struct PushConstantRange
+{
+    uint32_t _offset = 0;
+    uint32_t _size = 0;
+    VkShaderStageFlags _stageFlags = 0;
+
+    inline bool isValid() const
+    {
+        return _size > 0;
+    }
+};
+
 struct ShaderReflectionDataGroup
 {
     std::unordered_map<DescriptorInfo, std::string> _descriptors;
     std::vector<VertexInputLayout> _vertexInputLayouts;
     std::vector<FragmentOutputLayout> _fragmentOutputLayouts;
-    uint32_t _pushConstantSize = 0;
+    PushConstantRange _pushConstantRange;
     VkShaderStageFlagBits _stageFlagBit;
 
     ShaderReflectionDataGroup() = default;
@@ -48,7 +61,8 @@ struct ShaderReflectionDataGroup
 struct PipelineLayoutDescriptor
 {
     std::array<DescriptorSetLayoutDesc, MAX_NUM_SET_SLOTS> _sets{};
-    uint32_t _pushConstantSize = 0;
+    // Push constant ranges of every stage merged into a single one
+    PushConstantRange _pushConstantRange;
 };
 
 }  // namespace VoxFlow
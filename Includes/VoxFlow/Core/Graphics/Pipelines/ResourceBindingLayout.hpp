@@ -4,6 +4,7 @@
 #define VOXEL_FLOW_RESOURCE_BINDING_LAYOUT_HPP
 
 #include <volk/volk.h>
+#include <VoxFlow/Core/Graphics/Descriptors/DescriptorSet.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <string>
 
@@ -18,6 +19,20 @@ struct ShaderVariableBinding
     ResourceAccessMask _usage = ResourceAccessMask::Undefined;
 };
 
+// Set, binding and descriptor category of shader variable resolved once from reflection of the pipeline
+using ShaderBindingSlot = DescriptorInfo;
+
+/**
+ * Resource bound into the slot resolved by BasePipeline::findBindingSlot.
+ * Unlike ShaderVariableBinding, bound without looking up variable name on every draw.
+ */
+struct ShaderSlotBinding
+{
+    ShaderBindingSlot _slot;
+    ResourceView* _view = nullptr;
+    ResourceAccessMask _usage = ResourceAccessMask::Undefined;
+};
+
 }  // namespace VoxFlow
 
 #endif
\ No newline at end of file
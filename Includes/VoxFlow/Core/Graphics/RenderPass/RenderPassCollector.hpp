@@ -7,6 +7,7 @@
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace VoxFlow
@@ -33,6 +34,7 @@ class RenderPassCollector : private NonCopyable
 
  private:
     LogicalDevice* _logicalDevice = nullptr;
+    std::mutex _collectionLock;
     std::unordered_map<RenderTargetLayoutKey, std::shared_ptr<RenderPass>> _renderPassCollection;
     std::unordered_map<RenderTargetsInfo, std::shared_ptr<FrameBuffer>> _frameBufferCollection;
 };
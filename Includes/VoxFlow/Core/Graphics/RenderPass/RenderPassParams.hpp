@@ -8,6 +8,7 @@
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <array>
 #include <glm/vec2.hpp>
+#include <vector>
 
 namespace VoxFlow
 {
@@ -57,6 +58,33 @@ struct RenderPassFlags
     }
 };
 
+// Attachments used by a subpass. Each bit and slot refers to the color attachment in the same slot of attachment group.
+struct SubpassLayout
+{
+    AttachmentMaskFlags _outputAttachments = AttachmentMaskFlags::None;
+    // Slots of color attachments read in this subpass, in order of input attachment index
+    std::array<uint8_t, MAX_RENDER_TARGET_COUNTS> _inputAttachmentSlots{};
+    uint8_t _numInputAttachments = 0;
+
+    inline bool operator==(const SubpassLayout& rhs) const
+    {
+        return (_outputAttachments == rhs._outputAttachments) && (_inputAttachmentSlots == rhs._inputAttachmentSlots) &&
+               (_numInputAttachments == rhs._numInputAttachments);
+    }
+
+    [[nodiscard]] inline bool hasInputAttachment(const uint32_t slot) const
+    {
+        for (uint8_t i = 0; i < _numInputAttachments; ++i)
+        {
+            if (_inputAttachmentSlots[i] == slot)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 struct RenderPassParams
 {
     RenderPassFlags _attachmentFlags;
@@ -65,6 +93,13 @@ struct RenderPassParams
     float _clearDepth = 0.0f;
     uint8_t _clearStencil = 0;
     AttachmentMaskFlags _writableAttachment = AttachmentMaskFlags::All;
+
+    // Empty if render pass has a single subpass which outputs to all attachments
+    std::vector<SubpassLayout> _subpassLayouts;
+    // Render pass is only began at the first subpass, and the other ones step to the next subpass
+    uint32_t _subpassIndex = 0;
+    // Draws of the subpass are recorded into secondary command buffers instead of inline
+    bool _useSecondaryCommandBuffers = false;
 };
 
 }  // namespace VoxFlow
@@ -75,4 +110,10 @@ struct std::hash<VoxFlow::RenderPassFlags>
     std::size_t operator()(VoxFlow::RenderPassFlags const& passFlags) const noexcept;
 };
 
+template <>
+struct std::hash<VoxFlow::SubpassLayout>
+{
+    std::size_t operator()(VoxFlow::SubpassLayout const& subpassLayout) const noexcept;
+};
+
 #endif
\ No newline at end of file
@@ -18,6 +18,7 @@ struct RenderTargetLayoutKey
     std::vector<VkFormat> _colorFormats;
     std::optional<VkFormat> _depthStencilFormat;
     RenderPassFlags _renderPassFlags;
+    std::vector<SubpassLayout> _subpassLayouts;
 
     bool operator==(const RenderTargetLayoutKey& other) const;
 };
@@ -11,7 +11,7 @@ namespace VoxFlow
 {
 namespace RenderGraph
 {
-class FrameGraph;
+class FrameGraphDeclarationScope;
 }
 
 class ResourceUploadContext;
@@ -41,7 +41,12 @@ class SceneRenderPass : NonCopyable
  public:
     virtual bool initialize() = 0;
     virtual void updateRender(ResourceUploadContext* uploadContext) = 0;
-    virtual void renderScene(RenderGraph::FrameGraph* frameGraph) = 0;
+    /**
+     * Declare passes of this scene render pass. Called concurrently with the other scene render passes
+     * except for the ones this pass depends on, which are completely declared before.
+     * @param declarationScope scope owned by this pass where passes and resources are declared into
+     */
+    virtual void renderScene(RenderGraph::FrameGraphDeclarationScope* declarationScope) = 0;
 
  protected:
     std::vector<std::string> _dependencyPass;
@@ -3,17 +3,25 @@
 #ifndef VOXEL_FLOW_RENDER_RESOURCE_ALLOCATOR_HPP
 #define VOXEL_FLOW_RENDER_RESOURCE_ALLOCATOR_HPP
 
+#include <vma/include/vk_mem_alloc.h>
+#include <VoxFlow/Core/Resources/Texture.hpp>
+#include <VoxFlow/Core/Utils/FenceObject.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <deque>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace VoxFlow
 {
 class LogicalDevice;
 class RenderResourceMemoryPool;
-class Texture;
 class Buffer;
+class BufferView;
 
 class RenderResourceAllocator : private NonCopyable
 {
@@ -24,12 +32,114 @@ class RenderResourceAllocator : private NonCopyable
  public:
     std::shared_ptr<Texture> allocateTexture(const TextureInfo& textureInfo, std::string&& debugName);
 
+    /**
+     * Allocate texture which is placed on the memory of given transient slot.
+     * Textures sharing same slot must not be alive at the same time in a frame,
+     * which is guaranteed by frame graph lifetime analysis.
+     * @param textureInfo texture information to allocate
+     * @param transientSlot index of transient memory slot to place texture on
+     * @param debugName texture debug name
+     * @return allocated texture or nullptr if failed
+     */
+    std::shared_ptr<Texture> allocateAliasedTexture(const TextureInfo& textureInfo, const uint32_t transientSlot, std::string_view debugName);
+
     std::shared_ptr<Buffer> allocateBuffer(const BufferInfo& bufferInfo, std::string&& debugName);
 
+    /**
+     * Acquire transient texture from the pool which was released in the previous frames
+     * and is not used by GPU anymore. If there is no such texture, new one is allocated.
+     * @param textureInfo texture information to acquire
+     * @param debugName texture debug name used when new texture is allocated
+     * @return pooled or newly allocated texture
+     */
+    std::shared_ptr<Texture> acquireTransientTexture(const TextureInfo& textureInfo, std::string_view debugName);
+
+    /**
+     * Return transient texture to the pool. It can be acquired again
+     * once the frame in which it is released is completed on GPU.
+     */
+    void releaseTransientTexture(std::shared_ptr<Texture>&& texture);
+
+    /**
+     * Suballocate transient buffer region from the ring buffer shared by all transient buffers.
+     * The region is reclaimed once the frame in which it is allocated is completed on GPU.
+     * If the ring is full of in-flight regions, it grows and the old one is retired with the current frame.
+     * @param size size of the region in bytes
+     * @param debugName debug name of the returned view
+     * @return view pointing the suballocated region which is valid until the end of the current frame
+     */
+    BufferView* allocateTransientBuffer(const uint64_t size, std::string&& debugName);
+
+    /**
+     * Bind the fences of submissions made in this frame to the transient textures released and the transient buffer
+     * regions allocated in this frame. They are reused only once every fence is completed.
+     * Pooled textures which have not been acquired for a while are evicted.
+     * @param frameFences fences of the submissions on each queue in the current frame. Invalid ones are ignored.
+     */
+    void endTransientResourceFrame(std::span<const FenceObject> frameFences);
+
+    [[nodiscard]] inline uint32_t getNumAllocatedTransientTextures() const
+    {
+        return _numAllocatedTransientTextures;
+    }
+
+    [[nodiscard]] inline uint64_t getTransientBufferRingCapacity() const
+    {
+        return _transientBufferRingCapacity;
+    }
+
  protected:
+    void releaseTransientMemorySlots();
+
+    // Replace the transient buffer ring with larger one which can hold at least the given size
+    bool growTransientBufferRing(const uint64_t requiredSize);
+
+    // Move the ring tail past the regions whose frames are completed on GPU
+    void reclaimTransientBufferRegions();
+
  private:
+    static constexpr uint64_t TRANSIENT_TEXTURE_MAX_AGE = 8;
+    static constexpr uint64_t TRANSIENT_BUFFER_RING_INITIAL_SIZE = 16 * 1024 * 1024;
+    static constexpr uint64_t TRANSIENT_BUFFER_ALIGNMENT = 256;
+
+    struct PooledTexture
+    {
+        std::shared_ptr<Texture> _texture;
+        std::vector<FenceObject> _lastUsedFences;
+        uint64_t _lastUsedFrameIndex = 0;
+    };
+
+    struct TransientMemorySlot
+    {
+        VmaAllocation _allocation = VK_NULL_HANDLE;
+        VkMemoryRequirements _memoryRequirements = {};
+        uint32_t _memoryTypeIndex = UINT32_MAX;
+        std::vector<std::shared_ptr<Texture>> _placedTextures;
+    };
+
+    struct TransientBufferRegion
+    {
+        std::vector<FenceObject> _frameFences;
+        // Virtual ring offset at the end of the frame. Ring tail can pass it once the frame is completed.
+        uint64_t _endOffset = 0;
+        std::vector<std::shared_ptr<Buffer>> _retiredRings;
+    };
+
     LogicalDevice* _logicalDevice = nullptr;
     RenderResourceMemoryPool* _renderResourceMemoryPool = nullptr;
+    std::vector<TransientMemorySlot> _transientMemorySlots;
+    std::unordered_map<TextureInfo, std::vector<PooledTexture>> _transientTexturePool;
+    std::vector<std::shared_ptr<Texture>> _releasedTransientTextures;
+    std::shared_ptr<Buffer> _transientBufferRing;
+    std::deque<TransientBufferRegion> _inFlightBufferRegions;
+    std::vector<std::shared_ptr<BufferView>> _transientBufferViews;
+    std::vector<std::shared_ptr<Buffer>> _retiredBufferRings;
+    uint64_t _transientBufferRingCapacity = 0;
+    // Head and tail are virtual offsets increasing monotonically, wrapped by the capacity when placing regions
+    uint64_t _transientBufferRingHead = 0;
+    uint64_t _transientBufferRingTail = 0;
+    uint64_t _transientFrameIndex = 0;
+    uint32_t _numAllocatedTransientTextures = 0;
 };
 }  // namespace VoxFlow
 
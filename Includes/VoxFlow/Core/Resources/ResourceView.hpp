@@ -7,6 +7,7 @@
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace VoxFlow
@@ -36,6 +37,23 @@ class ResourceView : private NonCopyable
         return _ownerResource;
     }
 
+    /**
+     * Returns id which is never shared by the other views even after this view is destroyed,
+     * so that written descriptor sets are not mistaken as holding the view allocated at the same address
+     */
+    [[nodiscard]] inline uint64_t getViewId() const
+    {
+        return _viewId;
+    }
+
+    /**
+     * Lock guarding access state of this view, which is transited by command buffers recorded on multiple threads
+     */
+    [[nodiscard]] inline std::mutex& getAccessStateLock()
+    {
+        return _accessStateLock;
+    }
+
     inline void setLastAccessMask(ResourceAccessMask accessMask)
     {
         _lastAccessMask = accessMask;
@@ -57,13 +75,47 @@ class ResourceView : private NonCopyable
         return _lastUsedStageFlags;
     }
 
+    /**
+     * Mark that the barrier for the given access is already recorded ahead by frame graph barrier plan
+     * @param accessMask planned access mask. ResourceAccessMask::Undefined if nothing is planned
+     */
+    inline void setPlannedAccessMask(ResourceAccessMask accessMask)
+    {
+        _plannedAccessMask = accessMask;
+    }
+
+    /**
+     * @return whether barrier for the given access is already recorded ahead, without consuming it
+     */
+    [[nodiscard]] inline bool hasPlannedAccess(ResourceAccessMask accessMask) const
+    {
+        return (_plannedAccessMask != ResourceAccessMask::Undefined) && ((_plannedAccessMask & accessMask) == accessMask);
+    }
+
+    /**
+     * Consume the planned barrier if it covers the given access so that the same barrier is not recorded twice
+     * @return whether barrier for the given access is already recorded or not
+     */
+    inline bool consumePlannedAccess(ResourceAccessMask accessMask)
+    {
+        if (hasPlannedAccess(accessMask))
+        {
+            _plannedAccessMask = ResourceAccessMask::Undefined;
+            return true;
+        }
+        return false;
+    }
+
  protected:
     std::string _debugName;
     LogicalDevice* _logicalDevice = nullptr;
     ResourceAccessMask _lastAccessMask = ResourceAccessMask::Undefined;
     VkPipelineStageFlags _lastUsedStageFlags = VK_PIPELINE_STAGE_NONE;
+    ResourceAccessMask _plannedAccessMask = ResourceAccessMask::Undefined;
+    std::mutex _accessStateLock;
     std::vector<FenceObject> _accessedFences;
     RenderResource* _ownerResource = nullptr;
+    uint64_t _viewId = 0;
 };
 }  // namespace VoxFlow
 
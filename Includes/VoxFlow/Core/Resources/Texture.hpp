@@ -24,6 +24,7 @@ extern bool hasStencilAspect(VkFormat vkFormat);
 extern VkImageAspectFlags convertToImageAspectFlags(VkFormat vkFormat);
 extern VkImageType convertToImageType(glm::uvec3 imageType);
 extern VkImageViewType convertToImageViewType(VkImageType vkImageType, glm::uvec3 extent);
+extern uint32_t getFormatByteSize(VkFormat vkFormat);
 
 class Texture final : public RenderResource
 {
@@ -63,6 +64,13 @@ class Texture final : public RenderResource
     // Make the image allocation resident if evicted
     bool makeAllocationResident(const TextureInfo& textureInfo);
 
+    // Create image bound to the given allocation which is shared with other textures.
+    // The allocation is not owned by this texture and must outlive it.
+    bool makeAliasedAllocationResident(const TextureInfo& textureInfo, VmaAllocation aliasedAllocation);
+
+    // Query memory requirements of the image for given texture info without creating it
+    [[nodiscard]] VkMemoryRequirements getMemoryRequirements(const TextureInfo& textureInfo) const;
+
     // Create texture instance from swapchain image which should be separated
     // from others
     bool initializeFromSwapChain(const TextureInfo& swapChainSurfaceInfo, VkImage swapChainImage);
@@ -74,10 +82,15 @@ class Texture final : public RenderResource
     void release();
 
  protected:
+ private:
+    // Create default view pointing whole texture
+    bool createDefaultView();
+
  private:
     VkImage _vkImage = VK_NULL_HANDLE;
     TextureInfo _textureInfo;
     bool _isSwapChainBackBuffer = false;
+    bool _isAliasedAllocation = false;
     std::vector<std::shared_ptr<TextureView>> _ownedTextureViews;
     TextureView* _defaultView = nullptr;
 };
@@ -133,4 +146,10 @@ class TextureView : public ResourceView
 };
 }  // namespace VoxFlow
 
+template <>
+struct std::hash<VoxFlow::TextureInfo>
+{
+    std::size_t operator()(VoxFlow::TextureInfo const& textureInfo) const noexcept;
+};
+
 #endif
\ No newline at end of file
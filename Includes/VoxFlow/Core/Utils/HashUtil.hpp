@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <string_view>
 
 namespace VoxFlow
 {
@@ -16,6 +17,40 @@ inline void hash_combine(uint32_t& seed, const Type& v)
     seed ^= static_cast<uint32_t>(hasher(v)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+template <class Type>
+inline void hash_combine(uint64_t& seed, const Type& v)
+{
+    std::hash<Type> hasher;
+    seed ^= static_cast<uint64_t>(hasher(v)) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * String hasher which lets unordered containers keyed by std::string be looked up by std::string_view
+ * without constructing temporary key. Must be used together with std::equal_to<>.
+ */
+struct TransparentStringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+/**
+ * 32-bit FNV-1a hash of the given string which can be evaluated at compile time
+ */
+constexpr uint32_t hash_fnv1a(std::string_view str)
+{
+    uint32_t hash = 0x811c9dc5;
+    for (const char c : str)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+    }
+    return hash;
+}
+
 }  // namespace VoxFlow
 
 #endif
\ No newline at end of file
@@ -6,8 +6,13 @@
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <condition_variable>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <string_view>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace VoxFlow
@@ -93,6 +98,144 @@ class LinearMemoryAllocator : private NonCopyable
     LinearBlockAllocator _linearBlockAllocator;
     void* _dataAddress = nullptr;
 };
+
+/**
+ * Bump allocator for objects living until the next reset. Memory blocks are kept across reset,
+ * so once warmed up, allocations of the same amount do not touch the heap anymore.
+ * Not thread-safe.
+ */
+class ArenaAllocator : private NonCopyable
+{
+ public:
+    explicit ArenaAllocator(const uint64_t blockSize);
+    ~ArenaAllocator();
+
+    /**
+     * @return memory of given size aligned by given alignment which is valid until the next reset
+     */
+    void* allocate(const uint64_t size, const uint64_t alignment);
+
+    /**
+     * Construct object in the arena. Its destructor is called at the next reset.
+     * @return constructed object
+     */
+    template <typename Type, typename... Args>
+    Type* construct(Args&&... args);
+
+    /**
+     * Copy the given string into the arena
+     * @return view of the copied string which is valid until the next reset
+     */
+    std::string_view copyString(std::string_view str);
+
+    /**
+     * Destruct all constructed objects in reverse order and rewind to the first block
+     */
+    void reset();
+
+    /**
+     * @return number of allocations since the last reset
+     */
+    [[nodiscard]] inline uint64_t getNumAllocations() const
+    {
+        return _numAllocations;
+    }
+
+    /**
+     * @return number of memory blocks allocated from the heap so far
+     */
+    [[nodiscard]] inline uint64_t getNumHeapBlocks() const
+    {
+        return _blocks.size();
+    }
+
+ private:
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> _data;
+        uint64_t _size = 0;
+    };
+
+    struct DestructorNode
+    {
+        void (*_destruct)(void*) = nullptr;
+        void* _object = nullptr;
+        DestructorNode* _next = nullptr;
+    };
+
+    std::vector<Block> _blocks;
+    DestructorNode* _destructorList = nullptr;
+    uint64_t _blockSize = 0;
+    uint64_t _currentBlockIndex = 0;
+    uint64_t _currentOffset = 0;
+    uint64_t _numAllocations = 0;
+};
+
+template <typename Type, typename... Args>
+Type* ArenaAllocator::construct(Args&&... args)
+{
+    Type* object = new (allocate(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+
+    if constexpr (std::is_trivially_destructible_v<Type> == false)
+    {
+        DestructorNode* destructorNode = new (allocate(sizeof(DestructorNode), alignof(DestructorNode))) DestructorNode();
+        destructorNode->_destruct = [](void* objectToDestruct) { static_cast<Type*>(objectToDestruct)->~Type(); };
+        destructorNode->_object = object;
+        destructorNode->_next = _destructorList;
+        _destructorList = destructorNode;
+    }
+
+    return object;
+}
+
+/**
+ * Standard allocator adaptor serving containers from the arena. Memory is never given back
+ * to the arena on deallocation but reclaimed all at once at the reset, so containers using it
+ * must not outlive the next reset of the arena.
+ */
+template <typename Type>
+class ArenaStlAllocator
+{
+ public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaStlAllocator() = default;
+    ArenaStlAllocator(ArenaAllocator* arenaAllocator) : _arenaAllocator(arenaAllocator)
+    {
+    }
+    template <typename OtherType>
+    ArenaStlAllocator(const ArenaStlAllocator<OtherType>& rhs) : _arenaAllocator(rhs.getArenaAllocator())
+    {
+    }
+
+    Type* allocate(const std::size_t count)
+    {
+        return static_cast<Type*>(_arenaAllocator->allocate(count * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type*, const std::size_t)
+    {
+    }
+
+    [[nodiscard]] inline ArenaAllocator* getArenaAllocator() const
+    {
+        return _arenaAllocator;
+    }
+
+    template <typename OtherType>
+    bool operator==(const ArenaStlAllocator<OtherType>& rhs) const
+    {
+        return _arenaAllocator == rhs.getArenaAllocator();
+    }
+
+ private:
+    ArenaAllocator* _arenaAllocator = nullptr;
+};
+
+template <typename Type>
+using ArenaVector = std::vector<Type, ArenaStlAllocator<Type>>;
 }  // namespace VoxFlow
 
 #endif
\ No newline at end of file
@@ -96,6 +96,8 @@ enum class TextureUsage : uint32_t
     CopySrc = 0x00010000,
     CopyDst = 0x00100000,
     BackBuffer = 0x01000000,
+    InputAttachment = 0x10000000,
+    TransientAttachment = 0x20000000,
     Unknown = 0,
 };
 IMPL_BITWISE_OPERATORS(TextureUsage, uint32_t);
@@ -106,6 +108,13 @@ struct TextureInfo
     VkFormat _format = VK_FORMAT_UNDEFINED;
     VkImageType _imageType = VK_IMAGE_TYPE_2D;
     TextureUsage _usage = TextureUsage::Unknown;
+    uint32_t _numSamples = 1;
+
+    inline bool operator==(const TextureInfo& rhs) const
+    {
+        return (_extent == rhs._extent) && (_format == rhs._format) && (_imageType == rhs._imageType) && (_usage == rhs._usage) &&
+               (_numSamples == rhs._numSamples);
+    }
 };
 
 struct TextureViewInfo
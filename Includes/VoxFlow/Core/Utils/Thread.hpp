@@ -4,6 +4,7 @@
 #define VOXEL_FLOW_THREAD_HPP
 
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 
@@ -19,6 +20,15 @@ class Thread
 
     static void SetThreadName(const char* threadName);
 
+    /**
+     * Get index of the calling thread which is unique among running threads and less than
+     * MAX_NUM_WORKER_THREADS. Index is cached in thread-local storage and handed over to
+     * another thread only after the calling thread exits.
+     */
+    static uint32_t GetWorkerIndex();
+
+    static constexpr uint32_t MAX_NUM_WORKER_THREADS = 256;
+
  protected:
     std::thread _threadHandle;
     std::condition_variable _conditionVariable;
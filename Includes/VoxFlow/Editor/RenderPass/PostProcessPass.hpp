@@ -4,6 +4,7 @@
 #define VOXEL_FLOW_POST_PROCESS_PASS_HPP
 
 #include <VoxFlow/Core/FrameGraph/Resource.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/ResourceBindingLayout.hpp>
 #include <VoxFlow/Core/Renderer/SceneRenderPass.hpp>
 #include <VoxFlow/Core/Utils/NonCopyable.hpp>
 #include <memory>
@@ -17,7 +18,7 @@ class LogicalDevice;
 
 namespace RenderGraph
 {
-class FrameGraph;
+class FrameGraphDeclarationScope;
 }
 
 class PostProcessPass : public SceneRenderPass
@@ -29,15 +30,17 @@ class PostProcessPass : public SceneRenderPass
  public:
     bool initialize() override;
     void updateRender(ResourceUploadContext* uploadContext) override;
-    void renderScene(RenderGraph::FrameGraph* frameGraph) override;
+    void renderScene(RenderGraph::FrameGraphDeclarationScope* declarationScope) override;
 
  protected:
     struct PostProcessPassData
     {
+        RenderGraph::ResourceHandle _sceneColorHandle;
         uint32_t _renderPassID = 0;
     } _passData;
 
     std::shared_ptr<GraphicsPipeline> _toneMapPipeline;
+    ShaderBindingSlot _sceneColorSlot;
     LogicalDevice* _logicalDevice = nullptr;
 };
 }  // namespace VoxFlow
@@ -17,7 +17,7 @@ class LogicalDevice;
 
 namespace RenderGraph
 {
-class FrameGraph;
+class FrameGraphDeclarationScope;
 }
 
 class SceneObjectPass : public SceneRenderPass
@@ -29,7 +29,7 @@ class SceneObjectPass : public SceneRenderPass
  public:
     bool initialize() override;
     void updateRender(ResourceUploadContext* uploadContext) override;
-    void renderScene(RenderGraph::FrameGraph* frameGraph) override;
+    void renderScene(RenderGraph::FrameGraphDeclarationScope* declarationScope) override;
 
  protected:
  private:
@@ -19,6 +19,7 @@
 #include <VoxFlow\Core\FrameGraph\FrameGraphRenderPass.hpp>
 #include <VoxFlow\Core\FrameGraph\FrameGraphResources.hpp>
 #include <VoxFlow\Core\FrameGraph\FrameGraphTexture.hpp>
+#include <VoxFlow\Core\FrameGraph\FrameGraphBuffer.hpp>
 #include <VoxFlow\Core\FrameGraph\Resource-Impl.hpp>
 #include <VoxFlow\Core\FrameGraph\Resource.hpp>
 #include <VoxFlow\Core\FrameGraph\ResourceHandle.hpp>
@@ -0,0 +1,12 @@
+#version 450
+
+layout (location = 0) in VS_OUT {
+	vec2 texCoord;
+} fs_in;
+layout (set = 1, binding = 0) uniform sampler2D uTex;
+layout (location = 0) out vec4 finalOutputColor;
+
+void main()
+{
+	finalOutputColor = texture(uTex, fs_in.texCoord);
+}
@@ -4,9 +4,14 @@ precision mediump float;
 
 layout(location = 0) in vec2 aTexCoord;
 layout(set = 2, binding = 0) uniform sampler2D uTex;
+layout(push_constant) uniform PushConstants
+{
+    vec4 uScaleBias;
+    vec4 uTint;
+} pushConstants;
 layout(location = 0) out vec4 FragColor;
 
 void main()
 {
-    FragColor = textureProj(uTex, vec4(aTexCoord, 0.0, 1.0));
+    FragColor = textureProj(uTex, vec4(aTexCoord, 0.0, 1.0)) * pushConstants.uTint;
 }
\ No newline at end of file
@@ -3,11 +3,16 @@
 precision mediump float;
 
 layout(set = 1, binding = 5) uniform sampler2D textures[5];
+layout(push_constant) uniform PushConstants
+{
+    vec4 uScaleBias;
+    vec4 uTint;
+} pushConstants;
 layout(location = 0) in vec2 aTexCoord;
 layout(location = 0) out vec4 vTex;
 
 void main()
 {
    vTex = vec4(1.0);
-   gl_Position = texture(textures[2], aTexCoord);
+   gl_Position = texture(textures[2], aTexCoord * pushConstants.uScaleBias.xy + pushConstants.uScaleBias.zw);
 }
\ No newline at end of file
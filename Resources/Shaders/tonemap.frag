@@ -8,8 +8,7 @@ layout ( location = 0 ) in VSOUT {
 } fs_in;
 layout (location = 0) out vec4 outFragCoord;
 
-// TODO(snowapril) : modify to input attachment
-layout(set = 1, binding = 0) uniform sampler2D g_sceneColor;
+layout(input_attachment_index = 0, set = 1, binding = 0) uniform subpassInput g_sceneColor;
 
 vec4 SRGBtoLinear(vec4 srgbIn, float gamma)
 {
@@ -38,6 +37,6 @@ vec4 tonemap(vec4 color, float gamma, float exposure)
 
 void main()
 {
-	vec4 sceneColor = texture(g_sceneColor, fs_in.texCoord);
+	vec4 sceneColor = subpassLoad(g_sceneColor);
 	outFragCoord = vec4(Uncharted2Tonemap(sceneColor.xyz), 1.0f);
 }
\ No newline at end of file
@@ -140,10 +140,13 @@ FenceObject Queue::submitCommandBuffer(const std::shared_ptr<CommandBuffer>& com
 }
 
 FenceObject Queue::submitCommandBufferBatch(std::vector<std::shared_ptr<CommandBuffer>>&& batchedCommandBuffers, SwapChain* swapChain,
-                                            const FrameContext* frameContext, const bool waitAllCompletion)
+                                            const FrameContext* frameContext, const bool waitBackBufferReady, const bool signalPresentReady,
+                                            const bool waitAllCompletion, const std::vector<FenceObject>& fencesToWait)
 {
     VOX_ASSERT((swapChain == nullptr) || (frameContext == nullptr) || (frameContext->_frameIndex < FRAME_BUFFER_COUNT),
                "Must provide valid frame index when swapChain is not nullptr");
+    VOX_ASSERT((swapChain != nullptr) || ((waitBackBufferReady == false) && (signalPresentReady == false)),
+               "Swapchain semaphores can not be used without swapChain");
 
     std::vector<std::shared_ptr<CommandBuffer>>&& commandBuffersToSubmit = std::move(batchedCommandBuffers);
 
@@ -164,41 +167,57 @@ FenceObject Queue::submitCommandBufferBatch(std::vector<std::shared_ptr<CommandB
                        return cmdBuffer->get();
                    });
 
+    // Command buffers recorded in parallel allocate consecutive fence values while only the
+    // maximum is signaled, so wait for the value signaled right before the smallest one.
+    std::vector<uint64_t> waitingValues = { commandBuffersToSubmit.front()->getFenceToSignal().getFenceValue() - 1 };
+    std::vector<VkSemaphore> waitingSemaphores = { _submitTimelineSemaphore };
+
+    // TODO(snowapril) : modify stage masks
+    std::vector<VkPipelineStageFlags> waitDstStageMasks = { VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT };
+
+    // Add wait semaphore for waiting acquire back buffer image
+    if (waitBackBufferReady)
+    {
+        waitingValues.push_back(0ULL);
+        waitingSemaphores.push_back(swapChain->getCurrentBackBufferReadySemaphore());
+        waitDstStageMasks.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    }
+
+    // Add wait semaphores for work submitted to the other queues in the same frame
+    for (const FenceObject& fenceToWait : fencesToWait)
+    {
+        VOX_ASSERT(fenceToWait.getQueue() != this, "Submission to the same queue is already ordered by its own timeline semaphore");
+        waitingValues.push_back(fenceToWait.getFenceValue());
+        waitingSemaphores.push_back(*fenceToWait.getQueue()->getSubmitTimelineSemaphore());
+        waitDstStageMasks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+
     uint64_t signalingValues[2] = { maxFenceSignalValue, 0ULL };
 
-    uint64_t waitingValues[2] = { signalingValues[0] - 1, 0ULL };
     VkTimelineSemaphoreSubmitInfo timelineInfo{
         .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
         .pNext = NULL,
-        .waitSemaphoreValueCount = swapChain == nullptr ? 1U : 2U,  // TODO
-        .pWaitSemaphoreValues = waitingValues,                      // TODO
-        .signalSemaphoreValueCount = swapChain == nullptr ? 1U : 2U,
+        .waitSemaphoreValueCount = static_cast<uint32_t>(waitingValues.size()),
+        .pWaitSemaphoreValues = waitingValues.data(),
+        .signalSemaphoreValueCount = signalPresentReady ? 2U : 1U,
         .pSignalSemaphoreValues = signalingValues,
     };
 
-    VkSemaphore waitingSemaphores[2] = { _submitTimelineSemaphore, swapChain == nullptr ? VK_NULL_HANDLE : swapChain->getCurrentBackBufferReadySemaphore() };
-
-    VkSemaphore signalingSemaphores[2] = { _submitTimelineSemaphore, swapChain == nullptr ? VK_NULL_HANDLE : swapChain->getCurrentPresentReadySemaphore() };
-
-    // TODO(snowapril) : modify stage masks
-    VkPipelineStageFlags waitDstStageMasks[2] = { VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT };
+    VkSemaphore signalingSemaphores[2] = { _submitTimelineSemaphore, signalPresentReady ? swapChain->getCurrentPresentReadySemaphore() : VK_NULL_HANDLE };
 
-    // Add wait semaphore for waiting acquire back buffer image
     VkSubmitInfo submitInfo = { .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
                                 .pNext = &timelineInfo,
-                                .waitSemaphoreCount = swapChain != nullptr ? 2U : 1U,
-                                .pWaitSemaphores = &waitingSemaphores[0],
-                                .pWaitDstStageMask = waitDstStageMasks,
+                                .waitSemaphoreCount = static_cast<uint32_t>(waitingSemaphores.size()),
+                                .pWaitSemaphores = waitingSemaphores.data(),
+                                .pWaitDstStageMask = waitDstStageMasks.data(),
                                 .commandBufferCount = static_cast<uint32_t>(cmdBuffersToSubmit.size()),
                                 .pCommandBuffers = cmdBuffersToSubmit.data(),
-                                .signalSemaphoreCount = swapChain != nullptr ? 2U : 1U,
+                                .signalSemaphoreCount = signalPresentReady ? 2U : 1U,
                                 .pSignalSemaphores = &signalingSemaphores[0] };
 
-    _lastExecutedFence = FenceObject(this, waitingValues[0]);
-
     VK_ASSERT(vkQueueSubmit(_queue, 1, &submitInfo, VK_NULL_HANDLE));
 
-    _lastExecutedFence.advanceFenceValue();
+    _lastExecutedFence = FenceObject(this, maxFenceSignalValue);
 
     if (waitAllCompletion)
     {
@@ -214,7 +233,7 @@ FenceObject Queue::submitCommandBufferBatch(std::vector<std::shared_ptr<CommandB
         vkWaitSemaphoresKHR(_logicalDevice->get(), &waitInfo, UINT64_MAX);
         _lastCompletedFence = FenceObject(this, maxFenceSignalValue);
     }
-    else if (swapChain != nullptr && frameContext != nullptr)
+    else if (signalPresentReady && frameContext != nullptr)
     {
         swapChain->addWaitSemaphores(frameContext->_frameIndex, _submitTimelineSemaphore, maxFenceSignalValue);
     }
@@ -238,4 +257,24 @@ uint64_t Queue::querySemaphoreValue()
     return value;
 }
 
+void Queue::waitFenceValue(const uint64_t fenceValue)
+{
+    if (fenceValue <= _lastCompletedFence.getFenceValue())
+    {
+        return;
+    }
+
+    VkSemaphoreWaitInfo waitInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .semaphoreCount = 1,
+        .pSemaphores = &_submitTimelineSemaphore,
+        .pValues = &fenceValue,
+    };
+
+    VK_ASSERT(vkWaitSemaphoresKHR(_logicalDevice->get(), &waitInfo, UINT64_MAX));
+    _lastCompletedFence = FenceObject(this, fenceValue);
+}
+
 }  // namespace VoxFlow
\ No newline at end of file
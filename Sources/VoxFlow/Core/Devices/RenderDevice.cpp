@@ -61,6 +61,9 @@ void RenderDevice::updateRender(const double deltaTime)
     SCOPED_CHROME_TRACING("RenderDevice::updateRender");
     (void)deltaTime;
 
+    // Command buffers of the frame submitted FRAME_BUFFER_COUNT frames ago are recycled from here
+    _mainCmdJobSystem->beginFrame();
+
     const CommandStreamKey cmdStreamKey = { ._cmdStreamName = ASYNC_UPLOAD_STREAM_NAME, ._cmdStreamUsage = CommandStreamUsage::Transfer };
 
     CommandStream* asyncUploadStream = _mainCmdJobSystem->getCommandStream(cmdStreamKey);
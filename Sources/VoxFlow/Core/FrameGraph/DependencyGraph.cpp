@@ -2,13 +2,16 @@
 
 #include <VoxFlow/Core/FrameGraph/DependencyGraph.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
-#include <stack>
 
 namespace VoxFlow
 {
-DependencyGraph::Node::Node(DependencyGraph* ownerGraph) : _ownerGraph(ownerGraph), _nodeId(ownerGraph->getNextNodeID())
+DependencyGraph::Node::Node(DependencyGraph* ownerGraph) : _ownerGraph(ownerGraph)
 {
-    _ownerGraph->registerNode(this, _nodeId);
+    if (_ownerGraph != nullptr)
+    {
+        _nodeId = _ownerGraph->getNextNodeID();
+        _ownerGraph->registerNode(this, _nodeId);
+    }
 }
 
 DependencyGraph::Edge::Edge(DependencyGraph* ownerGraph, Node* from, Node* to)
@@ -28,26 +31,30 @@ DependencyGraph::NodeID DependencyGraph::getNextNodeID()
     return _nextNodeID.fetch_add(1U);
 }
 
-DependencyGraph::EdgeContainer DependencyGraph::getIncomingEdges(NodeID id)
+DependencyGraph::EdgeSpan DependencyGraph::getIncomingEdges(NodeID id) const
 {
-    EdgeContainer incomingEdges;
-    std::copy_if(_edges.begin(), _edges.end(), std::back_inserter(incomingEdges), [id](Edge* edge) { return edge->_toNodeID == id; });
-
-    return incomingEdges;
+    return _adjacentEdges[id]._incomingEdges;
 }
 
-DependencyGraph::EdgeContainer DependencyGraph::getOutgoingEdges(NodeID id)
+DependencyGraph::EdgeSpan DependencyGraph::getOutgoingEdges(NodeID id) const
 {
-    EdgeContainer outgoingEdges;
-    std::copy_if(_edges.begin(), _edges.end(), std::back_inserter(outgoingEdges), [id](Edge* edge) { return edge->_fromNodeID == id; });
-
-    return outgoingEdges;
+    return _adjacentEdges[id]._outgoingEdges;
 }
 
 void DependencyGraph::registerNode(Node* node, NodeID id)
 {
     VOX_ASSERT(id == static_cast<NodeID>(_nodes.size()), "Invalid Node ID {} was given", id);
     _nodes.push_back(node);
+    addAdjacentEdges(id);
+}
+
+void DependencyGraph::adoptNode(Node* node)
+{
+    VOX_ASSERT(node->_ownerGraph == nullptr, "Node({}) is already registered to dependency graph", node->_nodeId);
+
+    node->_ownerGraph = this;
+    node->_nodeId = getNextNodeID();
+    registerNode(node, node->_nodeId);
 }
 
 void DependencyGraph::cullUnreferencedNodes()
@@ -61,37 +68,58 @@ void DependencyGraph::cullUnreferencedNodes()
         }
     }
 
-    std::stack<Node*> unreferencedNodes;
+    _unreferencedNodes.clear();
     for (Node* node : _nodes)
     {
         if (node->_refCount == 0)
         {
-            unreferencedNodes.push(node);
+            _unreferencedNodes.push_back(node);
         }
     }
 
-    while (unreferencedNodes.empty() == false)
+    while (_unreferencedNodes.empty() == false)
     {
-        Node* node = unreferencedNodes.top();
-        unreferencedNodes.pop();
+        Node* node = _unreferencedNodes.back();
+        _unreferencedNodes.pop_back();
 
-        EdgeContainer incomingEdges = getIncomingEdges(node->getNodeID());
-        for (Edge* incomingEdge : incomingEdges)
+        for (Edge* incomingEdge : getIncomingEdges(node->getNodeID()))
         {
             Node* linkedNode = getNode(incomingEdge->_fromNodeID);
             VOX_ASSERT(linkedNode->_refCount > 0, "Reference count must not be zero");
             if ((--linkedNode->_refCount) == 0)
             {
-                unreferencedNodes.push(linkedNode);
+                _unreferencedNodes.push_back(linkedNode);
             }
         }
     }
 }
 
+void DependencyGraph::clear()
+{
+    _edges.clear();
+    _nodes.clear();
+    // Keep adjacent edge containers to reuse their capacity in the next frame
+    for (AdjacentEdges& adjacentEdges : _adjacentEdges)
+    {
+        adjacentEdges._incomingEdges.clear();
+        adjacentEdges._outgoingEdges.clear();
+    }
+    _nextNodeID.store(0);
+}
+
 void DependencyGraph::insertNode(Node* node, NodeID id)
 {
     VOX_ASSERT(_nodes.size() == static_cast<size_t>(id), "Invalid NodeID");
     _nodes.push_back(node);
+    addAdjacentEdges(id);
+}
+
+void DependencyGraph::addAdjacentEdges(NodeID id)
+{
+    if (_adjacentEdges.size() <= static_cast<size_t>(id))
+    {
+        _adjacentEdges.emplace_back();
+    }
 }
 
 bool DependencyGraph::isEdgeValid(const Edge* edge) const
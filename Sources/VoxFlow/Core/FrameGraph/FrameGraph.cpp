@@ -2,10 +2,17 @@
 
 #include <VoxFlow/Core/FrameGraph/FrameGraph.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphResources.hpp>
+#include <VoxFlow/Core/Devices/Queue.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <VoxFlow/Core/Resources/RenderResourceAllocator.hpp>
 #include <VoxFlow/Core/Utils/ChromeTracer.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <stack>
+#include <taskflow/taskflow.hpp>
+#include <unordered_map>
 
 namespace VoxFlow
 {
@@ -14,38 +21,96 @@ namespace RenderGraph
 {
 uint32_t FrameGraphBuilder::declareRenderPass(std::string_view&& passName, typename FrameGraphRenderPass::Descriptor&& initArgs)
 {
+    combineStructureHash(passName);
+    for (ResourceHandle attachment : initArgs._attachments)
+    {
+        combineStructureHash(attachment);
+    }
+    for (ResourceHandle inputAttachment : initArgs._inputAttachments)
+    {
+        combineStructureHash(inputAttachment);
+    }
+    combineStructureHash(initArgs._viewportSize.x);
+    combineStructureHash(initArgs._viewportSize.y);
+    combineStructureHash(initArgs._clearFlags);
+    combineStructureHash(initArgs._writableAttachment);
+    combineStructureHash(initArgs._numSamples);
+    combineStructureHash(initArgs._useSecondaryCommandBuffers);
+
     return static_cast<RenderPassNode*>(_currentPassNode)->declareRenderPass(_frameGraph, this, std::move(passName), std::move(initArgs));
 }
 
-FrameGraph::FrameGraph()
+FrameGraph::FrameGraph() : _frameArena(FRAME_ARENA_BLOCK_SIZE)
+{
+    _dependencyGraph.setArenaAllocator(&_frameArena);
+}
+
+void FrameGraphBuilder::setSideEffectPass()
 {
+    combineStructureHash(UINT32_MAX);
+    _currentPassNode->setSideEffectPass();
+}
+
+void FrameGraphBuilder::setQueueAffinity(CommandStreamUsage queueAffinity)
+{
+    VOX_ASSERT(static_cast<uint32_t>(queueAffinity) < NUM_COMMAND_QUEUE_TYPES, "Pass can only prefer graphics, compute or transfer queue");
+
+    combineStructureHash(queueAffinity);
+    _currentPassNode->setQueueAffinity(queueAffinity);
+}
+
+void FrameGraphBuilder::setEnablePredicate(std::function<bool()>&& enablePredicate)
+{
+    // Only the presence of predicate is structural, as predicated pass is never merged with the other passes
+    combineStructureHash(true);
+    _currentPassNode->setEnablePredicate(std::move(enablePredicate));
 }
 
 FrameGraph::~FrameGraph()
 {
+    clear();
 }
 
 void FrameGraph::reset(CommandStream* cmdStream, RenderResourceAllocator* renderResourceAllocator)
 {
     clear();
 
-    _cmdStream = cmdStream;
+    _cmdStreams[static_cast<uint32_t>(CommandStreamUsage::Graphics)] = cmdStream;
     _renderResourceAllocator = renderResourceAllocator;
+    ++_frameIndex;
 }
 
-ResourceHandle FrameGraph::importRenderTarget(std::string&& resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs,
+void FrameGraph::setAsyncCommandStream(CommandStreamUsage queueAffinity, CommandStream* cmdStream)
+{
+    VOX_ASSERT((queueAffinity == CommandStreamUsage::Compute) || (queueAffinity == CommandStreamUsage::Transfer),
+               "Graphics command stream must be given at reset");
+
+    _cmdStreams[static_cast<uint32_t>(queueAffinity)] = cmdStream;
+}
+
+ResourceHandle FrameGraph::importRenderTarget(std::string_view resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs,
                                               typename FrameGraphRenderPass::ImportedDescriptor&& importedDesc, TextureView* textureView)
 {
-    VirtualResource* virtualResource = new ImportedRenderTarget(std::move(resourceName), std::move(resourceDescArgs), std::move(importedDesc), {}, textureView);
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "Resource({}) must not be imported until declaration scopes are merged", resourceName);
 
-    ResourceHandle resourceHandle(_resources.size());
+    // Imported texture view may differ every frame (e.g. swapchain back buffer) while the structure is same
+    combineStructureHash(resourceName);
+    combineStructureHash(resourceDescArgs);
+    combineStructureHash(importedDesc._attachmentSlot);
+    combineStructureHash(importedDesc._clearFlags);
+    combineStructureHash(importedDesc._writableAttachment);
 
-    _resourceSlots.push_back({ ._resourceIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size()),
-                               ._nodeIndex = static_cast<ResourceSlot::IndexType>(_resources.size()),
+    VirtualResource* virtualResource = _frameArena.construct<ImportedRenderTarget>(_frameArena.copyString(resourceName), std::move(resourceDescArgs),
+                                                                                   std::move(importedDesc), FrameGraphTexture{}, textureView);
+
+    ResourceHandle resourceHandle(_resourceSlots.size());
+
+    _resourceSlots.push_back({ ._resourceIndex = static_cast<ResourceSlot::IndexType>(_resources.size()),
+                               ._nodeIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size()),
                                ._version = static_cast<ResourceSlot::VersionType>(0) });
     _resources.push_back(virtualResource);
 
-    ResourceNode* resourceNode = new ResourceNode(&_dependencyGraph, resourceHandle);
+    ResourceNode* resourceNode = _frameArena.construct<ResourceNode>(&_dependencyGraph, resourceHandle);
     resourceNode->_refCount = UINT32_MAX;
 
     _resourceNodes.push_back(resourceNode);
@@ -53,6 +118,195 @@ ResourceHandle FrameGraph::importRenderTarget(std::string&& resourceName, FrameG
     return resourceHandle;
 }
 
+FrameGraph::HistoryHandles FrameGraph::createHistory(std::string_view resourceName, FrameGraphTexture::Descriptor&& resourceDescArgs,
+                                                     const TextureUsage usage)
+{
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "History({}) must not be created until declaration scopes are merged", resourceName);
+
+    combineStructureHash(resourceName);
+    combineStructureHash(resourceDescArgs);
+    combineStructureHash(usage);
+
+    auto storageIter = _historyTextureStorages.find(resourceName);
+    if (storageIter == _historyTextureStorages.end())
+    {
+        storageIter = _historyTextureStorages.emplace(std::string(resourceName), HistoryTextureStorage()).first;
+        storageIter->second._historyName = fmt::format("{} History", resourceName);
+    }
+
+    // Names are kept in the storage rather than the frame arena as they are same every frame
+    const std::string& currentName = storageIter->first;
+    HistoryTextureStorage& storage = storageIter->second;
+    VOX_ASSERT(storage._lastDeclaredFrameIndex != _frameIndex, "History({}) must be declared at most once per frame", resourceName);
+
+    const bool isStorageChanged = (storage._descriptor != resourceDescArgs) || (storage._usage != usage);
+    if (isStorageChanged)
+    {
+        storage._descriptor = resourceDescArgs;
+        storage._usage = usage;
+        storage._isAllocationDirty = true;
+    }
+
+    // Textures stay virtual without resource allocator, so that there is no allocation to lose
+    const bool isAllocated = (storage._isAllocationDirty == false) || (_renderResourceAllocator == nullptr);
+    const bool isDeclaredInPreviousFrame = (storage._lastDeclaredFrameIndex != UINT64_MAX) && (storage._lastDeclaredFrameIndex + 1 == _frameIndex);
+    const bool isHistoryValid = isDeclaredInPreviousFrame && (isStorageChanged == false) && isAllocated;
+
+    // Texture written in the previous frame becomes history of this frame
+    storage._currentIndex ^= 1;
+    storage._lastDeclaredFrameIndex = _frameIndex;
+
+    HistoryTexture* currentTexture =
+        _frameArena.construct<HistoryTexture>(currentName, FrameGraphTexture::Descriptor(resourceDescArgs), &storage, storage._currentIndex);
+    HistoryTexture* historyTexture =
+        _frameArena.construct<HistoryTexture>(storage._historyName, std::move(resourceDescArgs), &storage, storage._currentIndex ^ 1);
+    currentTexture->setPairedTexture(historyTexture);
+    historyTexture->setPairedTexture(currentTexture);
+
+    const auto addResource = [this](VirtualResource* virtualResource) {
+        ResourceHandle resourceHandle(_resourceSlots.size());
+
+        _resourceSlots.push_back({ ._resourceIndex = static_cast<ResourceSlot::IndexType>(_resources.size()),
+                                   ._nodeIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size()),
+                                   ._version = static_cast<ResourceSlot::VersionType>(0) });
+        _resources.push_back(virtualResource);
+        _resourceNodes.push_back(_frameArena.construct<ResourceNode>(&_dependencyGraph, resourceHandle));
+
+        return resourceHandle;
+    };
+
+    HistoryHandles historyHandles{ ._current = addResource(currentTexture), ._history = addResource(historyTexture), ._isHistoryValid = isHistoryValid };
+
+    // Current texture is read in the next frame, so it is never culled like imported one
+    _resourceNodes[getResourceSlot(historyHandles._current)._nodeIndex]->_refCount = UINT32_MAX;
+
+    return historyHandles;
+}
+
+FrameGraphDeclarationScope::FrameGraphDeclarationScope(FrameGraph* frameGraph) : _frameGraph(frameGraph), _arena(FRAME_ARENA_BLOCK_SIZE)
+{
+}
+
+void FrameGraphDeclarationScope::begin(const uint32_t scopeIndex, const uint32_t resourceHandleBase, const uint32_t resourceIndexBase)
+{
+    _blackBoard.clear();
+    _precedingScopes.clear();
+    _passNodes.clear();
+    _connections.clear();
+    _scopeIndex = scopeIndex;
+    _resourceHandleBase = resourceHandleBase;
+    _resourceIndexBase = resourceIndexBase;
+    _numResources = 0;
+    _structureHash = 0;
+}
+
+void FrameGraphDeclarationScope::addPrecedingScope(const FrameGraphDeclarationScope* scope)
+{
+    VOX_ASSERT(scope->_scopeIndex < _scopeIndex, "Preceding scope({}) must be merged before this scope({})", scope->_scopeIndex, _scopeIndex);
+    _precedingScopes.push_back(scope);
+}
+
+ResourceHandle FrameGraphDeclarationScope::getHandle(BlackBoardKey key) const
+{
+    ResourceHandle handle = _blackBoard.getHandle(key);
+    for (auto iter = _precedingScopes.rbegin(); (handle == INVALID_RESOURCE_HANDLE) && (iter != _precedingScopes.rend()); ++iter)
+    {
+        handle = (*iter)->getHandle(key);
+    }
+
+    // Blackboard of frame graph is not modified while the scopes are open
+    return (handle == INVALID_RESOURCE_HANDLE) ? _frameGraph->getBlackBoard().getHandle(key) : handle;
+}
+
+void FrameGraph::beginConcurrentDeclaration(const uint32_t numScopes)
+{
+    VOX_ASSERT(_numOpenDeclarationScopes == 0, "Declaration scopes must be merged before opening new ones");
+    VOX_ASSERT(numScopes > 0, "At least one declaration scope must be opened");
+
+    while (_declarationScopes.size() < numScopes)
+    {
+        _declarationScopes.emplace_back(std::make_unique<FrameGraphDeclarationScope>(this));
+    }
+
+    // Reserve resource slots for each scope up front, as the vectors must not grow while scopes are declared concurrently
+    const uint32_t resourceHandleBase = static_cast<uint32_t>(_resourceSlots.size());
+    const uint32_t resourceIndexBase = static_cast<uint32_t>(_resources.size());
+    _resourceSlots.resize(resourceHandleBase + numScopes * MAX_DECLARATION_SCOPE_RESOURCES);
+    _resources.resize(resourceIndexBase + numScopes * MAX_DECLARATION_SCOPE_RESOURCES, nullptr);
+
+    for (uint32_t i = 0; i < numScopes; ++i)
+    {
+        _declarationScopes[i]->begin(i, resourceHandleBase + i * MAX_DECLARATION_SCOPE_RESOURCES, resourceIndexBase + i * MAX_DECLARATION_SCOPE_RESOURCES);
+    }
+
+    _numOpenDeclarationScopes = numScopes;
+}
+
+FrameGraphDeclarationScope* FrameGraph::getDeclarationScope(const uint32_t scopeIndex)
+{
+    VOX_ASSERT(scopeIndex < _numOpenDeclarationScopes, "Declaration scope({}) is not opened", scopeIndex);
+    return _declarationScopes[scopeIndex].get();
+}
+
+void FrameGraph::endConcurrentDeclaration()
+{
+    SCOPED_CHROME_TRACING("FrameGraph::endConcurrentDeclaration");
+
+    VOX_ASSERT(_numOpenDeclarationScopes > 0, "Declaration scopes must be opened before merging them");
+
+    const uint32_t numScopes = _numOpenDeclarationScopes;
+    _numOpenDeclarationScopes = 0;
+
+    // Pack resources of the scopes into the reserved range, and create their nodes before connecting any pass,
+    // as pass may access resources declared by the other scopes
+    const uint32_t resourceIndexBase = _declarationScopes[0]->_resourceIndexBase;
+    const std::vector<VirtualResource*> reservedResources(_resources.begin() + resourceIndexBase, _resources.end());
+    _resources.resize(resourceIndexBase);
+
+    for (uint32_t i = 0; i < numScopes; ++i)
+    {
+        const FrameGraphDeclarationScope* scope = _declarationScopes[i].get();
+        for (uint32_t k = 0; k < scope->_numResources; ++k)
+        {
+            const ResourceHandle resourceHandle(scope->_resourceHandleBase + k);
+
+            ResourceSlot& resourceSlot = getResourceSlot(resourceHandle);
+            resourceSlot._resourceIndex = static_cast<ResourceSlot::IndexType>(_resources.size());
+            resourceSlot._nodeIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size());
+
+            _resources.push_back(reservedResources[scope->_resourceIndexBase - resourceIndexBase + k]);
+            _resourceNodes.push_back(_frameArena.construct<ResourceNode>(&_dependencyGraph, resourceHandle));
+        }
+    }
+
+    for (uint32_t i = 0; i < numScopes; ++i)
+    {
+        FrameGraphDeclarationScope* scope = _declarationScopes[i].get();
+
+        combineStructureHash(scope->_structureHash);
+
+        for (PassNode* passNode : scope->_passNodes)
+        {
+            _dependencyGraph.adoptNode(passNode);
+            _passNodes.push_back(passNode);
+        }
+
+        for (const FrameGraphDeclarationScope::DeferredConnection& connection : scope->_connections)
+        {
+            if (connection._isWrite)
+            {
+                writeInternal(connection._resourceHandle, connection._passNode, connection._usage);
+            }
+            else
+            {
+                readInternal(connection._resourceHandle, connection._passNode, connection._usage);
+            }
+        }
+
+        _blackBoard.merge(scope->_blackBoard);
+    }
+}
+
 bool FrameGraph::compile()
 {
     SCOPED_CHROME_TRACING("FrameGraph::compile");
@@ -81,9 +335,34 @@ bool FrameGraph::compile()
 
 #elif defined(FRAMEGRAPH_CULLING_ONLY)
 
+    if (replayCompileCache())
+    {
+        ++_compileCacheStats._numHits;
+        return true;
+    }
+    ++_compileCacheStats._numMisses;
+
     _dependencyGraph.cullUnreferencedNodes();
 
-    _passNodeLast = std::stable_partition(_passNodes.begin(), _passNodes.end(), [](PassNode* node) { return node->isCulled() == false; });
+    partitionLivePassNodes();
+
+    const uint32_t numLivePassNodes = static_cast<uint32_t>(std::distance(_passNodes.begin(), _passNodeLast));
+
+    buildAdjacencyLists(numLivePassNodes);
+
+    if (bool isCycleExist = topologicalSortPassNodes(numLivePassNodes))
+    {
+        VOX_ASSERT(isCycleExist == false, "The cyclic dependency is detected");
+        return false;
+    }
+
+    calcDependencyLevels(numLivePassNodes);
+
+    buildExecutionBatches(numLivePassNodes);
+
+    applyExecutionOrder();
+
+    allotCommandQueueIndices(numLivePassNodes);
 
     for (auto it = _passNodes.begin(); it != _passNodeLast; ++it)
     {
@@ -91,15 +370,13 @@ bool FrameGraph::compile()
 
         VOX_ASSERT(passNode->isCulled() == false, "There must not be culled nodes after culling");
 
-        DependencyGraph::EdgeContainer reads = _dependencyGraph.getIncomingEdges(passNode->getNodeID());
-        for (const DependencyGraph::Edge* edge : reads)
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
         {
             DependencyGraph::Node* node = _dependencyGraph.getNode(edge->_fromNodeID);
             passNode->registerResource(this, static_cast<ResourceNode*>(node)->getResourceHandle());
         }
 
-        DependencyGraph::EdgeContainer writes = _dependencyGraph.getOutgoingEdges(passNode->getNodeID());
-        for (const DependencyGraph::Edge* edge : writes)
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
         {
             DependencyGraph::Node* node = _dependencyGraph.getNode(edge->_toNodeID);
             passNode->registerResource(this, static_cast<ResourceNode*>(node)->getResourceHandle());
@@ -125,6 +402,22 @@ bool FrameGraph::compile()
         resourceNode->resolveResourceUsage(this);
     }
 
+    inferAttachmentOperations(numLivePassNodes);
+
+    mergeSubpasses(numLivePassNodes);
+
+    markTransientAttachments(numLivePassNodes);
+
+    buildQueueOwnershipTransfers(numLivePassNodes);
+
+    buildSSIS(numLivePassNodes);
+
+    calcResourceLifetimes(numLivePassNodes);
+
+    allotTransientMemorySlots();
+
+    recordCompileCache();
+
 #else
 
 #endif
@@ -132,7 +425,7 @@ bool FrameGraph::compile()
     return true;
 }
 
-ResourceHandle FrameGraph::readInternal(ResourceHandle id, [[maybe_unused]] PassNode* passNode, std::function<bool(ResourceNode*, VirtualResource*)>&& connect)
+ResourceHandle FrameGraph::readInternal(ResourceHandle id, PassNode* passNode, const uint32_t usage)
 {
     VOX_ASSERT(id < static_cast<ResourceHandle>(_resourceSlots.size()), "Invalid ResourceHandle({}) is given", id.get());
 
@@ -141,8 +434,7 @@ ResourceHandle FrameGraph::readInternal(ResourceHandle id, [[maybe_unused]] Pass
     VirtualResource* vResource = _resources[resourceSlot._resourceIndex];
 
 #if defined(VOXFLOW_DEBUG)
-    DependencyGraph::EdgeContainer incomingEdges = _dependencyGraph.getIncomingEdges(resourceNode->getNodeID());
-    for (const DependencyGraph::Edge* edge : incomingEdges)
+    for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(resourceNode->getNodeID()))
     {
         if (edge->_fromNodeID == passNode->getNodeID())
         {
@@ -151,7 +443,7 @@ ResourceHandle FrameGraph::readInternal(ResourceHandle id, [[maybe_unused]] Pass
     }
 #endif  // VOXFLOW_DEBUG
 
-    if (connect(resourceNode, vResource))
+    if (vResource->connectUsage(&_dependencyGraph, resourceNode, passNode, usage, false))
     {
         // TODO(snowapril) : add post-jobs after connecting two nodes
     }
@@ -161,43 +453,44 @@ ResourceHandle FrameGraph::readInternal(ResourceHandle id, [[maybe_unused]] Pass
     return id;
 }
 
-ResourceHandle FrameGraph::writeInternal(ResourceHandle id, PassNode* passNode, std::function<bool(ResourceNode*, VirtualResource*)>&& connect)
+ResourceHandle FrameGraph::writeInternal(ResourceHandle id, PassNode* passNode, const uint32_t usage)
 {
     VOX_ASSERT(id < static_cast<ResourceHandle>(_resourceSlots.size()), "Invalid ResourceHandle({}) is given", id.get());
 
-    const ResourceSlot& resourceSlot = getResourceSlot(id);
+    ResourceSlot& resourceSlot = getResourceSlot(id);
     VirtualResource* vResource = _resources[resourceSlot._resourceIndex];
     ResourceNode* resourceNode = _resourceNodes[resourceSlot._nodeIndex];
-    // const DependencyGraph::NodeID resourceNodeID = resourceNode->getNodeID();
-
-    DependencyGraph::EdgeContainer outgoingEdges = _dependencyGraph.getOutgoingEdges(passNode->getNodeID());
-
-    // bool alreadyWritten = false;
-    // for (const DependencyGraph::Edge* edge : outgoingEdges)
-    //{
-    //     if (edge->_toNodeID == resourceNodeID)
-    //     {
-    //         alreadyWritten = true;
-    //         break;
-    //     }
-    // }
-    //
-    // if (alreadyWritten)
-    //{
-    //     // TODO(snowapril) : update resource usage or something else
-    // }
-    // else
-    //{
-    //     _dependencyGraph.link(passNode->getNodeID(), resourceNode->getNodeID());
-    // }
-
-    if (connect(resourceNode, vResource))
+
+    VOX_ASSERT(vResource->isReadOnly() == false, "Read-only resource({}) must not be written", vResource->getResourceName());
+
+    // Writing the version already accessed by the other passes produces a new version of the resource. Write which
+    // is overwritten before being read can be culled, and passes are ordered only against versions they touch.
+    // The handle keeps pointing the latest version, thus passes declared later access the written content.
+    const bool isAccessedBefore = resourceNode->hasWriterPass() || resourceNode->hasReaderPasses();
+    if (isAccessedBefore && (resourceNode->getWriterEdgeForPassNode(passNode) == nullptr))
+    {
+        VOX_ASSERT(resourceSlot._version < UINT8_MAX - 1, "Too many versions of resource({}) are written", vResource->getResourceName());
+
+        ResourceNode* newVersionNode = _frameArena.construct<ResourceNode>(&_dependencyGraph, id, resourceNode);
+        if (vResource->isPersistent())
+        {
+            newVersionNode->_refCount = UINT32_MAX;
+        }
+
+        resourceSlot._nodeIndex = static_cast<ResourceSlot::IndexType>(_resourceNodes.size());
+        ++resourceSlot._version;
+        _resourceNodes.push_back(newVersionNode);
+
+        resourceNode = newVersionNode;
+    }
+
+    if (vResource->connectUsage(&_dependencyGraph, resourceNode, passNode, usage, true))
     {
         // TODO(snowapril) : add post-jobs after connecting two nodes
     }
 
-    // If the given pass is writing to imported resource, it must not be culled.
-    if (vResource->isImported())
+    // If the given pass is writing to resource which outlives the frame, it must not be culled.
+    if (vResource->isPersistent())
     {
         passNode->setSideEffectPass();
     }
@@ -211,24 +504,61 @@ void FrameGraph::buildAdjacencyLists(const uint32_t numPassNodes)
 
     _passNodeAdjacencyList.resize(numPassNodes);
 
-    // Build pass node adjacency list
+    // Map dependency graph node id to index of pass node for degree-proportional lookup
+    std::vector<uint32_t> passNodeIndices(_dependencyGraph.getNumNodes(), UINT32_MAX);
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        passNodeIndices[_passNodes[i]->getNodeID()] = i;
+    }
+
+    // Build pass node adjacency list by following pass -> resource -> pass edges
     for (uint32_t i = 0; i < numPassNodes; ++i)
     {
         std::vector<uint32_t>& singleAdjacencyList = _passNodeAdjacencyList[i];
 
-        for (uint32_t j = 0; j < numPassNodes; ++j)
+        for (const DependencyGraph::Edge* writeEdge : _dependencyGraph.getOutgoingEdges(_passNodes[i]->getNodeID()))
         {
-            if (i == j)
-                continue;
-
-            for (const DependencyGraph::Edge* writeEdge : _dependencyGraph.getOutgoingEdges(_passNodes[i]->getNodeID()))
+            for (const DependencyGraph::Edge* readEdge : _dependencyGraph.getOutgoingEdges(writeEdge->_toNodeID))
             {
-                for (const DependencyGraph::Edge* readEdge : _dependencyGraph.getIncomingEdges(_passNodes[j]->getNodeID()))
+                const uint32_t j = passNodeIndices[readEdge->_toNodeID];
+                if ((j != UINT32_MAX) && (i != j))
                 {
-                    if (writeEdge->_toNodeID == readEdge->_fromNodeID)
+                    singleAdjacencyList.emplace_back(j);
+                }
+            }
+
+            // Writer of the new version must wait for live passes accessing the previous versions of the
+            // same resource. Versions whose readers and writer are all culled impose no ordering.
+            const ResourceNode* resourceNode = static_cast<const ResourceNode*>(_dependencyGraph.getNode(writeEdge->_toNodeID));
+            for (const ResourceNode* previousNode = resourceNode->getPreviousVersionNode(); previousNode != nullptr;
+                 previousNode = previousNode->getPreviousVersionNode())
+            {
+                bool isAccessedByLivePass = false;
+                const auto addOrderingEdge = [&](const DependencyGraph::NodeID accessorNodeID) {
+                    const uint32_t j = passNodeIndices[accessorNodeID];
+                    if (j != UINT32_MAX)
                     {
-                        singleAdjacencyList.emplace_back(j);
+                        isAccessedByLivePass = true;
+                        if (i != j)
+                        {
+                            _passNodeAdjacencyList[j].emplace_back(i);
+                        }
                     }
+                };
+
+                for (const DependencyGraph::Edge* readEdge : _dependencyGraph.getOutgoingEdges(previousNode->getNodeID()))
+                {
+                    addOrderingEdge(readEdge->_toNodeID);
+                }
+                for (const DependencyGraph::Edge* previousWriteEdge : _dependencyGraph.getIncomingEdges(previousNode->getNodeID()))
+                {
+                    addOrderingEdge(previousWriteEdge->_fromNodeID);
+                }
+
+                // Accesses to the older versions are already ordered before the live accessors of this version
+                if (isAccessedByLivePass)
+                {
+                    break;
                 }
             }
         }
@@ -239,49 +569,62 @@ bool FrameGraph::topologicalSortPassNodes(const uint32_t numPassNodes)
 {
     SCOPED_CHROME_TRACING("FrameGraph::topologicalSortPassNodes");
 
+    _topologicalSortedPassNodes.clear();
     _topologicalSortedPassNodes.reserve(numPassNodes);
 
     std::vector<bool> permanentMarks(numPassNodes, false);
     std::vector<bool> temporaryMarks(numPassNodes, false);
 
-    bool isCycleExist = false;
-    std::function<void(uint32_t)> dfs = [&](uint32_t nodeIndex) {
-        if (permanentMarks[nodeIndex])
-        {
-            return;
-        }
+    // Explicit stack of (node, index of next adjacent node to visit) so that long chains of passes
+    // do not recurse as deep as the chain length
+    std::vector<std::pair<uint32_t, uint32_t>> dfsStack;
+    dfsStack.reserve(numPassNodes);
 
-        if (temporaryMarks[nodeIndex])
+    bool isCycleExist = false;
+    for (uint32_t i = 0; (i < numPassNodes) && (isCycleExist == false); ++i)
+    {
+        if (permanentMarks[i])
         {
-            isCycleExist = true;
-            return;
+            continue;
         }
 
-        temporaryMarks[nodeIndex] = true;
+        temporaryMarks[i] = true;
+        dfsStack.emplace_back(i, 0);
 
-        for (uint32_t connectedNode : _passNodeAdjacencyList[nodeIndex])
+        while (dfsStack.empty() == false)
         {
-            dfs(connectedNode);
-        }
+            auto& [nodeIndex, adjacentIndex] = dfsStack.back();
+            const std::vector<uint32_t>& adjacentNodes = _passNodeAdjacencyList[nodeIndex];
 
-        temporaryMarks[nodeIndex] = false;
-        permanentMarks[nodeIndex] = true;
-        _topologicalSortedPassNodes.emplace_back(nodeIndex);
-    };
+            if (adjacentIndex == adjacentNodes.size())
+            {
+                temporaryMarks[nodeIndex] = false;
+                permanentMarks[nodeIndex] = true;
+                _topologicalSortedPassNodes.emplace_back(nodeIndex);
+                dfsStack.pop_back();
+                continue;
+            }
 
-    for (uint32_t i = 0; i < numPassNodes; ++i)
-    {
-        if (permanentMarks[i] == false)
-        {
-            dfs(i);
+            const uint32_t connectedNode = adjacentNodes[adjacentIndex++];
+            if (permanentMarks[connectedNode])
+            {
+                continue;
+            }
 
-            if (isCycleExist)
+            if (temporaryMarks[connectedNode])
             {
+                isCycleExist = true;
                 break;
             }
+
+            temporaryMarks[connectedNode] = true;
+            dfsStack.emplace_back(connectedNode, 0);
         }
     }
 
+    // Depth first search emits post-order, so reverse it to place producers before consumers
+    std::reverse(_topologicalSortedPassNodes.begin(), _topologicalSortedPassNodes.end());
+
     return isCycleExist;
 }
 
@@ -289,117 +632,1460 @@ void FrameGraph::calcDependencyLevels(const uint32_t numPassNodes)
 {
     SCOPED_CHROME_TRACING("FrameGraph::calcDependencyLevels");
 
-    _dependencyLevels.resize(numPassNodes);
+    _dependencyLevels.clear();
 
-    static std::vector<int32_t> sDistances;
-    sDistances.resize(numPassNodes);
-    std::fill(sDistances.begin(), sDistances.end(), INT32_MIN);
+    if (numPassNodes == 0)
+    {
+        return;
+    }
 
-    const uint32_t startNodeIndex = _topologicalSortedPassNodes.front();
-    sDistances[startNodeIndex] = 0;
+    // Dependency level of each pass is the length of the longest path from any root pass
+    std::vector<uint32_t> distances(numPassNodes, 0);
 
-    int32_t maxDistances = 0;
+    uint32_t maxDistance = 0;
     for (uint32_t nodeIndex : _topologicalSortedPassNodes)
     {
         for (uint32_t connectedNodeIndex : _passNodeAdjacencyList[nodeIndex])
         {
-            if (sDistances[connectedNodeIndex] < sDistances[nodeIndex] + 1)
+            if (distances[connectedNodeIndex] < distances[nodeIndex] + 1)
             {
-                sDistances[connectedNodeIndex] = sDistances[nodeIndex] + 1;
-                maxDistances = std::max(maxDistances, sDistances[connectedNodeIndex]);
+                distances[connectedNodeIndex] = distances[nodeIndex] + 1;
+                maxDistance = std::max(maxDistance, distances[connectedNodeIndex]);
             }
         }
     }
 
-    _dependencyLevels.resize(maxDistances);
+    _dependencyLevels.resize(maxDistance + 1);
     for (uint32_t nodeIndex : _topologicalSortedPassNodes)
     {
-        const uint32_t distance = sDistances[nodeIndex];
-        _dependencyLevels[distance].push_back(nodeIndex);
+        _dependencyLevels[distances[nodeIndex]].push_back(nodeIndex);
     }
 }
 
-void FrameGraph::allotCommandQueueIndices(const uint32_t numPassNodes)
+void FrameGraph::buildExecutionBatches(const uint32_t numPassNodes)
 {
-    SCOPED_CHROME_TRACING("FrameGraph::allotCommandQueueIndices");
-    // for (uint32_t nodeIndex : _topologicalSortedPassNodes)
-    // {
-    //     _commandQueueIndices
-    // }
+    SCOPED_CHROME_TRACING("FrameGraph::buildExecutionBatches");
+
+    _executionOrder.clear();
+    _executionOrder.reserve(numPassNodes);
+    _executionBatchOffsets.assign(1, 0);
+
+    // Passes in the same dependency level never depend on each other, but they may still read
+    // the same resource whose barrier state must be updated in order. Such passes are split
+    // into separate batches so that passes in a batch can be recorded on different threads.
+    // Submission pass always takes a whole batch as it flushes commands of the other passes.
+    // Marks are kept per resource rather than per version node as all versions share the barrier state.
+    std::vector<uint32_t> resourceBatchMarks(_resources.size(), UINT32_MAX);
+
+    const auto isResourceMarked = [&](const PassNode* passNode, const uint32_t batchIndex) {
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            if (resourceBatchMarks[getResourceIndex(edge->_fromNodeID)] == batchIndex)
+            {
+                return true;
+            }
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            if (resourceBatchMarks[getResourceIndex(edge->_toNodeID)] == batchIndex)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const auto markResources = [&](const PassNode* passNode, const uint32_t batchIndex) {
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            resourceBatchMarks[getResourceIndex(edge->_fromNodeID)] = batchIndex;
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            resourceBatchMarks[getResourceIndex(edge->_toNodeID)] = batchIndex;
+        }
+    };
+
+    std::vector<uint32_t> remainingPassIndices;
+    std::vector<uint32_t> deferredPassIndices;
+    for (const std::vector<uint32_t>& dependencyLevel : _dependencyLevels)
+    {
+        // Keep declaration order in the level for deterministic submission order
+        remainingPassIndices.assign(dependencyLevel.begin(), dependencyLevel.end());
+        std::sort(remainingPassIndices.begin(), remainingPassIndices.end());
+
+        while (remainingPassIndices.empty() == false)
+        {
+            const uint32_t batchIndex = static_cast<uint32_t>(_executionBatchOffsets.size() - 1);
+
+            const uint32_t batchBegin = static_cast<uint32_t>(_executionOrder.size());
+            bool isBatchClosed = false;
 
-    // TODO(snowapril) : at now, only consider single queue.
-    // As resource transition from one queue to the other queue should be
-    // accompanied by queue ownership transfer, there are plenty of things
-    // to consider for minimizing synchronizations
+            deferredPassIndices.clear();
+            for (uint32_t passIndex : remainingPassIndices)
+            {
+                const PassNode* passNode = _passNodes[passIndex];
+                const bool isSubmissionPass = passNode->isSubmissionPass();
+                if (isBatchClosed || (isSubmissionPass && (_executionOrder.size() > batchBegin)) || isResourceMarked(passNode, batchIndex))
+                {
+                    deferredPassIndices.push_back(passIndex);
+                    continue;
+                }
+
+                markResources(passNode, batchIndex);
+                _executionOrder.push_back(passIndex);
+                isBatchClosed = isSubmissionPass;
+            }
+
+            _executionBatchOffsets.push_back(static_cast<uint32_t>(_executionOrder.size()));
+            remainingPassIndices.swap(deferredPassIndices);
+        }
+    }
 
-    _commandQueueIndices.resize(numPassNodes, 0);
+    VOX_ASSERT(_executionOrder.size() == numPassNodes, "All live pass nodes must be placed in execution batches");
 }
 
-void FrameGraph::calcResourceLifetimes(const uint32_t numPassNodes)
+void FrameGraph::partitionLivePassNodes()
 {
-    (void)numPassNodes;
+    // Same as std::stable_partition, but through the scratch buffer instead of temporary one allocated every call
+    _scratchPassNodes.assign(_passNodes.begin(), _passNodes.end());
+
+    auto passNodeIter = std::copy_if(_scratchPassNodes.begin(), _scratchPassNodes.end(), _passNodes.begin(),
+                                     [](PassNode* node) { return node->isCulled() == false; });
+    _passNodeLast = passNodeIter;
+    std::copy_if(_scratchPassNodes.begin(), _scratchPassNodes.end(), passNodeIter, [](PassNode* node) { return node->isCulled(); });
 }
 
-void FrameGraph::buildSSIS(const uint32_t numPassNodes)
+void FrameGraph::applyExecutionOrder()
 {
-    SCOPED_CHROME_TRACING("FrameGraph::buildSSIS");
-    (void)numPassNodes;
+    _scratchPassNodes.assign(_passNodes.begin(), _passNodeLast);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(_scratchPassNodes.size()); ++i)
+    {
+        _passNodes[i] = _scratchPassNodes[_executionOrder[i]];
+    }
 }
 
-void FrameGraph::execute()
+void FrameGraph::allotCommandQueueIndices(const uint32_t numPassNodes)
 {
-    SCOPED_CHROME_TRACING("FrameGraph::execute");
+    SCOPED_CHROME_TRACING("FrameGraph::allotCommandQueueIndices");
 
-    for (std::vector<PassNode*>::iterator iter = _passNodes.begin(); iter != _passNodeLast; ++iter)
+    _commandQueueIndices.resize(numPassNodes);
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
     {
-        PassNode* passNode = *iter;
+        const PassNode* passNode = _passNodes[i];
+        uint32_t queueIndex = static_cast<uint32_t>(passNode->getQueueAffinity());
 
-        for (VirtualResource* resource : passNode->getDevirtualizes())
+        // Resources outliving the frame such as swapchain back buffer are owned by graphics queue
+        // and can not be transferred to the other queue.
+        const auto isImportedResource = [this](DependencyGraph::NodeID resourceNodeID) {
+            return _resources[getResourceIndex(resourceNodeID)]->isPersistent();
+        };
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
         {
-            resource->devirtualize(_renderResourceAllocator);
+            if (isImportedResource(edge->_fromNodeID))
+            {
+                queueIndex = static_cast<uint32_t>(CommandStreamUsage::Graphics);
+            }
         }
-
-        FrameGraphResources resources(this, passNode);
-
-        passNode->execute(&resources, _cmdStream);
-
-        for (VirtualResource* resource : passNode->getDestroyes())
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
         {
-            resource->destroy(_renderResourceAllocator);
+            if (isImportedResource(edge->_toNodeID))
+            {
+                queueIndex = static_cast<uint32_t>(CommandStreamUsage::Graphics);
+            }
         }
+
+        _commandQueueIndices[i] = queueIndex;
     }
 }
 
-void FrameGraph::clear()
+static AttachmentMaskFlags getColorAttachmentMask(const uint32_t slot)
 {
-    // TODO(snowapril) : clear and re-record only modified pass.
-    _passNodes.clear();
-    _resourceNodes.clear();
-    _resources.clear();
-    _passNodeAdjacencyList.clear();
-    _topologicalSortedPassNodes.clear();
-    _dependencyLevels.clear();
-    _commandQueueIndices.clear();
+    return static_cast<AttachmentMaskFlags>(static_cast<uint32_t>(AttachmentMaskFlags::Color0) << slot);
 }
 
-class AlphabetPermutator
+// Whether the given texture usage accesses texture only as attachment of render pass
+static bool isAttachmentOnlyUsage(const uint32_t usage)
 {
- public:
-    explicit AlphabetPermutator(uint32_t numNodes)
-    {
-        constexpr uint32_t numLowerAlphabets = 'z' - 'a' + 1;
-        uint32_t numPermutationIndex = 0;
-        while (numNodes > 0)
+    const uint32_t attachmentUsages =
+        static_cast<uint32_t>(TextureUsage::RenderTarget | TextureUsage::DepthStencil | TextureUsage::BackBuffer | TextureUsage::InputAttachment);
+    return (usage & ~attachmentUsages) == 0;
+}
+
+// Copy clear, load and store flags of the attachment in source slot to the destination slot
+static void copyAttachmentFlags(RenderPassFlags& dstFlags, const AttachmentMaskFlags dstMask, const RenderPassFlags& srcFlags,
+                                const AttachmentMaskFlags srcMask)
+{
+    const auto copyFlag = [&](AttachmentMaskFlags& dstFlag, const AttachmentMaskFlags srcFlag) {
+        if (static_cast<uint32_t>(srcFlag & srcMask) > 0)
         {
-            numNodes /= numLowerAlphabets;
-            ++numPermutationIndex;
+            dstFlag |= dstMask;
         }
-        _permutationIndices.resize(numPermutationIndex, 0);
-    }
+    };
+    copyFlag(dstFlags._clearFlags, srcFlags._clearFlags);
+    copyFlag(dstFlags._loadFlags, srcFlags._loadFlags);
+    copyFlag(dstFlags._storeFlags, srcFlags._storeFlags);
+}
 
-    std::string getNextAlphabetPermutation()
-    {
-        std::string alphabetPermutation;
+void FrameGraph::mergeSubpasses(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::mergeSubpasses");
+
+    _subpassIndices.assign(numPassNodes, 0);
+
+    std::vector<uint32_t> passBatchIndices(numPassNodes);
+    for (uint32_t batchIndex = 0; batchIndex < getNumExecutionBatches(); ++batchIndex)
+    {
+        for (uint32_t i = _executionBatchOffsets[batchIndex]; i < _executionBatchOffsets[batchIndex + 1]; ++i)
+        {
+            passBatchIndices[i] = batchIndex;
+        }
+    }
+
+    // Render pass can not span command buffers, so only passes recorded alone in their batch on
+    // graphics queue are merged. Predicated pass may be skipped at execute, so it keeps its own render pass.
+    const auto getMergeableRenderPassData = [&](const uint32_t passIndex) -> RenderPassData* {
+        const uint32_t batchIndex = passBatchIndices[passIndex];
+        const bool isSolePassOfBatch = (_executionBatchOffsets[batchIndex + 1] - _executionBatchOffsets[batchIndex]) == 1;
+        if ((isSolePassOfBatch == false) || (_commandQueueIndices[passIndex] != static_cast<uint32_t>(CommandStreamUsage::Graphics)) ||
+            _passNodes[passIndex]->hasEnablePredicate())
+        {
+            return nullptr;
+        }
+        return _passNodes[passIndex]->getMergeableRenderPassData();
+    };
+
+    const auto forEachPassResource = [&](const uint32_t passIndex, auto&& visitor) {
+        const PassNode* passNode = _passNodes[passIndex];
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            visitor(getResourceIndex(edge->_fromNodeID), edge);
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            visitor(getResourceIndex(edge->_toNodeID), edge);
+        }
+    };
+
+    // Resources used by passes of the current merge group and attachments among them are marked with
+    // the first pass index of the group.
+    std::vector<uint32_t> resourceGroupMarks(_resources.size(), UINT32_MAX);
+    std::vector<uint32_t> attachmentGroupMarks(_resources.size(), UINT32_MAX);
+
+    uint32_t groupBegin = UINT32_MAX;
+    const RenderPassData* groupFirstData = nullptr;
+    uint32_t numGroupColorAttachments = 0;
+    uint32_t groupDepthStencil = UINT32_MAX;
+
+    const auto getAttachmentIndex = [this](ResourceHandle handle) { return static_cast<uint32_t>(getResourceSlot(handle)._resourceIndex); };
+
+    const auto addToGroup = [&](const uint32_t passIndex, const RenderPassData* rpData) {
+        for (ResourceHandle colorHandle : rpData->_colorAttachmentHandles)
+        {
+            const uint32_t resourceIndex = getAttachmentIndex(colorHandle);
+            if (attachmentGroupMarks[resourceIndex] != groupBegin)
+            {
+                attachmentGroupMarks[resourceIndex] = groupBegin;
+                ++numGroupColorAttachments;
+            }
+        }
+
+        if (rpData->_depthStencilHandle)
+        {
+            groupDepthStencil = getAttachmentIndex(rpData->_depthStencilHandle);
+            attachmentGroupMarks[groupDepthStencil] = groupBegin;
+        }
+
+        forEachPassResource(passIndex, [&](const uint32_t resourceIndex, const DependencyGraph::Edge*) { resourceGroupMarks[resourceIndex] = groupBegin; });
+    };
+
+    const auto canMergeIntoGroup = [&](const uint32_t passIndex, const RenderPassData* rpData) {
+        if ((rpData->_passParams._viewportSize != groupFirstData->_passParams._viewportSize) ||
+            (rpData->_descriptor._numSamples != groupFirstData->_descriptor._numSamples))
+        {
+            return false;
+        }
+
+        // Attachment can only be cleared at the beginning of render pass
+        const RenderPassFlags& passFlags = rpData->_passParams._attachmentFlags;
+        if (rpData->_depthStencilHandle)
+        {
+            const uint32_t depthStencil = getAttachmentIndex(rpData->_depthStencilHandle);
+            if ((groupDepthStencil != UINT32_MAX) && ((groupDepthStencil != depthStencil) || hasDepthAspect(passFlags._clearFlags) ||
+                                                      hasStencilAspect(passFlags._clearFlags)))
+            {
+                return false;
+            }
+        }
+
+        // Merge only when this pass reads attachment of the group at the same pixel
+        bool readsGroupAttachment = false;
+        uint32_t numColorAttachments = numGroupColorAttachments;
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(rpData->_colorAttachmentHandles.size()); ++slot)
+        {
+            const uint32_t resourceIndex = getAttachmentIndex(rpData->_colorAttachmentHandles[slot]);
+            if (attachmentGroupMarks[resourceIndex] != groupBegin)
+            {
+                ++numColorAttachments;
+            }
+            else if ((rpData->_passParams._subpassLayouts.empty() == false) && rpData->_passParams._subpassLayouts.front().hasInputAttachment(slot))
+            {
+                readsGroupAttachment = true;
+            }
+            else if (hasColorAspect(passFlags._clearFlags, slot))
+            {
+                return false;
+            }
+        }
+
+        if ((readsGroupAttachment == false) || (numColorAttachments > MAX_RENDER_TARGET_COUNTS))
+        {
+            return false;
+        }
+
+        // Resources shared with the group are not transited between subpasses, so they must be
+        // used only as attachments.
+        bool hasConflict = false;
+        forEachPassResource(passIndex, [&](const uint32_t resourceIndex, const DependencyGraph::Edge* edge) {
+            if (resourceGroupMarks[resourceIndex] == groupBegin)
+            {
+                hasConflict |= (attachmentGroupMarks[resourceIndex] != groupBegin) ||
+                               (isAttachmentOnlyUsage(_resources[resourceIndex]->getEdgeUsage(edge)) == false);
+            }
+        });
+        return hasConflict == false;
+    };
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        const RenderPassData* rpData = getMergeableRenderPassData(i);
+        if (rpData == nullptr)
+        {
+            groupBegin = UINT32_MAX;
+            continue;
+        }
+
+        if ((groupBegin != UINT32_MAX) && canMergeIntoGroup(i, rpData))
+        {
+            _subpassIndices[i] = _subpassIndices[i - 1] + 1;
+        }
+        else
+        {
+            groupBegin = i;
+            groupFirstData = rpData;
+            numGroupColorAttachments = 0;
+            groupDepthStencil = UINT32_MAX;
+        }
+
+        addToGroup(i, rpData);
+    }
+
+    // Merged passes are recorded in order within the batch of their first subpass
+    const auto isMergedBatchOffset = [&](const uint32_t offset) { return (offset < numPassNodes) && (_subpassIndices[offset] > 0); };
+    _executionBatchOffsets.erase(std::remove_if(_executionBatchOffsets.begin(), _executionBatchOffsets.end(), isMergedBatchOffset),
+                                 _executionBatchOffsets.end());
+
+    applySubpassMerges();
+}
+
+void FrameGraph::applySubpassMerges()
+{
+    _numMergedSubpasses = 0;
+
+    const uint32_t numPassNodes = static_cast<uint32_t>(_subpassIndices.size());
+    for (uint32_t groupBegin = 0, groupEnd = 0; groupBegin < numPassNodes; groupBegin = groupEnd)
+    {
+        groupEnd = groupBegin + 1;
+        while ((groupEnd < numPassNodes) && (_subpassIndices[groupEnd] > 0))
+        {
+            ++groupEnd;
+        }
+
+        if (groupEnd - groupBegin == 1)
+        {
+            continue;
+        }
+
+        // Attachments of all subpasses are gathered into the render pass of the first subpass, and
+        // take load and clear operations of the subpass which uses them first.
+        RenderPassData* firstData = _passNodes[groupBegin]->getMergeableRenderPassData();
+
+        RenderPassParams mergedParams = firstData->_passParams;
+        mergedParams._attachmentFlags = RenderPassFlags{
+            ._clearFlags = AttachmentMaskFlags::None, ._loadFlags = AttachmentMaskFlags::None, ._storeFlags = AttachmentMaskFlags::None
+        };
+        mergedParams._subpassLayouts.clear();
+
+        std::vector<ResourceHandle> colorHandles;
+        ResourceHandle depthStencilHandle;
+
+        const auto findColorSlot = [&colorHandles](ResourceHandle handle) {
+            return static_cast<uint32_t>(std::distance(colorHandles.begin(), std::find(colorHandles.begin(), colorHandles.end(), handle)));
+        };
+
+        for (uint32_t i = groupBegin; i < groupEnd; ++i)
+        {
+            RenderPassData* rpData = _passNodes[i]->getMergeableRenderPassData();
+            const RenderPassParams& passParams = rpData->_passParams;
+            const uint32_t numLocalColorAttachments = static_cast<uint32_t>(rpData->_colorAttachmentHandles.size());
+
+            SubpassLayout localLayout;
+            if (passParams._subpassLayouts.empty())
+            {
+                for (uint32_t localSlot = 0; localSlot < numLocalColorAttachments; ++localSlot)
+                {
+                    localLayout._outputAttachments |= getColorAttachmentMask(localSlot);
+                }
+            }
+            else
+            {
+                localLayout = passParams._subpassLayouts.front();
+            }
+
+            SubpassLayout subpassLayout;
+            for (uint32_t localSlot = 0; localSlot < numLocalColorAttachments; ++localSlot)
+            {
+                const ResourceHandle colorHandle = rpData->_colorAttachmentHandles[localSlot];
+                const uint32_t slot = findColorSlot(colorHandle);
+                if (slot == static_cast<uint32_t>(colorHandles.size()))
+                {
+                    colorHandles.push_back(colorHandle);
+                    copyAttachmentFlags(mergedParams._attachmentFlags, getColorAttachmentMask(slot), passParams._attachmentFlags,
+                                        getColorAttachmentMask(localSlot));
+                    mergedParams._clearColors[slot] = passParams._clearColors[localSlot];
+                }
+
+                if (hasColorAspect(localLayout._outputAttachments, localSlot))
+                {
+                    subpassLayout._outputAttachments |= getColorAttachmentMask(slot);
+                }
+            }
+
+            for (uint8_t k = 0; k < localLayout._numInputAttachments; ++k)
+            {
+                const uint32_t slot = findColorSlot(rpData->_colorAttachmentHandles[localLayout._inputAttachmentSlots[k]]);
+                subpassLayout._inputAttachmentSlots[subpassLayout._numInputAttachments++] = static_cast<uint8_t>(slot);
+            }
+
+            if (rpData->_depthStencilHandle)
+            {
+                if (!depthStencilHandle)
+                {
+                    depthStencilHandle = rpData->_depthStencilHandle;
+                    copyAttachmentFlags(mergedParams._attachmentFlags, AttachmentMaskFlags::Depth, passParams._attachmentFlags, AttachmentMaskFlags::Depth);
+                    copyAttachmentFlags(mergedParams._attachmentFlags, AttachmentMaskFlags::Stencil, passParams._attachmentFlags,
+                                        AttachmentMaskFlags::Stencil);
+                    mergedParams._clearDepth = passParams._clearDepth;
+                    mergedParams._clearStencil = passParams._clearStencil;
+                }
+                subpassLayout._outputAttachments |= AttachmentMaskFlags::DepthStencil;
+            }
+
+            mergedParams._subpassLayouts.push_back(subpassLayout);
+
+            if (i > groupBegin)
+            {
+                rpData->_passParams._subpassIndex = i - groupBegin;
+                ++_numMergedSubpasses;
+            }
+        }
+
+        // Intermediate attachment which is not referenced after the merged render pass is never written to memory
+        const auto isReferencedAfterGroup = [&](ResourceHandle handle) {
+            const VirtualResource* resource = getVirtualResource(handle);
+            const auto groupLast = _passNodes.begin() + groupEnd;
+            return resource->isPersistent() || (std::find(_passNodes.begin() + groupBegin, groupLast, resource->getLastReferencedPassNode()) == groupLast);
+        };
+
+        uint32_t storeFlags = static_cast<uint32_t>(mergedParams._attachmentFlags._storeFlags);
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(colorHandles.size()); ++slot)
+        {
+            if (isReferencedAfterGroup(colorHandles[slot]) == false)
+            {
+                storeFlags &= ~static_cast<uint32_t>(getColorAttachmentMask(slot));
+            }
+        }
+        if (depthStencilHandle && (isReferencedAfterGroup(depthStencilHandle) == false))
+        {
+            storeFlags &= ~static_cast<uint32_t>(AttachmentMaskFlags::DepthStencil);
+        }
+        mergedParams._attachmentFlags._storeFlags = static_cast<AttachmentMaskFlags>(storeFlags);
+
+        firstData->_colorAttachmentHandles = std::move(colorHandles);
+        firstData->_depthStencilHandle = depthStencilHandle;
+        firstData->_passParams = std::move(mergedParams);
+    }
+}
+
+void FrameGraph::inferAttachmentOperations(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::inferAttachmentOperations");
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        _passNodes[i]->inferAttachmentOperations(this);
+    }
+}
+
+void FrameGraph::markTransientAttachments(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::markTransientAttachments");
+
+    // First pass index of the render pass which each live pass is recorded in, keyed by node ID
+    std::vector<uint32_t>& renderPassIndices = _scratchRenderPassIndices;
+    std::vector<bool>& isUsedOnlyAsAttachment = _scratchAttachmentOnlyMarks;
+    renderPassIndices.assign(_dependencyGraph.getNumNodes(), UINT32_MAX);
+    isUsedOnlyAsAttachment.assign(_resources.size(), true);
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        PassNode* passNode = _passNodes[i];
+        if (passNode->getMergeableRenderPassData() != nullptr)
+        {
+            renderPassIndices[passNode->getNodeID()] = i - _subpassIndices[i];
+        }
+
+        const auto checkEdgeUsage = [&](const uint32_t resourceIndex, const DependencyGraph::Edge* edge) {
+            if (isAttachmentOnlyUsage(_resources[resourceIndex]->getEdgeUsage(edge)) == false)
+            {
+                isUsedOnlyAsAttachment[resourceIndex] = false;
+            }
+        };
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            checkEdgeUsage(getResourceIndex(edge->_fromNodeID), edge);
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            checkEdgeUsage(getResourceIndex(edge->_toNodeID), edge);
+        }
+    }
+
+    // Attachment which is neither loaded from nor stored to memory outside of a single render pass
+    // needs no backing memory on tile-based GPUs.
+    for (uint32_t resourceIndex = 0; resourceIndex < static_cast<uint32_t>(_resources.size()); ++resourceIndex)
+    {
+        VirtualResource* resource = _resources[resourceIndex];
+        if (resource->isCulled() || resource->isPersistent() || (isUsedOnlyAsAttachment[resourceIndex] == false))
+        {
+            continue;
+        }
+
+        const uint32_t firstRenderPassIndex = renderPassIndices[resource->getFirstReferencedPassNode()->getNodeID()];
+        const uint32_t lastRenderPassIndex = renderPassIndices[resource->getLastReferencedPassNode()->getNodeID()];
+        if ((firstRenderPassIndex != UINT32_MAX) && (firstRenderPassIndex == lastRenderPassIndex))
+        {
+            resource->makeTransientAttachment();
+        }
+    }
+}
+
+void FrameGraph::buildQueueOwnershipTransfers(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::buildQueueOwnershipTransfers");
+
+    _queueOwnershipTransferOffsets.assign(1, 0);
+    _queueOwnershipTransfers.clear();
+
+    // Follow the owner queue of each resource in execution order. Resource is acquired by the queue
+    // of its first user without transfer as its content is undefined at that time.
+    std::vector<uint32_t> resourceOwnerQueues(_resources.size(), UINT32_MAX);
+
+    const auto visitResource = [&](DependencyGraph::NodeID resourceNodeID, const uint32_t queueIndex) {
+        const uint32_t resourceIndex = getResourceIndex(resourceNodeID);
+        const uint32_t ownerQueueIndex = resourceOwnerQueues[resourceIndex];
+
+        if ((ownerQueueIndex != UINT32_MAX) && (ownerQueueIndex != queueIndex))
+        {
+            _queueOwnershipTransfers.push_back({ ._resourceIndex = resourceIndex, ._srcQueueIndex = ownerQueueIndex, ._dstQueueIndex = queueIndex });
+        }
+        resourceOwnerQueues[resourceIndex] = queueIndex;
+    };
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        const PassNode* passNode = _passNodes[i];
+        const uint32_t queueIndex = _commandQueueIndices[i];
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            visitResource(edge->_fromNodeID, queueIndex);
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            visitResource(edge->_toNodeID, queueIndex);
+        }
+
+        _queueOwnershipTransferOffsets.push_back(static_cast<uint32_t>(_queueOwnershipTransfers.size()));
+    }
+}
+
+uint32_t FrameGraph::getResourceIndex(DependencyGraph::NodeID resourceNodeID)
+{
+    const ResourceNode* resourceNode = static_cast<const ResourceNode*>(_dependencyGraph.getNode(resourceNodeID));
+    return getResourceSlot(resourceNode->getResourceHandle())._resourceIndex;
+}
+
+void FrameGraph::calcResourceLifetimes(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::calcResourceLifetimes");
+
+    VOX_ASSERT(_executionBatchOffsets.back() == numPassNodes, "Execution batches must be built before calculating resource lifetimes");
+
+    // Map dependency graph node id to execution batch of live pass nodes. Passes in the same batch
+    // are recorded concurrently, so lifetimes are measured in batches rather than in passes.
+    std::vector<uint32_t> passBatchIndices(_dependencyGraph.getNumNodes(), UINT32_MAX);
+    for (uint32_t batchIndex = 0; batchIndex + 1 < static_cast<uint32_t>(_executionBatchOffsets.size()); ++batchIndex)
+    {
+        for (uint32_t i = _executionBatchOffsets[batchIndex]; i < _executionBatchOffsets[batchIndex + 1]; ++i)
+        {
+            passBatchIndices[_passNodes[i]->getNodeID()] = batchIndex;
+        }
+    }
+
+    // Occupants of shared memory on different queues would need semaphores between them,
+    // so resources used by asynchronous queues are backed by the transient texture pool instead.
+    std::vector<bool> isUsedByAsyncQueue(_resources.size(), false);
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        if (_commandQueueIndices[i] == static_cast<uint32_t>(CommandStreamUsage::Graphics))
+        {
+            continue;
+        }
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(_passNodes[i]->getNodeID()))
+        {
+            isUsedByAsyncQueue[getResourceIndex(edge->_fromNodeID)] = true;
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(_passNodes[i]->getNodeID()))
+        {
+            isUsedByAsyncQueue[getResourceIndex(edge->_toNodeID)] = true;
+        }
+    }
+
+    _resourceLifetimes.clear();
+    _resourceLifetimes.reserve(_resources.size());
+
+    for (uint32_t resourceIndex = 0; resourceIndex < static_cast<uint32_t>(_resources.size()); ++resourceIndex)
+    {
+        VirtualResource* resource = _resources[resourceIndex];
+        // Transient attachment does not share memory as it might be lazily allocated, and persistent
+        // resource has its own memory which must not be overwritten by others
+        if (resource->isCulled() || resource->isPersistent() || resource->isTransientAttachment() || isUsedByAsyncQueue[resourceIndex])
+        {
+            continue;
+        }
+
+        const uint64_t memorySize = resource->getEstimatedMemorySize();
+        if (memorySize == 0)
+        {
+            continue;
+        }
+
+        const uint32_t firstBatchIndex = passBatchIndices[resource->getFirstReferencedPassNode()->getNodeID()];
+        const uint32_t lastBatchIndex = passBatchIndices[resource->getLastReferencedPassNode()->getNodeID()];
+        VOX_ASSERT((firstBatchIndex != UINT32_MAX) && (lastBatchIndex != UINT32_MAX), "Live resource({}) must be referenced by live pass nodes",
+                   resource->getResourceName());
+
+        _resourceLifetimes.push_back(
+            { ._resource = resource, ._firstBatchIndex = firstBatchIndex, ._lastBatchIndex = lastBatchIndex, ._memorySize = memorySize });
+    }
+}
+
+void FrameGraph::allotTransientMemorySlots()
+{
+    SCOPED_CHROME_TRACING("FrameGraph::allotTransientMemorySlots");
+
+    _transientMemoryStats = TransientMemoryStats();
+
+    // Greedy first-fit placement of larger resources first. Two resources can share a slot
+    // only if their lifetime intervals [first, last] never overlap in the execution batches.
+    std::sort(_resourceLifetimes.begin(), _resourceLifetimes.end(),
+              [](const ResourceLifetime& lhs, const ResourceLifetime& rhs) { return lhs._memorySize > rhs._memorySize; });
+
+    // Occupants of each slot keyed by first batch index. As they never overlap, only the closest
+    // preceding occupant needs to be checked for overlap.
+    std::vector<std::map<uint32_t, const ResourceLifetime*>> memorySlots;
+    std::vector<uint64_t> memorySlotSizes;
+
+    for (const ResourceLifetime& lifetime : _resourceLifetimes)
+    {
+        uint32_t slotIndex = 0;
+        for (; slotIndex < memorySlots.size(); ++slotIndex)
+        {
+            const std::map<uint32_t, const ResourceLifetime*>& occupants = memorySlots[slotIndex];
+            auto nextOccupant = occupants.upper_bound(lifetime._lastBatchIndex);
+            if ((nextOccupant == occupants.begin()) || (std::prev(nextOccupant)->second->_lastBatchIndex < lifetime._firstBatchIndex))
+            {
+                break;
+            }
+        }
+
+        if (slotIndex == memorySlots.size())
+        {
+            memorySlots.emplace_back();
+            memorySlotSizes.push_back(0);
+        }
+
+        memorySlots[slotIndex].emplace(lifetime._firstBatchIndex, &lifetime);
+        memorySlotSizes[slotIndex] = std::max(memorySlotSizes[slotIndex], lifetime._memorySize);
+
+        _transientMemoryStats._peakBytesWithoutAliasing += lifetime._memorySize;
+    }
+
+    for (uint32_t slotIndex = 0; slotIndex < memorySlots.size(); ++slotIndex)
+    {
+        // Resource alone in its slot gains nothing from aliasing. It is backed by the transient texture pool instead.
+        if (memorySlots[slotIndex].size() < 2)
+        {
+            _transientMemoryStats._peakBytesWithAliasing += memorySlotSizes[slotIndex];
+            continue;
+        }
+
+        for (const auto& [firstBatchIndex, occupant] : memorySlots[slotIndex])
+        {
+            occupant->_resource->setTransientMemorySlot(slotIndex);
+        }
+
+        _transientMemoryStats._peakBytesWithAliasing += memorySlotSizes[slotIndex];
+    }
+
+    _transientMemoryStats._numTransientResources = static_cast<uint32_t>(_resourceLifetimes.size());
+    _transientMemoryStats._numMemorySlots = static_cast<uint32_t>(memorySlots.size());
+}
+
+bool FrameGraph::replayCompileCache()
+{
+    SCOPED_CHROME_TRACING("FrameGraph::replayCompileCache");
+
+    const uint32_t numNodes = _dependencyGraph.getNumNodes();
+    const uint32_t numEdges = static_cast<uint32_t>(_dependencyGraph.getLinkedEdges().size());
+
+    if ((_compileCache._isValid == false) || (_compileCache._structureHash != _structureHash) || (_compileCache._numNodes != numNodes) ||
+        (_compileCache._numEdges != numEdges))
+    {
+        return false;
+    }
+
+    // Equal hash does not guarantee equal structure. Edges are linked in deterministic declaration order,
+    // so identical structure produces byte-wise identical fingerprints.
+    collectEdgeFingerprints(_edgeFingerprints);
+    if (std::memcmp(_edgeFingerprints.data(), _compileCache._edgeFingerprints.data(), numEdges * sizeof(EdgeFingerprint)) != 0)
+    {
+        return false;
+    }
+
+    // Only the execute lambdas are new in this frame. Apply culling, resource registration and
+    // transient memory placement of the previous frame without walking the dependency graph again.
+    for (DependencyGraph::NodeID nodeID = 0; nodeID < numNodes; ++nodeID)
+    {
+        _dependencyGraph.getNode(nodeID)->_refCount = _compileCache._nodeRefCounts[nodeID];
+    }
+
+    partitionLivePassNodes();
+
+    _executionOrder = _compileCache._executionOrder;
+    _executionBatchOffsets = _compileCache._executionBatchOffsets;
+    applyExecutionOrder();
+
+    _commandQueueIndices = _compileCache._commandQueueIndices;
+    _subpassIndices = _compileCache._subpassIndices;
+    _queueOwnershipTransferOffsets = _compileCache._queueOwnershipTransferOffsets;
+    _queueOwnershipTransfers = _compileCache._queueOwnershipTransfers;
+    _passBarrierOffsets = _compileCache._passBarrierOffsets;
+    _passBarriers = _compileCache._passBarriers;
+    _splitBarrierSignalOffsets = _compileCache._splitBarrierSignalOffsets;
+    _splitBarrierSignals = _compileCache._splitBarrierSignals;
+    _numSplitBarriers = _compileCache._numSplitBarriers;
+
+    uint32_t livePassIndex = 0;
+    for (auto it = _passNodes.begin(); it != _passNodeLast; ++it, ++livePassIndex)
+    {
+        PassNode* passNode = *it;
+
+        for (uint32_t i = _compileCache._declaredHandleOffsets[livePassIndex]; i < _compileCache._declaredHandleOffsets[livePassIndex + 1]; ++i)
+        {
+            passNode->registerResource(this, _compileCache._declaredHandles[i]);
+        }
+
+        for (uint32_t i = _compileCache._devirtualizeOffsets[livePassIndex]; i < _compileCache._devirtualizeOffsets[livePassIndex + 1]; ++i)
+        {
+            passNode->addDevirtualize(_resources[_compileCache._devirtualizes[i]]);
+        }
+
+        for (uint32_t i = _compileCache._destroyOffsets[livePassIndex]; i < _compileCache._destroyOffsets[livePassIndex + 1]; ++i)
+        {
+            passNode->addDestroy(_resources[_compileCache._destroyes[i]]);
+        }
+
+        passNode->resolve(this);
+    }
+
+    for (ResourceNode* resourceNode : _resourceNodes)
+    {
+        resourceNode->resolveResourceUsage(this);
+    }
+
+    const uint32_t numLivePassNodes = static_cast<uint32_t>(std::distance(_passNodes.begin(), _passNodeLast));
+
+    inferAttachmentOperations(numLivePassNodes);
+
+    applySubpassMerges();
+
+    markTransientAttachments(numLivePassNodes);
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(_resources.size()); ++i)
+    {
+        _resources[i]->setTransientMemorySlot(_compileCache._transientMemorySlots[i]);
+    }
+
+    _transientMemoryStats = _compileCache._transientMemoryStats;
+
+    return true;
+}
+
+void FrameGraph::collectEdgeFingerprints(std::vector<EdgeFingerprint>& outFingerprints) const
+{
+    const DependencyGraph::EdgeContainer& edges = _dependencyGraph.getLinkedEdges();
+
+    outFingerprints.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        const ResourceEdgeBase* edge = static_cast<const ResourceEdgeBase*>(edges[i]);
+        outFingerprints[i] = EdgeFingerprint{ edge->_fromNodeID, edge->_toNodeID, edge->getUsageBits() };
+    }
+}
+
+void FrameGraph::recordCompileCache()
+{
+    SCOPED_CHROME_TRACING("FrameGraph::recordCompileCache");
+
+    const uint32_t numNodes = _dependencyGraph.getNumNodes();
+    const uint32_t numResources = static_cast<uint32_t>(_resources.size());
+
+    _compileCache._structureHash = _structureHash;
+    _compileCache._numNodes = numNodes;
+    _compileCache._numEdges = static_cast<uint32_t>(_dependencyGraph.getLinkedEdges().size());
+    collectEdgeFingerprints(_compileCache._edgeFingerprints);
+    // Fingerprints of the next frame are collected here on cache lookup, so reserve them with the recorded ones
+    _edgeFingerprints.reserve(_compileCache._edgeFingerprints.size());
+
+    _compileCache._nodeRefCounts.resize(numNodes);
+    for (DependencyGraph::NodeID nodeID = 0; nodeID < numNodes; ++nodeID)
+    {
+        _compileCache._nodeRefCounts[nodeID] = _dependencyGraph.getNode(nodeID)->_refCount;
+    }
+
+    _compileCache._executionOrder = _executionOrder;
+    _compileCache._executionBatchOffsets = _executionBatchOffsets;
+    _compileCache._commandQueueIndices = _commandQueueIndices;
+    _compileCache._subpassIndices = _subpassIndices;
+    _compileCache._queueOwnershipTransferOffsets = _queueOwnershipTransferOffsets;
+    _compileCache._queueOwnershipTransfers = _queueOwnershipTransfers;
+    _compileCache._passBarrierOffsets = _passBarrierOffsets;
+    _compileCache._passBarriers = _passBarriers;
+    _compileCache._splitBarrierSignalOffsets = _splitBarrierSignalOffsets;
+    _compileCache._splitBarrierSignals = _splitBarrierSignals;
+    _compileCache._numSplitBarriers = _numSplitBarriers;
+
+    std::unordered_map<const VirtualResource*, uint32_t> resourceIndices;
+    resourceIndices.reserve(numResources);
+    for (uint32_t i = 0; i < numResources; ++i)
+    {
+        resourceIndices.emplace(_resources[i], i);
+    }
+
+    _compileCache._declaredHandleOffsets.assign(1, 0);
+    _compileCache._declaredHandles.clear();
+    _compileCache._devirtualizeOffsets.assign(1, 0);
+    _compileCache._devirtualizes.clear();
+    _compileCache._destroyOffsets.assign(1, 0);
+    _compileCache._destroyes.clear();
+
+    for (auto it = _passNodes.begin(); it != _passNodeLast; ++it)
+    {
+        const PassNode* passNode = *it;
+
+        const ArenaVector<ResourceHandle>& declaredHandles = passNode->getDeclaredHandles();
+        _compileCache._declaredHandles.insert(_compileCache._declaredHandles.end(), declaredHandles.begin(), declaredHandles.end());
+        _compileCache._declaredHandleOffsets.push_back(static_cast<uint32_t>(_compileCache._declaredHandles.size()));
+
+        for (const VirtualResource* resource : passNode->getDevirtualizes())
+        {
+            _compileCache._devirtualizes.push_back(resourceIndices[resource]);
+        }
+        _compileCache._devirtualizeOffsets.push_back(static_cast<uint32_t>(_compileCache._devirtualizes.size()));
+
+        for (const VirtualResource* resource : passNode->getDestroyes())
+        {
+            _compileCache._destroyes.push_back(resourceIndices[resource]);
+        }
+        _compileCache._destroyOffsets.push_back(static_cast<uint32_t>(_compileCache._destroyes.size()));
+    }
+
+    _compileCache._transientMemorySlots.resize(numResources);
+    for (uint32_t i = 0; i < numResources; ++i)
+    {
+        _compileCache._transientMemorySlots[i] = _resources[i]->getTransientMemorySlot();
+    }
+
+    _compileCache._transientMemoryStats = _transientMemoryStats;
+    _compileCache._isValid = true;
+}
+
+void FrameGraph::buildSSIS(const uint32_t numPassNodes)
+{
+    SCOPED_CHROME_TRACING("FrameGraph::buildSSIS");
+
+    _passBarrierOffsets.assign(1, 0);
+    _passBarriers.clear();
+    _numSplitBarriers = 0;
+
+    std::vector<uint32_t> passBatchIndices(numPassNodes);
+    for (uint32_t batchIndex = 0; batchIndex < getNumExecutionBatches(); ++batchIndex)
+    {
+        for (uint32_t i = _executionBatchOffsets[batchIndex]; i < _executionBatchOffsets[batchIndex + 1]; ++i)
+        {
+            passBatchIndices[i] = batchIndex;
+        }
+    }
+
+    struct ResourceAccess
+    {
+        uint32_t _passIndex = UINT32_MAX;
+        uint32_t _usage = 0;
+    };
+    std::vector<ResourceAccess> lastResourceAccesses(_resources.size());
+
+    // Pairs of pass index which signals split barrier and index of the barrier
+    std::vector<std::pair<uint32_t, uint32_t>> splitBarrierSignals;
+
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        const PassNode* passNode = _passNodes[i];
+        const uint32_t barrierBegin = static_cast<uint32_t>(_passBarriers.size());
+
+        // Usages of the same resource in a pass are merged into a single barrier
+        const auto collectUsage = [&](DependencyGraph::NodeID resourceNodeID, const DependencyGraph::Edge* edge) {
+            const uint32_t resourceIndex = getResourceIndex(resourceNodeID);
+            const VirtualResource* resource = _resources[resourceIndex];
+            if (resource->isBarrierPlannable() == false)
+            {
+                return;
+            }
+
+            const uint32_t usage = resource->getEdgeUsage(edge);
+            for (uint32_t k = barrierBegin; k < _passBarriers.size(); ++k)
+            {
+                if (_passBarriers[k]._resourceIndex == resourceIndex)
+                {
+                    _passBarriers[k]._usage |= usage;
+                    return;
+                }
+            }
+            _passBarriers.push_back({ ._resourceIndex = resourceIndex, ._usage = usage });
+        };
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            collectUsage(edge->_fromNodeID, edge);
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            collectUsage(edge->_toNodeID, edge);
+        }
+
+        uint32_t numBarriers = barrierBegin;
+        for (uint32_t k = barrierBegin; k < _passBarriers.size(); ++k)
+        {
+            PassBarrier passBarrier = _passBarriers[k];
+            ResourceAccess& lastAccess = lastResourceAccesses[passBarrier._resourceIndex];
+
+            const ResourceAccess previousAccess = lastAccess;
+            const bool hasPreviousAccess = previousAccess._passIndex != UINT32_MAX;
+
+            // Attachment shared by subpasses of the same render pass is transited by subpass dependency,
+            // and stays in the state of its first access after the render pass.
+            if (hasPreviousAccess && (_subpassIndices[i] > 0) && (previousAccess._passIndex >= i - _subpassIndices[i]))
+            {
+                continue;
+            }
+            lastAccess = { ._passIndex = i, ._usage = passBarrier._usage };
+
+            const bool isSameQueue = hasPreviousAccess && (_commandQueueIndices[previousAccess._passIndex] == _commandQueueIndices[i]);
+
+            // Same read-only access needs no more barrier
+            if (isSameQueue && (previousAccess._usage == passBarrier._usage) &&
+                _resources[passBarrier._resourceIndex]->isReadOnlyUsage(passBarrier._usage))
+            {
+                continue;
+            }
+
+            // If there are unrelated batches between the previous access and this one, the barrier
+            // is split so that the transition overlaps with them instead of stalling at this pass.
+            if (isSameQueue && (passBatchIndices[previousAccess._passIndex] + 1 < passBatchIndices[i]))
+            {
+                passBarrier._splitBarrierIndex = _numSplitBarriers++;
+                splitBarrierSignals.emplace_back(previousAccess._passIndex, numBarriers);
+            }
+            _passBarriers[numBarriers++] = passBarrier;
+        }
+        _passBarriers.resize(numBarriers);
+
+        _passBarrierOffsets.push_back(numBarriers);
+    }
+
+    _splitBarrierSignalOffsets.assign(numPassNodes + 1, 0);
+    for (const auto& [passIndex, _] : splitBarrierSignals)
+    {
+        ++_splitBarrierSignalOffsets[passIndex + 1];
+    }
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        _splitBarrierSignalOffsets[i + 1] += _splitBarrierSignalOffsets[i];
+    }
+
+    _splitBarrierSignals.resize(splitBarrierSignals.size());
+    std::vector<uint32_t> signalCursors(_splitBarrierSignalOffsets.begin(), _splitBarrierSignalOffsets.end() - 1);
+    for (const auto& [passIndex, barrierIndex] : splitBarrierSignals)
+    {
+        _splitBarrierSignals[signalCursors[passIndex]++] = barrierIndex;
+    }
+}
+
+void FrameGraph::submitQueueOwnershipTransfers(const uint32_t passBegin, const uint32_t passEnd)
+{
+    const uint32_t transferBegin = _queueOwnershipTransferOffsets[passBegin];
+    const uint32_t transferEnd = _queueOwnershipTransferOffsets[passEnd];
+
+    // Collect transfers between queues which are actually distinct after falling back
+    // missing asynchronous command streams to graphics one.
+    std::vector<QueueOwnershipTransfer> transfers;
+    for (uint32_t i = transferBegin; i < transferEnd; ++i)
+    {
+        const QueueOwnershipTransfer& transfer = _queueOwnershipTransfers[i];
+        if (_resources[transfer._resourceIndex]->isReferencedByEnabledPass() == false)
+        {
+            continue;
+        }
+
+        const uint32_t srcQueueIndex = resolveCommandQueueIndex(transfer._srcQueueIndex);
+        const uint32_t dstQueueIndex = resolveCommandQueueIndex(transfer._dstQueueIndex);
+
+        if ((srcQueueIndex != dstQueueIndex) && (_cmdStreams[srcQueueIndex] != nullptr) && (_cmdStreams[dstQueueIndex] != nullptr))
+        {
+            transfers.push_back({ ._resourceIndex = transfer._resourceIndex, ._srcQueueIndex = srcQueueIndex, ._dstQueueIndex = dstQueueIndex });
+        }
+    }
+
+    if (transfers.empty())
+    {
+        return;
+    }
+
+    const auto getQueueFamilyIndex = [this](const uint32_t queueIndex) { return _cmdStreams[queueIndex]->getQueue()->getFamilyIndex(); };
+
+    std::array<bool, NUM_COMMAND_QUEUE_TYPES> isReleasedQueue{};
+    for (const QueueOwnershipTransfer& transfer : transfers)
+    {
+        _resources[transfer._resourceIndex]->transferQueueOwnership(_cmdStreams[transfer._srcQueueIndex], getQueueFamilyIndex(transfer._srcQueueIndex),
+                                                                    getQueueFamilyIndex(transfer._dstQueueIndex), true);
+        isReleasedQueue[transfer._srcQueueIndex] = true;
+    }
+
+    // Release barriers must be submitted before the acquiring queue waits for them
+    std::vector<FenceObject> releaseFences(NUM_COMMAND_QUEUE_TYPES, FenceObject::Default());
+    for (uint32_t queueIndex = 0; queueIndex < NUM_COMMAND_QUEUE_TYPES; ++queueIndex)
+    {
+        if (isReleasedQueue[queueIndex])
+        {
+            releaseFences[queueIndex] = flushCommandStreamBeforePresent(queueIndex);
+        }
+    }
+
+    std::array<bool, NUM_COMMAND_QUEUE_TYPES> isAcquiredQueue{};
+    for (const QueueOwnershipTransfer& transfer : transfers)
+    {
+        CommandStream* dstCmdStream = _cmdStreams[transfer._dstQueueIndex];
+        if (isAcquiredQueue[transfer._dstQueueIndex] == false)
+        {
+            // Commands recorded before the acquisition must not wait for the other queue
+            flushCommandStreamBeforePresent(transfer._dstQueueIndex);
+            isAcquiredQueue[transfer._dstQueueIndex] = true;
+        }
+        dstCmdStream->addWaitFence(releaseFences[transfer._srcQueueIndex]);
+
+        _resources[transfer._resourceIndex]->transferQueueOwnership(dstCmdStream, getQueueFamilyIndex(transfer._srcQueueIndex),
+                                                                    getQueueFamilyIndex(transfer._dstQueueIndex), false);
+    }
+}
+
+FenceObject FrameGraph::flushCommandStreamBeforePresent(const uint32_t queueIndex)
+{
+    // Only graphics queue presents. The first graphics submission of the frame waits for the back buffer instead
+    // of the present one, since commands recorded before may already write to it.
+    FenceObject submittedFence = FenceObject::Default();
+    if ((queueIndex == static_cast<uint32_t>(CommandStreamUsage::Graphics)) && (_swapChainToPresent != nullptr))
+    {
+        submittedFence = _cmdStreams[queueIndex]->flushBeforePresent(_swapChainToPresent, &_frameContextToPresent);
+    }
+    else
+    {
+        submittedFence = _cmdStreams[queueIndex]->flush(nullptr, nullptr, false);
+    }
+
+    setFrameSubmitFence(static_cast<CommandStreamUsage>(queueIndex), submittedFence);
+    return submittedFence;
+}
+
+void FrameGraph::evaluateEnablePredicates(const uint32_t numPassNodes)
+{
+    for (VirtualResource* resource : _resources)
+    {
+        resource->setReferencedByEnabledPass(false);
+    }
+
+    _isPassEnabled.resize(numPassNodes);
+    for (uint32_t i = 0; i < numPassNodes; ++i)
+    {
+        const PassNode* passNode = _passNodes[i];
+        _isPassEnabled[i] = passNode->isEnabled();
+        if (_isPassEnabled[i] == false)
+        {
+            continue;
+        }
+
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getIncomingEdges(passNode->getNodeID()))
+        {
+            _resources[getResourceIndex(edge->_fromNodeID)]->setReferencedByEnabledPass(true);
+        }
+        for (const DependencyGraph::Edge* edge : _dependencyGraph.getOutgoingEdges(passNode->getNodeID()))
+        {
+            _resources[getResourceIndex(edge->_toNodeID)]->setReferencedByEnabledPass(true);
+        }
+    }
+}
+
+void FrameGraph::execute()
+{
+    SCOPED_CHROME_TRACING("FrameGraph::execute");
+
+    const uint32_t numExecutionBatches = getNumExecutionBatches();
+
+    // Predicates are evaluated once before recording, so that every batch sees the same set of enabled passes.
+    // Barriers of disabled passes are still recorded for resources used by enabled passes to keep planned
+    // transitions and split barrier pairs consistent.
+    evaluateEnablePredicates((numExecutionBatches > 0) ? _executionBatchOffsets.back() : 0);
+
+    if (_numSplitBarriers > 0)
+    {
+        for (CommandStream* cmdStream : _cmdStreams)
+        {
+            if (cmdStream != nullptr)
+            {
+                cmdStream->prepareSplitBarriers(_numSplitBarriers);
+            }
+        }
+    }
+
+    // Streams translate secondary command buffers on the recording workers only while this frame graph executes
+    setTranslationExecutor(_recordingExecutor.get());
+
+    for (uint32_t batchIndex = 0; batchIndex < numExecutionBatches; ++batchIndex)
+    {
+        const uint32_t batchBegin = _executionBatchOffsets[batchIndex];
+        const uint32_t batchEnd = _executionBatchOffsets[batchIndex + 1];
+        // Batch of passes merged into a render pass is recorded in order on this thread
+        const bool isParallelBatch = ((batchEnd - batchBegin) > 1) && (_subpassIndices[batchBegin + 1] == 0);
+
+        // Resource allocator is not thread-safe, so resources are devirtualized and destroyed
+        // on this thread while only recording of passes is distributed.
+        // Without resource allocator, resources stay virtual and only passes are executed.
+        if (_renderResourceAllocator != nullptr)
+        {
+            for (uint32_t i = batchBegin; i < batchEnd; ++i)
+            {
+                CommandStream* cmdStream = _cmdStreams[resolveCommandQueueIndex(_commandQueueIndices[i])];
+                for (VirtualResource* resource : _passNodes[i]->getDevirtualizes())
+                {
+                    if (resource->isReferencedByEnabledPass())
+                    {
+                        resource->devirtualize(_renderResourceAllocator);
+                        resource->addAliasingBarrier(cmdStream);
+                    }
+                }
+            }
+        }
+
+        submitQueueOwnershipTransfers(batchBegin, batchEnd);
+
+        submitPassBarriers(batchBegin, batchEnd);
+
+        if (isParallelBatch)
+        {
+            tf::Executor* recordingExecutor = getOrCreateRecordingExecutor();
+
+            // Commands recorded by previous batches must be submitted before ones of this batch
+            sealCommandStreams();
+
+            tf::Taskflow taskflow;
+            for (uint32_t i = batchBegin; i < batchEnd; ++i)
+            {
+                if (_isPassEnabled[i] == false)
+                {
+                    continue;
+                }
+
+                PassNode* passNode = _passNodes[i];
+                CommandStream* cmdStream = _cmdStreams[resolveCommandQueueIndex(_commandQueueIndices[i])];
+                taskflow
+                    .emplace([this, passNode, cmdStream]() {
+                        FrameGraphResources resources(this, passNode);
+                        passNode->execute(&resources, cmdStream);
+                    })
+                    .name(std::string(passNode->getPassName()));
+            }
+            recordingExecutor->run(taskflow).wait();
+
+            sealCommandStreams();
+        }
+        else
+        {
+            for (uint32_t i = batchBegin; i < batchEnd; ++i)
+            {
+                if (_isPassEnabled[i] == false)
+                {
+                    continue;
+                }
+
+                PassNode* passNode = _passNodes[i];
+                FrameGraphResources resources(this, passNode);
+                passNode->execute(&resources, _cmdStreams[resolveCommandQueueIndex(_commandQueueIndices[i])]);
+            }
+        }
+
+        signalSplitBarriers(batchBegin, batchEnd);
+
+        if (_renderResourceAllocator != nullptr)
+        {
+            for (uint32_t i = batchBegin; i < batchEnd; ++i)
+            {
+                for (VirtualResource* resource : _passNodes[i]->getDestroyes())
+                {
+                    if (resource->isReferencedByEnabledPass())
+                    {
+                        resource->destroy(_renderResourceAllocator);
+                    }
+                }
+            }
+        }
+    }
+
+    // Graphics command stream is flushed by the owner with swapchain, but asynchronous ones
+    // must be submitted here.
+    for (uint32_t queueIndex = 0; queueIndex < NUM_COMMAND_QUEUE_TYPES; ++queueIndex)
+    {
+        if ((queueIndex != static_cast<uint32_t>(CommandStreamUsage::Graphics)) && (_cmdStreams[queueIndex] != nullptr))
+        {
+            setFrameSubmitFence(static_cast<CommandStreamUsage>(queueIndex), _cmdStreams[queueIndex]->flush(nullptr, nullptr, false));
+        }
+    }
+
+    setTranslationExecutor(nullptr);
+
+    // Resources released in this frame may be used by any queue, so they are reused once all submissions are completed
+    if (_renderResourceAllocator != nullptr)
+    {
+        _renderResourceAllocator->endTransientResourceFrame(_frameSubmitFences);
+    }
+}
+
+void FrameGraph::submitPassBarriers(const uint32_t passBegin, const uint32_t passEnd)
+{
+    std::array<bool, NUM_COMMAND_QUEUE_TYPES> hasPendingBarriers{};
+
+    for (uint32_t i = passBegin; i < passEnd; ++i)
+    {
+        const uint32_t queueIndex = resolveCommandQueueIndex(_commandQueueIndices[i]);
+        CommandStream* cmdStream = _cmdStreams[queueIndex];
+        if (cmdStream == nullptr)
+        {
+            continue;
+        }
+
+        for (uint32_t k = _passBarrierOffsets[i]; k < _passBarrierOffsets[i + 1]; ++k)
+        {
+            const PassBarrier& passBarrier = _passBarriers[k];
+            VirtualResource* resource = _resources[passBarrier._resourceIndex];
+            if (resource->isReferencedByEnabledPass() == false)
+            {
+                continue;
+            }
+
+            if (passBarrier._splitBarrierIndex != UINT32_MAX)
+            {
+                resource->waitSplitBarrier(cmdStream, passBarrier._splitBarrierIndex);
+            }
+            else
+            {
+                resource->addPlannedBarrier(cmdStream, passBarrier._usage, static_cast<CommandStreamUsage>(queueIndex));
+            }
+            hasPendingBarriers[queueIndex] = true;
+        }
+    }
+
+    // Barriers of all passes in the batch are recorded at once
+    for (uint32_t queueIndex = 0; queueIndex < NUM_COMMAND_QUEUE_TYPES; ++queueIndex)
+    {
+        if (hasPendingBarriers[queueIndex])
+        {
+            _cmdStreams[queueIndex]->addJob<CommandJobType::CommitPendingBarriers>();
+        }
+    }
+}
+
+void FrameGraph::signalSplitBarriers(const uint32_t passBegin, const uint32_t passEnd)
+{
+    for (uint32_t i = passBegin; i < passEnd; ++i)
+    {
+        for (uint32_t k = _splitBarrierSignalOffsets[i]; k < _splitBarrierSignalOffsets[i + 1]; ++k)
+        {
+            const PassBarrier& passBarrier = _passBarriers[_splitBarrierSignals[k]];
+            if (_resources[passBarrier._resourceIndex]->isReferencedByEnabledPass() == false)
+            {
+                continue;
+            }
+
+            // Split barrier is only planned between passes on the same queue
+            const uint32_t queueIndex = resolveCommandQueueIndex(_commandQueueIndices[i]);
+            CommandStream* cmdStream = _cmdStreams[queueIndex];
+            if (cmdStream != nullptr)
+            {
+                _resources[passBarrier._resourceIndex]->signalSplitBarrier(cmdStream, passBarrier._splitBarrierIndex, passBarrier._usage,
+                                                                           static_cast<CommandStreamUsage>(queueIndex));
+            }
+        }
+    }
+}
+
+void FrameGraph::sealCommandStreams()
+{
+    for (CommandStream* cmdStream : _cmdStreams)
+    {
+        if (cmdStream != nullptr)
+        {
+            cmdStream->sealCommandBuffers();
+        }
+    }
+}
+
+tf::Executor* FrameGraph::getOrCreateRecordingExecutor()
+{
+    if (_recordingExecutor == nullptr)
+    {
+        _recordingExecutor = std::make_unique<tf::Executor>();
+        setTranslationExecutor(_recordingExecutor.get());
+    }
+    return _recordingExecutor.get();
+}
+
+void FrameGraph::setTranslationExecutor(tf::Executor* translationExecutor)
+{
+    for (CommandStream* cmdStream : _cmdStreams)
+    {
+        if (cmdStream != nullptr)
+        {
+            cmdStream->setTranslationExecutor(translationExecutor);
+        }
+    }
+}
+
+void FrameGraph::runRecordingTasks(const uint32_t numTasks, const std::function<void(uint32_t)>& task)
+{
+    tf::Executor* recordingExecutor = getOrCreateRecordingExecutor();
+
+    // Waiting on the executor from one of its own workers may block every worker
+    if ((numTasks <= 1) || (recordingExecutor->this_worker_id() >= 0))
+    {
+        for (uint32_t taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            task(taskIndex);
+        }
+        return;
+    }
+
+    tf::Taskflow taskflow;
+    for (uint32_t taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+    {
+        taskflow.emplace([&task, taskIndex]() { task(taskIndex); });
+    }
+    recordingExecutor->run(taskflow).wait();
+}
+
+void FrameGraph::clear()
+{
+    // Nodes are re-declared every frame with new execute lambdas. Compile result is kept in
+    // _compileCache and reused if the next frame declares the same structure.
+    _dependencyGraph.clear();
+    _frameArena.reset();
+    // Published handles and pass data are only valid in the frame
+    _blackBoard.clear();
+    for (std::unique_ptr<FrameGraphDeclarationScope>& declarationScope : _declarationScopes)
+    {
+        declarationScope->_arena.reset();
+    }
+    _numOpenDeclarationScopes = 0;
+
+    _resourceSlots.clear();
+    _passNodes.clear();
+    _passNodeLast = _passNodes.end();
+    _resourceNodes.clear();
+    _resources.clear();
+    _structureHash = 0;
+    _passNodeAdjacencyList.clear();
+    _topologicalSortedPassNodes.clear();
+    _dependencyLevels.clear();
+    _executionOrder.clear();
+    _executionBatchOffsets.clear();
+    _commandQueueIndices.clear();
+    _isPassEnabled.clear();
+    _subpassIndices.clear();
+    _numMergedSubpasses = 0;
+    _queueOwnershipTransferOffsets.clear();
+    _queueOwnershipTransfers.clear();
+    _passBarrierOffsets.clear();
+    _passBarriers.clear();
+    _splitBarrierSignalOffsets.clear();
+    _splitBarrierSignals.clear();
+    _numSplitBarriers = 0;
+    _resourceLifetimes.clear();
+    _transientMemoryStats = TransientMemoryStats();
+    _swapChainToPresent = nullptr;
+    _frameContextToPresent = FrameContext();
+    _frameSubmitFences.fill(FenceObject::Default());
+}
+
+class AlphabetPermutator
+{
+ public:
+    explicit AlphabetPermutator(uint32_t numNodes)
+    {
+        constexpr uint32_t numLowerAlphabets = 'z' - 'a' + 1;
+        uint32_t numPermutationIndex = 0;
+        while (numNodes > 0)
+        {
+            numNodes /= numLowerAlphabets;
+            ++numPermutationIndex;
+        }
+        _permutationIndices.resize(numPermutationIndex, 0);
+    }
+
+    std::string getNextAlphabetPermutation()
+    {
+        std::string alphabetPermutation;
         bool needToIncrementAlphabet = true;
         for (uint8_t& permutationIndex : _permutationIndices)
         {
@@ -449,10 +2135,16 @@ void FrameGraph::dumpGraphViz(std::ostringstream& osstr)
     {
         VirtualResource* vresource = _resources[getResourceSlot(resourceNode->getResourceHandle())._resourceIndex];
 
+        uint32_t version = 0;
+        for (const ResourceNode* node = resourceNode->getPreviousVersionNode(); node != nullptr; node = node->getPreviousVersionNode())
+        {
+            ++version;
+        }
+
         const std::string& nodeLabel = permutator.getNextAlphabetPermutation();
         nodeLabelMap[resourceNode->getNodeID()] = nodeLabel;
-        osstr << "\t" << nodeLabel << "[ label=\"" << vresource->getResourceName() << "\" shape=label " << (resourceNode->isCulled() ? "style=dashed" : "")
-              << "];\n";
+        osstr << "\t" << nodeLabel << "[ label=\"" << vresource->getResourceName() << " v" << version << "\" shape=label "
+              << (resourceNode->isCulled() ? "style=dashed" : "") << "];\n";
     }
     osstr << '\n';
 
@@ -460,6 +2152,10 @@ void FrameGraph::dumpGraphViz(std::ostringstream& osstr)
     {
         osstr << '\t' << nodeLabelMap[edge->_fromNodeID] << " -> " << nodeLabelMap[edge->_toNodeID] << '\n';
     }
+
+    osstr << "\tlabel=\"transient memory : " << _transientMemoryStats._peakBytesWithoutAliasing << " bytes -> "
+          << _transientMemoryStats._peakBytesWithAliasing << " bytes (" << _transientMemoryStats._numTransientResources << " resources in "
+          << _transientMemoryStats._numMemorySlots << " slots)\";\n";
     osstr << '}';
 }
 }  // namespace RenderGraph
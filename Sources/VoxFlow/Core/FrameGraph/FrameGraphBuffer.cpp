@@ -0,0 +1,140 @@
+// Author : snowapril
+
+#include <VoxFlow/Core/FrameGraph/FrameGraphBuffer.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <VoxFlow/Core/Resources/Buffer.hpp>
+#include <VoxFlow/Core/Resources/RenderResourceAllocator.hpp>
+#include <VoxFlow/Core/Utils/HashUtil.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+
+namespace VoxFlow
+{
+
+namespace RenderGraph
+{
+bool FrameGraphBuffer::create(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage)
+{
+    VOX_ASSERT(static_cast<uint32_t>(usage & BufferUsage::Readback) == 0 && static_cast<uint32_t>(usage & BufferUsage::Upload) == 0,
+               "Transient buffer({}) must not be mapped", debugName);
+
+    _bufferView = resourceAllocator->allocateTransientBuffer(descriptor._size, std::string(debugName));
+
+    return _bufferView != nullptr;
+}
+
+void FrameGraphBuffer::transferQueueOwnership(CommandStream* cmdStream, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex, bool isRelease) const
+{
+    VOX_ASSERT(_bufferView != nullptr, "Buffer must be devirtualized before transferring its queue ownership");
+
+    ResourceView* bufferView = _bufferView;
+    if (isRelease)
+    {
+        cmdStream->addJob<CommandJobType::ReleaseQueueOwnership>(bufferView, srcQueueFamilyIndex, dstQueueFamilyIndex);
+    }
+    else
+    {
+        cmdStream->addJob<CommandJobType::AcquireQueueOwnership>(bufferView, srcQueueFamilyIndex, dstQueueFamilyIndex);
+    }
+}
+
+static ResourceAccessMask convertToAccessMask(BufferUsage usage)
+{
+    ResourceAccessMask accessMask = static_cast<ResourceAccessMask>(0);
+
+    if (static_cast<uint32_t>(usage & BufferUsage::ConstantBuffer) > 0)
+        accessMask |= ResourceAccessMask::UniformBuffer;
+    if (static_cast<uint32_t>(usage & BufferUsage::RwStructuredBuffer) > 0)
+        accessMask |= ResourceAccessMask::StorageBuffer;
+    if (static_cast<uint32_t>(usage & BufferUsage::VertexBuffer) > 0)
+        accessMask |= ResourceAccessMask::VertexBuffer;
+    if (static_cast<uint32_t>(usage & BufferUsage::IndexBuffer) > 0)
+        accessMask |= ResourceAccessMask::IndexBuffer;
+    if (static_cast<uint32_t>(usage & BufferUsage::IndirectCommand) > 0)
+        accessMask |= ResourceAccessMask::IndirectBuffer;
+    if (static_cast<uint32_t>(usage & BufferUsage::CopySrc) > 0)
+        accessMask |= ResourceAccessMask::TransferSource;
+    if (static_cast<uint32_t>(usage & BufferUsage::CopyDst) > 0)
+        accessMask |= ResourceAccessMask::TransferDest;
+
+    return (static_cast<uint32_t>(accessMask) > 0) ? accessMask : ResourceAccessMask::Undefined;
+}
+
+static VkPipelineStageFlags convertToPipelineStageFlags(BufferUsage usage, CommandStreamUsage queueUsage)
+{
+    // Shader stages which access the buffer are not known at compile time, so every stage supported by the queue is used
+    VkPipelineStageFlags shaderStageFlags = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    if (queueUsage == CommandStreamUsage::Graphics)
+    {
+        shaderStageFlags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
+
+    VkPipelineStageFlags stageFlags = VK_PIPELINE_STAGE_NONE;
+
+    if (static_cast<uint32_t>(usage & (BufferUsage::ConstantBuffer | BufferUsage::RwStructuredBuffer)) > 0)
+        stageFlags |= shaderStageFlags;
+    if (static_cast<uint32_t>(usage & (BufferUsage::VertexBuffer | BufferUsage::IndexBuffer)) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    if (static_cast<uint32_t>(usage & BufferUsage::IndirectCommand) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    if (static_cast<uint32_t>(usage & (BufferUsage::CopySrc | BufferUsage::CopyDst)) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    return stageFlags;
+}
+
+bool FrameGraphBuffer::isReadOnlyUsage(Usage usage)
+{
+    const Usage writableUsages = BufferUsage::RwStructuredBuffer | BufferUsage::CopyDst;
+    return static_cast<uint32_t>(usage & writableUsages) == 0;
+}
+
+void FrameGraphBuffer::addPlannedBarrier(CommandStream* cmdStream, Usage usage, CommandStreamUsage queueUsage) const
+{
+    VOX_ASSERT(_bufferView != nullptr, "Buffer must be devirtualized before recording its barrier");
+
+    ResourceAccessMask accessMask = convertToAccessMask(usage);
+    if (accessMask == ResourceAccessMask::Undefined)
+    {
+        return;
+    }
+
+    ResourceView* bufferView = _bufferView;
+    VkPipelineStageFlags nextStageFlags = convertToPipelineStageFlags(usage, queueUsage);
+    cmdStream->addJob<CommandJobType::AddPlannedBarrier>(bufferView, accessMask, nextStageFlags);
+}
+
+void FrameGraphBuffer::signalSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex, Usage usage, CommandStreamUsage queueUsage) const
+{
+    VOX_ASSERT(_bufferView != nullptr, "Buffer must be devirtualized before recording its barrier");
+
+    SplitBarrier* splitBarrier = cmdStream->getSplitBarrier(splitBarrierIndex);
+    ResourceView* bufferView = _bufferView;
+    ResourceAccessMask accessMask = convertToAccessMask(usage);
+    VkPipelineStageFlags nextStageFlags = convertToPipelineStageFlags(usage, queueUsage);
+    cmdStream->addJob<CommandJobType::SignalSplitBarrier>(splitBarrier, bufferView, accessMask, nextStageFlags);
+}
+
+void FrameGraphBuffer::waitSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex) const
+{
+    SplitBarrier* splitBarrier = cmdStream->getSplitBarrier(splitBarrierIndex);
+    cmdStream->addJob<CommandJobType::WaitSplitBarrier>(splitBarrier);
+}
+
+void FrameGraphBuffer::destroy(RenderResourceAllocator* resourceAllocator)
+{
+    (void)resourceAllocator;
+    _bufferView = nullptr;
+}
+}  // namespace RenderGraph
+
+}  // namespace VoxFlow
+
+std::size_t std::hash<VoxFlow::RenderGraph::FrameGraphBuffer::Descriptor>::operator()(
+    VoxFlow::RenderGraph::FrameGraphBuffer::Descriptor const& descriptor) const noexcept
+{
+    uint32_t seed = 0;
+
+    VoxFlow::hash_combine(seed, descriptor._size);
+
+    return seed;
+}
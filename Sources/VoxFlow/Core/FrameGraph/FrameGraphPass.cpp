@@ -5,6 +5,8 @@
 #include <VoxFlow/Core/FrameGraph/FrameGraphResources.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
 #include <glm/common.hpp>
 
 namespace VoxFlow
@@ -21,7 +23,12 @@ FrameGraphPassBase::~FrameGraphPassBase()
 {
 }
 
-PassNode::PassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName) : DependencyGraph::Node(ownerFrameGraph->getDependencyGraph()), _passName(passName)
+PassNode::PassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName)
+    : DependencyGraph::Node((ownerFrameGraph != nullptr) ? ownerFrameGraph->getDependencyGraph() : nullptr),
+      _declaredHandles(arenaAllocator),
+      _devirtualizes(arenaAllocator),
+      _destroyes(arenaAllocator),
+      _passName(arenaAllocator->copyString(passName))
 {
 }
 
@@ -38,7 +45,12 @@ PassNode& PassNode::operator=(PassNode&& passNode)
 {
     if (this != &passNode)
     {
-        _passName = std::move(passNode._passName);
+        _declaredHandles = std::move(passNode._declaredHandles);
+        _devirtualizes = std::move(passNode._devirtualizes);
+        _destroyes = std::move(passNode._destroyes);
+        _passName = passNode._passName;
+        _enablePredicate = std::move(passNode._enablePredicate);
+        _queueAffinity = passNode._queueAffinity;
         _hasSideEffect = passNode._hasSideEffect;
     }
 
@@ -50,7 +62,15 @@ void PassNode::registerResource(FrameGraph* frameGraph, ResourceHandle resourceH
 {
     VirtualResource* resource = frameGraph->getVirtualResource(resourceHandle);
     resource->isReferencedByPass(this);
-    _declaredHandles.insert(resourceHandle);
+    if (isDeclaredHandle(resourceHandle) == false)
+    {
+        _declaredHandles.push_back(resourceHandle);
+    }
+}
+
+bool PassNode::isDeclaredHandle(ResourceHandle resourceHandle) const
+{
+    return std::find(_declaredHandles.begin(), _declaredHandles.end(), resourceHandle) != _declaredHandles.end();
 }
 
 void PassNode::addDevirtualize(VirtualResource* resource)
@@ -63,50 +83,36 @@ void PassNode::addDestroy(VirtualResource* resource)
     _destroyes.push_back(resource);
 }
 
+bool RenderPassData::hasAttachment(ResourceHandle handle) const
+{
+    return (_depthStencilHandle == handle) || (std::find(_colorAttachmentHandles.begin(), _colorAttachmentHandles.end(), handle) != _colorAttachmentHandles.end());
+}
+
 void RenderPassData::devirtualize(FrameGraph* frameGraph, RenderResourceAllocator* allocator)
 {
     (void)allocator;
 
-    std::vector<Attachment> colorAttachments;
-    Attachment depthStencilAttachment(nullptr);
+    const auto getAttachmentView = [frameGraph](ResourceHandle handle) -> TextureView* {
+        Resource<FrameGraphTexture>* resource = static_cast<Resource<FrameGraphTexture>*>(frameGraph->getVirtualResource(handle));
 
-    for (uint32_t i = 0; i < MAX_RENDER_TARGET_COUNTS; ++i)
-    {
-        ResourceHandle colorHandle = _descriptor._attachments[i];
-        if (colorHandle)
+        if (resource->isImported())
         {
-            Resource<FrameGraphTexture>* resource = static_cast<Resource<FrameGraphTexture>*>(frameGraph->getVirtualResource(colorHandle));
+            return static_cast<ImportedRenderTarget*>(resource)->getTextureView();
+        }
+        return resource->getInternalResource()._textureView;
+    };
 
-            TextureView* attachmentView = nullptr;
-            if (resource->isImported())
-            {
-                attachmentView = static_cast<ImportedRenderTarget*>(resource)->getTextureView();
-            }
-            else
-            {
-                attachmentView = resource->getInternalResource()._textureView;
-            }
+    std::vector<Attachment> colorAttachments;
+    Attachment depthStencilAttachment(nullptr);
 
-            colorAttachments.emplace_back(attachmentView);
-        }
+    for (ResourceHandle colorHandle : _colorAttachmentHandles)
+    {
+        colorAttachments.emplace_back(getAttachmentView(colorHandle));
     }
 
-    if (_descriptor._attachments[MAX_RENDER_TARGET_COUNTS])
+    if (_depthStencilHandle)
     {
-        Resource<FrameGraphTexture>* resource =
-            static_cast<Resource<FrameGraphTexture>*>(frameGraph->getVirtualResource(_descriptor._attachments[MAX_RENDER_TARGET_COUNTS]));
-
-        TextureView* attachmentView = nullptr;
-        if (resource->isImported())
-        {
-            attachmentView = static_cast<ImportedRenderTarget*>(resource)->getTextureView();
-        }
-        else
-        {
-            attachmentView = resource->getInternalResource()._textureView;
-        }
-
-        depthStencilAttachment = Attachment(attachmentView);
+        depthStencilAttachment = Attachment(getAttachmentView(_depthStencilHandle));
     }
 
     _attachmentGroup = AttachmentGroup(std::move(colorAttachments), std::move(depthStencilAttachment), _descriptor._numSamples);
@@ -117,14 +123,13 @@ void RenderPassData::destroy(RenderResourceAllocator* allocator)
     (void)allocator;
 }
 
-RenderPassNode::RenderPassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName, std::unique_ptr<FrameGraphPassBase>&& pass)
-    : PassNode(ownerFrameGraph, std::move(passName)), _passImpl(std::move(pass))
+RenderPassNode::RenderPassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName, FrameGraphPassBase* pass)
+    : PassNode(ownerFrameGraph, arenaAllocator, std::move(passName)), _passImpl(pass), _renderPassDatas(arenaAllocator)
 {
 }
 
 RenderPassNode::~RenderPassNode()
 {
-    _passImpl.reset();
 }
 
 RenderPassNode::RenderPassNode(RenderPassNode&& passNode) : PassNode(std::move(passNode))
@@ -136,7 +141,7 @@ RenderPassNode& RenderPassNode::operator=(RenderPassNode&& passNode)
 {
     if (this != &passNode)
     {
-        _passImpl.swap(passNode._passImpl);
+        std::swap(_passImpl, passNode._passImpl);
         _renderPassDatas.swap(passNode._renderPassDatas);
     }
 
@@ -209,11 +214,94 @@ void RenderPassNode::resolve(FrameGraph* frameGraph)
         rpData._passParams._clearDepth = rpData._descriptor._clearDepth;
         rpData._passParams._clearStencil = rpData._descriptor._clearStencil;
         rpData._passParams._writableAttachment = rpData._descriptor._writableAttachment;
+        rpData._passParams._subpassLayouts.clear();
+        rpData._passParams._subpassIndex = 0;
+        rpData._passParams._useSecondaryCommandBuffers = rpData._descriptor._useSecondaryCommandBuffers;
+
+        rpData._colorAttachmentHandles.clear();
+        for (uint32_t i = 0; i < MAX_RENDER_TARGET_COUNTS; ++i)
+        {
+            if (rpData._descriptor._attachments[i])
+            {
+                rpData._colorAttachmentHandles.push_back(rpData._descriptor._attachments[i]);
+            }
+        }
+        rpData._depthStencilHandle = rpData._descriptor._attachments[MAX_RENDER_TARGET_COUNTS];
+
+        SubpassLayout subpassLayout;
+        subpassLayout._outputAttachments = rpData._depthStencilHandle ? AttachmentMaskFlags::DepthStencil : AttachmentMaskFlags::None;
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(rpData._colorAttachmentHandles.size()); ++slot)
+        {
+            subpassLayout._outputAttachments |= static_cast<AttachmentMaskFlags>(static_cast<uint32_t>(AttachmentMaskFlags::Color0) << slot);
+        }
+
+        // Input attachment is placed after color attachments and loaded at the beginning of render pass
+        for (ResourceHandle inputHandle : rpData._descriptor._inputAttachments)
+        {
+            if (inputHandle)
+            {
+                VOX_ASSERT(std::find(rpData._colorAttachmentHandles.begin(), rpData._colorAttachmentHandles.end(), inputHandle) ==
+                               rpData._colorAttachmentHandles.end(),
+                           "Color attachment written by render pass({}) must not be read as input attachment", rpData._renderPassName);
+
+                subpassLayout._inputAttachmentSlots[subpassLayout._numInputAttachments++] = static_cast<uint8_t>(rpData._colorAttachmentHandles.size());
+                rpData._colorAttachmentHandles.push_back(inputHandle);
+            }
+        }
+
+        if (subpassLayout._numInputAttachments > 0)
+        {
+            VOX_ASSERT(rpData._colorAttachmentHandles.size() <= MAX_RENDER_TARGET_COUNTS, "Render pass({}) can have at most {} color and input attachments",
+                       rpData._renderPassName, MAX_RENDER_TARGET_COUNTS);
+            rpData._passParams._subpassLayouts.push_back(subpassLayout);
+        }
+    }
+}
+
+void RenderPassNode::inferAttachmentOperations(FrameGraph* frameGraph)
+{
+    const auto isUsedByRenderPasses = [](auto begin, auto end, ResourceHandle handle) {
+        return std::any_of(begin, end, [handle](const RenderPassData& rpData) { return rpData.hasAttachment(handle); });
+    };
+
+    for (auto rpIter = _renderPassDatas.begin(); rpIter != _renderPassDatas.end(); ++rpIter)
+    {
+        uint32_t loadFlags = 0;
+        uint32_t storeFlags = 0;
+
+        // Imported and history attachments are written and read outside of the frame
+        const auto inferOperations = [&](ResourceHandle handle, const AttachmentMaskFlags attachmentMask) {
+            const VirtualResource* resource = frameGraph->getVirtualResource(handle);
+
+            const bool isWrittenBefore = resource->isPersistent() || (resource->getFirstReferencedPassNode() != this) ||
+                                         isUsedByRenderPasses(_renderPassDatas.begin(), rpIter, handle);
+            const bool isReferencedAfter = resource->isPersistent() || (resource->getLastReferencedPassNode() != this) ||
+                                           isUsedByRenderPasses(std::next(rpIter), _renderPassDatas.end(), handle);
+
+            loadFlags |= isWrittenBefore ? static_cast<uint32_t>(attachmentMask) : 0U;
+            storeFlags |= isReferencedAfter ? static_cast<uint32_t>(attachmentMask) : 0U;
+        };
+
+        RenderPassData& rpData = *rpIter;
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(rpData._colorAttachmentHandles.size()); ++slot)
+        {
+            inferOperations(rpData._colorAttachmentHandles[slot],
+                            static_cast<AttachmentMaskFlags>(static_cast<uint32_t>(AttachmentMaskFlags::Color0) << slot));
+        }
+
+        if (rpData._depthStencilHandle)
+        {
+            inferOperations(rpData._depthStencilHandle, AttachmentMaskFlags::DepthStencil);
+        }
+
+        rpData._passParams._attachmentFlags._loadFlags = static_cast<AttachmentMaskFlags>(loadFlags);
+        rpData._passParams._attachmentFlags._storeFlags = static_cast<AttachmentMaskFlags>(storeFlags);
     }
 }
 
-PresentPassNode::PresentPassNode(FrameGraph* ownerFrameGraph, std::string_view&& passName, SwapChain* swapChainToPresent, const FrameContext& frameContext)
-    : PassNode(ownerFrameGraph, std::move(passName)), _swapChainToPresent(swapChainToPresent), _frameContext(frameContext)
+PresentPassNode::PresentPassNode(FrameGraph* ownerFrameGraph, ArenaAllocator* arenaAllocator, std::string_view&& passName, SwapChain* swapChainToPresent,
+                                 const FrameContext& frameContext)
+    : PassNode(ownerFrameGraph, arenaAllocator, std::move(passName)), _swapChainToPresent(swapChainToPresent), _frameContext(frameContext)
 {
 }
 
@@ -234,11 +322,11 @@ PresentPassNode& PresentPassNode::operator=(PresentPassNode&& passNode)
 
 void PresentPassNode::execute(const FrameGraphResources* resources, CommandStream* cmdStream)
 {
-    cmdStream->addJob(CommandJobType::MakeSwapChainFinalLayout, _swapChainToPresent, _frameContext._backBufferIndex);
+    cmdStream->addJob<CommandJobType::MakeSwapChainFinalLayout>(_swapChainToPresent, _frameContext._backBufferIndex);
 
     FenceObject executedFence = cmdStream->flush(_swapChainToPresent, &_frameContext, false);
 
-    resources->getFrameGraph()->setLastSubmitFence(executedFence);
+    resources->getFrameGraph()->setFrameSubmitFence(CommandStreamUsage::Graphics, executedFence);
 }
 
 }  // namespace RenderGraph
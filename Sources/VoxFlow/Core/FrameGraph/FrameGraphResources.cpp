@@ -3,6 +3,9 @@
 #include <VoxFlow/Core/FrameGraph/FrameGraph.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphPass.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphResources.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
 
 namespace VoxFlow
 {
@@ -28,6 +31,28 @@ TextureView* FrameGraphResources::getTextureView(ResourceHandle handle) const
     return attachmentView;
 }
 
+void FrameGraphResources::recordSecondaryCommands(CommandStream* cmdStream, const uint32_t numItems, const uint32_t numItemsPerChunk,
+                                                  const std::function<void(SecondaryCommandGroup*, uint32_t, uint32_t, uint32_t)>& recordChunk) const
+{
+    VOX_ASSERT(numItemsPerChunk > 0, "Pass({}) must record at least one item per chunk", _passNode->getPassName());
+
+    const uint32_t numChunks = (numItems + numItemsPerChunk - 1) / numItemsPerChunk;
+    if (numChunks == 0)
+    {
+        return;
+    }
+
+    SecondaryCommandGroup* secondaryCmdGroup = cmdStream->acquireSecondaryCommandGroup(numChunks);
+
+    _frameGraph->runRecordingTasks(numChunks, [&](const uint32_t chunkIndex) {
+        const uint32_t itemBegin = chunkIndex * numItemsPerChunk;
+        const uint32_t itemEnd = std::min(itemBegin + numItemsPerChunk, numItems);
+        recordChunk(secondaryCmdGroup, chunkIndex, itemBegin, itemEnd);
+    });
+
+    cmdStream->addJob<CommandJobType::ExecuteSecondaryCommands>(secondaryCmdGroup);
+}
+
 }  // namespace RenderGraph
 
 }  // namespace VoxFlow
\ No newline at end of file
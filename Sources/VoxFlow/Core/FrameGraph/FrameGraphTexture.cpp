@@ -1,47 +1,232 @@
 // Author : snowapril
 
 #include <VoxFlow/Core/FrameGraph/FrameGraphTexture.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
 #include <VoxFlow/Core/Resources/RenderResourceAllocator.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
+#include <VoxFlow/Core/Utils/HashUtil.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <glm/common.hpp>
 
 namespace VoxFlow
 {
 
 namespace RenderGraph
 {
-bool FrameGraphTexture::create(RenderResourceAllocator* resourceAllocator, std::string&& debugName, Descriptor descriptor, Usage usage)
+bool FrameGraphTexture::create(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage)
 {
-    // TODO(snowapril) :
+    const glm::uvec3 extent(descriptor._width, descriptor._height, descriptor._depth);
+
+    _texture = resourceAllocator->acquireTransientTexture(TextureInfo{ ._extent = extent,
+                                                                       ._format = descriptor._format,
+                                                                       ._imageType = convertToImageType(extent),
+                                                                       ._usage = usage,
+                                                                       ._numSamples = glm::max(static_cast<uint32_t>(descriptor._sampleCounts), 1U) },
+                                                          debugName);
+
+    if (_texture == nullptr)
+    {
+        return false;
+    }
+
+    // Pooled texture keeps its default view across frames rather than creating new one every frame.
+    _textureView = _texture->getDefaultView();
+    _isPooled = true;
 
+    return true;
+}
+
+bool FrameGraphTexture::createPersistent(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage)
+{
     const glm::uvec3 extent(descriptor._width, descriptor._height, descriptor._depth);
-    const VkImageType imageType = convertToImageType(extent);
-    const VkImageViewType imageViewType = convertToImageViewType(imageType, extent);
 
-    _texture = resourceAllocator->allocateTexture(TextureInfo{ ._extent = glm::uvec3(descriptor._width, descriptor._height, descriptor._depth),
+    _texture = resourceAllocator->allocateTexture(TextureInfo{ ._extent = extent,
                                                                ._format = descriptor._format,
-                                                               ._imageType = imageType,
-                                                               ._usage = usage },
-                                                  std::move(debugName));
-
-    uint32_t viewIndex = _texture
-                             ->createTextureView(TextureViewInfo{ ._viewType = imageViewType,
-                                                                  ._format = descriptor._format,
-                                                                  ._aspectFlags = convertToImageAspectFlags(descriptor._format),
-                                                                  ._baseMipLevel = descriptor._level,
-                                                                  ._levelCount = 1,
-                                                                  ._baseArrayLayer = 0,
-                                                                  ._layerCount = 1 })
-                             .value();
-
-    _textureView = _texture->getView(viewIndex).get();
+                                                               ._imageType = convertToImageType(extent),
+                                                               ._usage = usage,
+                                                               ._numSamples = glm::max(static_cast<uint32_t>(descriptor._sampleCounts), 1U) },
+                                                  std::string(debugName));
+
+    if (_texture == nullptr)
+    {
+        _textureView = nullptr;
+        return false;
+    }
+
+    _textureView = _texture->getDefaultView();
+    _isPooled = false;
+
+    return true;
+}
+
+bool FrameGraphTexture::createAliased(RenderResourceAllocator* resourceAllocator, std::string_view debugName, Descriptor descriptor, Usage usage,
+                                      uint32_t transientSlot)
+{
+    const glm::uvec3 extent(descriptor._width, descriptor._height, descriptor._depth);
+
+    _texture = resourceAllocator->allocateAliasedTexture(
+        TextureInfo{ ._extent = extent,
+                     ._format = descriptor._format,
+                     ._imageType = convertToImageType(extent),
+                     ._usage = usage,
+                     ._numSamples = glm::max(static_cast<uint32_t>(descriptor._sampleCounts), 1U) },
+        transientSlot, debugName);
+
+    if (_texture == nullptr)
+    {
+        return false;
+    }
+
+    _textureView = _texture->getDefaultView();
+    _isPooled = false;
 
     return true;
 }
 
+void FrameGraphTexture::addAliasingBarrier(CommandStream* cmdStream) const
+{
+    VOX_ASSERT(_textureView != nullptr, "Texture must be devirtualized before recording its aliasing barrier");
+
+    // Access state of the view is changed by packets of the previous occupants which are not translated yet,
+    // so the barrier is resolved at translation rather than here.
+    ResourceView* textureView = _textureView;
+    cmdStream->addJob<CommandJobType::AddAliasingBarrier>(textureView);
+}
+
+uint64_t FrameGraphTexture::estimateMemorySize(const Descriptor& descriptor)
+{
+    const uint64_t numTexels = static_cast<uint64_t>(descriptor._width) * glm::max(descriptor._height, 1U) * glm::max(descriptor._depth, 1U);
+    const uint64_t numSamples = glm::max(static_cast<uint64_t>(descriptor._sampleCounts), uint64_t(1));
+    return numTexels * numSamples * getFormatByteSize(descriptor._format);
+}
+
+FrameGraphTexture::Usage FrameGraphTexture::makeTransientAttachmentUsage(Usage usage)
+{
+    return usage | TextureUsage::TransientAttachment;
+}
+
+void FrameGraphTexture::transferQueueOwnership(CommandStream* cmdStream, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex, bool isRelease) const
+{
+    VOX_ASSERT(_textureView != nullptr, "Texture must be devirtualized before transferring its queue ownership");
+
+    ResourceView* textureView = _textureView;
+    if (isRelease)
+    {
+        cmdStream->addJob<CommandJobType::ReleaseQueueOwnership>(textureView, srcQueueFamilyIndex, dstQueueFamilyIndex);
+    }
+    else
+    {
+        cmdStream->addJob<CommandJobType::AcquireQueueOwnership>(textureView, srcQueueFamilyIndex, dstQueueFamilyIndex);
+    }
+}
+
+static ResourceAccessMask convertToAccessMask(TextureUsage usage)
+{
+    ResourceAccessMask accessMask = static_cast<ResourceAccessMask>(0);
+
+    // Input attachment stays in attachment layout out of render pass, and the render pass transits it
+    if (static_cast<uint32_t>(usage & (TextureUsage::RenderTarget | TextureUsage::BackBuffer | TextureUsage::InputAttachment)) > 0)
+        accessMask |= ResourceAccessMask::ColorAttachment;
+    if (static_cast<uint32_t>(usage & TextureUsage::DepthStencil) > 0)
+        accessMask |= ResourceAccessMask::DepthAttachment;
+    if (static_cast<uint32_t>(usage & TextureUsage::Sampled) > 0)
+        accessMask |= ResourceAccessMask::ShaderReadOnly;
+    if (static_cast<uint32_t>(usage & TextureUsage::Storage) > 0)
+        accessMask |= ResourceAccessMask::General;
+    if (static_cast<uint32_t>(usage & TextureUsage::CopySrc) > 0)
+        accessMask |= ResourceAccessMask::TransferSource;
+    if (static_cast<uint32_t>(usage & TextureUsage::CopyDst) > 0)
+        accessMask |= ResourceAccessMask::TransferDest;
+
+    return (static_cast<uint32_t>(accessMask) > 0) ? accessMask : ResourceAccessMask::Undefined;
+}
+
+static VkPipelineStageFlags convertToPipelineStageFlags(TextureUsage usage, CommandStreamUsage queueUsage)
+{
+    // Shader stages which access the texture are not known at compile time, so every stage supported by the queue is used
+    VkPipelineStageFlags shaderStageFlags = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    if (queueUsage == CommandStreamUsage::Graphics)
+    {
+        shaderStageFlags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
+
+    VkPipelineStageFlags stageFlags = VK_PIPELINE_STAGE_NONE;
+
+    if (static_cast<uint32_t>(usage & (TextureUsage::RenderTarget | TextureUsage::BackBuffer | TextureUsage::InputAttachment)) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    if (static_cast<uint32_t>(usage & TextureUsage::DepthStencil) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    if (static_cast<uint32_t>(usage & (TextureUsage::Sampled | TextureUsage::Storage)) > 0)
+        stageFlags |= shaderStageFlags;
+    if (static_cast<uint32_t>(usage & (TextureUsage::CopySrc | TextureUsage::CopyDst)) > 0)
+        stageFlags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    return stageFlags;
+}
+
+bool FrameGraphTexture::isReadOnlyUsage(Usage usage)
+{
+    const Usage writableUsages = TextureUsage::RenderTarget | TextureUsage::DepthStencil | TextureUsage::Storage | TextureUsage::CopyDst |
+                                     TextureUsage::BackBuffer;
+    return static_cast<uint32_t>(usage & writableUsages) == 0;
+}
+
+void FrameGraphTexture::addPlannedBarrier(CommandStream* cmdStream, Usage usage, CommandStreamUsage queueUsage) const
+{
+    VOX_ASSERT(_textureView != nullptr, "Texture must be devirtualized before recording its barrier");
+
+    ResourceAccessMask accessMask = convertToAccessMask(usage);
+    if (accessMask == ResourceAccessMask::Undefined)
+    {
+        return;
+    }
+
+    ResourceView* textureView = _textureView;
+    VkPipelineStageFlags nextStageFlags = convertToPipelineStageFlags(usage, queueUsage);
+    cmdStream->addJob<CommandJobType::AddPlannedBarrier>(textureView, accessMask, nextStageFlags);
+}
+
+void FrameGraphTexture::signalSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex, Usage usage, CommandStreamUsage queueUsage) const
+{
+    VOX_ASSERT(_textureView != nullptr, "Texture must be devirtualized before recording its barrier");
+
+    SplitBarrier* splitBarrier = cmdStream->getSplitBarrier(splitBarrierIndex);
+    ResourceView* textureView = _textureView;
+    ResourceAccessMask accessMask = convertToAccessMask(usage);
+    VkPipelineStageFlags nextStageFlags = convertToPipelineStageFlags(usage, queueUsage);
+    cmdStream->addJob<CommandJobType::SignalSplitBarrier>(splitBarrier, textureView, accessMask, nextStageFlags);
+}
+
+void FrameGraphTexture::waitSplitBarrier(CommandStream* cmdStream, uint32_t splitBarrierIndex) const
+{
+    SplitBarrier* splitBarrier = cmdStream->getSplitBarrier(splitBarrierIndex);
+    cmdStream->addJob<CommandJobType::WaitSplitBarrier>(splitBarrier);
+}
+
 void FrameGraphTexture::destroy(RenderResourceAllocator* resourceAllocator)
 {
-    (void)resourceAllocator;
+    if (_isPooled)
+    {
+        resourceAllocator->releaseTransientTexture(std::move(_texture));
+        _textureView = nullptr;
+        _isPooled = false;
+    }
 }
 }  // namespace RenderGraph
 
-}  // namespace VoxFlow
\ No newline at end of file
+}  // namespace VoxFlow
+
+std::size_t std::hash<VoxFlow::RenderGraph::FrameGraphTexture::Descriptor>::operator()(
+    VoxFlow::RenderGraph::FrameGraphTexture::Descriptor const& descriptor) const noexcept
+{
+    uint32_t seed = 0;
+
+    VoxFlow::hash_combine(seed, descriptor._width);
+    VoxFlow::hash_combine(seed, descriptor._height);
+    VoxFlow::hash_combine(seed, descriptor._depth);
+    VoxFlow::hash_combine(seed, descriptor._level);
+    VoxFlow::hash_combine(seed, descriptor._sampleCounts);
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(descriptor._format));
+
+    return seed;
+}
@@ -20,24 +20,22 @@ static FrameGraphTexture::Usage convertAttachmentFlagsToUsage(FrameGraphRenderPa
 
 ResourceEdgeBase* ResourceNode::getReaderEdgeForPassNode(const PassNode* passNode)
 {
-    DependencyGraph::EdgeContainer outgoings = _ownerGraph->getOutgoingEdges(passNode->getNodeID());
+    // Reader edge is linked from this resource node into the given pass node
+    DependencyGraph::EdgeSpan incomings = _ownerGraph->getIncomingEdges(passNode->getNodeID());
 
-    auto iter = std::find_if(outgoings.begin(), outgoings.end(), [passNode, this](const DependencyGraph::Edge* edge) {
-        return edge->_fromNodeID == passNode->getNodeID() && edge->_toNodeID == _nodeId;
-    });
+    auto iter = std::find_if(incomings.begin(), incomings.end(), [this](const DependencyGraph::Edge* edge) { return edge->_fromNodeID == _nodeId; });
 
-    return iter == outgoings.end() ? nullptr : static_cast<ResourceEdgeBase*>(*iter);
+    return iter == incomings.end() ? nullptr : static_cast<ResourceEdgeBase*>(*iter);
 }
 
 ResourceEdgeBase* ResourceNode::getWriterEdgeForPassNode(const PassNode* passNode)
 {
-    DependencyGraph::EdgeContainer incomings = _ownerGraph->getIncomingEdges(passNode->getNodeID());
+    // Writer edge is linked from the given pass node into this resource node
+    DependencyGraph::EdgeSpan outgoings = _ownerGraph->getOutgoingEdges(passNode->getNodeID());
 
-    auto iter = std::find_if(incomings.begin(), incomings.end(), [passNode, this](const DependencyGraph::Edge* edge) {
-        return edge->_fromNodeID == passNode->getNodeID() && edge->_toNodeID == _nodeId;
-    });
+    auto iter = std::find_if(outgoings.begin(), outgoings.end(), [this](const DependencyGraph::Edge* edge) { return edge->_toNodeID == _nodeId; });
 
-    return iter == incomings.end() ? nullptr : static_cast<ResourceEdgeBase*>(*iter);
+    return iter == outgoings.end() ? nullptr : static_cast<ResourceEdgeBase*>(*iter);
 }
 
 void ResourceNode::addOutgoingEdge(DependencyGraph::Edge* edge)
@@ -54,10 +52,17 @@ void ResourceNode::setIncomingEdge(DependencyGraph::Edge* edge)
 void ResourceNode::resolveResourceUsage(FrameGraph* frameGraph)
 {
     VirtualResource* resource = frameGraph->getVirtualResource(_resourceHandle);
-    resource->resolveUsage(_ownerGraph, _outgoingEdges, _incomingEdge);
+
+    // Dead write overwritten by the next version is culled along with its writer pass
+    DependencyGraph::Edge* writerEdge = _incomingEdge;
+    if ((writerEdge != nullptr) && _ownerGraph->getNode(writerEdge->_fromNodeID)->isCulled())
+    {
+        writerEdge = nullptr;
+    }
+    resource->resolveUsage(_ownerGraph, _outgoingEdges, writerEdge);
 }
 
-VirtualResource::VirtualResource(std::string&& name) : _resourceName(std::move(name))
+VirtualResource::VirtualResource(std::string_view name) : _resourceName(name)
 {
 }
 VirtualResource ::~VirtualResource()
@@ -71,20 +76,62 @@ void VirtualResource::isReferencedByPass(PassNode* passNode)
     _lastPass = passNode;
 }
 
-ImportedRenderTarget::ImportedRenderTarget(std::string&& name, FrameGraphTexture::Descriptor&& resourceArgs,
+ImportedRenderTarget::ImportedRenderTarget(std::string_view name, FrameGraphTexture::Descriptor&& resourceArgs,
                                            typename FrameGraphRenderPass::ImportedDescriptor&& importedDesc, const FrameGraphTexture& resource,
                                            TextureView* textureView)
-    : ImportedResource<FrameGraphTexture>(std::move(name), std::move(resourceArgs), convertAttachmentFlagsToUsage(std::move(importedDesc)), resource),
+    : ImportedResource<FrameGraphTexture>(name, std::move(resourceArgs), convertAttachmentFlagsToUsage(std::move(importedDesc)), resource),
       _textureViewHandle(textureView)
 {
+    // Barriers planned by frame graph are recorded through the view of internal texture
+    this->_resource._textureView = textureView;
 }
 
 ImportedRenderTarget::~ImportedRenderTarget()
 {
 }
 
-ResourceNode::ResourceNode(DependencyGraph* dependencyGraph, ResourceHandle resourceHandle)
-    : DependencyGraph::Node(dependencyGraph), _resourceHandle(resourceHandle)
+HistoryTexture::HistoryTexture(std::string_view name, FrameGraphTexture::Descriptor&& resourceArgs, HistoryTextureStorage* storage, const uint32_t textureIndex)
+    : Resource<FrameGraphTexture>(name, std::move(resourceArgs)), _storage(storage), _textureIndex(textureIndex)
+{
+}
+
+TextureUsage HistoryTexture::getAllocationUsage() const
+{
+    TextureUsage usage = _storage->_usage | _usage;
+    if (_pairedTexture != nullptr)
+    {
+        usage |= _pairedTexture->_usage;
+    }
+    return usage;
+}
+
+void HistoryTexture::devirtualize(RenderResourceAllocator* allocator)
+{
+    // Both textures are allocated with the declared usage at once, rather than with usages of this frame only,
+    // so that reading the history in the next frame does not reallocate and lose the texture written in this frame.
+    const TextureUsage usage = getAllocationUsage();
+    VOX_ASSERT(usage == _storage->_usage, "History texture({}) is used with usage which is not declared at createHistory", _resourceName);
+
+    if (_storage->_isAllocationDirty || (usage != _storage->_allocatedUsage))
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(_storage->_textures.size()); ++i)
+        {
+            const bool result = _storage->_textures[i].createPersistent(allocator, fmt::format("{}[{}]", _resourceName, i), _descriptor, usage);
+            VOX_ASSERT(result, "Failed to allocate history texture({})", _resourceName);
+        }
+
+        _storage->_allocatedUsage = usage;
+        _storage->_isAllocationDirty = false;
+    }
+
+    _resource = _storage->_textures[_textureIndex];
+}
+
+ResourceNode::ResourceNode(DependencyGraph* dependencyGraph, ResourceHandle resourceHandle, ResourceNode* previousVersionNode)
+    : DependencyGraph::Node(dependencyGraph),
+      _resourceHandle(resourceHandle),
+      _previousVersionNode(previousVersionNode),
+      _outgoingEdges(dependencyGraph->getArenaAllocator())
 {
 }
 
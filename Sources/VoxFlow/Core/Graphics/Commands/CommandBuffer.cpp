@@ -22,9 +22,19 @@
 #include <VoxFlow/Core/Resources/StagingBuffer.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
+#include <mutex>
 
 namespace VoxFlow
 {
+namespace
+{
+inline VkSubpassContents getSubpassContents(const RenderPassParams& passParams)
+{
+    return passParams._useSecondaryCommandBuffers ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+}
+}  // namespace
+
 CommandBuffer::CommandBuffer(LogicalDevice* logicalDevice, VkCommandBuffer vkCommandBuffer)
     : _logicalDevice(logicalDevice), _vkCommandBuffer(vkCommandBuffer), _resourceBarrierManager(this)
 {
@@ -44,13 +54,7 @@ CommandBuffer::~CommandBuffer()
 
 void CommandBuffer::beginCommandBuffer(const FenceObject& fenceToSignal, const std::string& debugName)
 {
-    _debugName = debugName;
-
-    // Every resources and synchronization with this command buffer
-    // will use below new allocated fence.
-    _fenceToSignal = fenceToSignal;
-
-    VOX_ASSERT(_hasBegun == false, "Duplicated beginning on the same CommandBuffer({})", _debugName);
+    resetRecordingStates(fenceToSignal, debugName);
 
     VkCommandBufferBeginInfo beginInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -66,6 +70,75 @@ void CommandBuffer::beginCommandBuffer(const FenceObject& fenceToSignal, const s
 #endif
 }
 
+void CommandBuffer::beginSecondaryCommandBuffer(const CommandBuffer& primaryCmdBuffer, const std::string& debugName)
+{
+    VOX_ASSERT(primaryCmdBuffer._isInRenderPassScope, "Secondary CommandBuffer({}) must continue render pass of the primary one", debugName);
+
+    // Secondary command buffer signals together with the primary one which executes it
+    resetRecordingStates(primaryCmdBuffer._fenceToSignal, debugName);
+
+    _boundRenderPass = primaryCmdBuffer._boundRenderPass;
+    _boundFrameBuffer = primaryCmdBuffer._boundFrameBuffer;
+    _isInRenderPassScope = true;
+    _isSecondary = true;
+    _currentSubpassIndex = primaryCmdBuffer._currentSubpassIndex;
+    _numSubpasses = primaryCmdBuffer._numSubpasses;
+
+    const VkCommandBufferInheritanceInfo inheritanceInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = nullptr,
+        .renderPass = _boundRenderPass->get(),
+        .subpass = _currentSubpassIndex,
+        .framebuffer = _boundFrameBuffer,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags = 0,
+        .pipelineStatistics = 0,
+    };
+
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = nullptr,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &inheritanceInfo,
+    };
+    vkBeginCommandBuffer(_vkCommandBuffer, &beginInfo);
+    _hasBegun = true;
+
+#if defined(VK_DEBUG_NAME_ENABLED)
+    DebugUtil::setObjectName(_logicalDevice, _vkCommandBuffer, _debugName.c_str());
+#endif
+}
+
+void CommandBuffer::resetRecordingStates(const FenceObject& fenceToSignal, const std::string& debugName)
+{
+    _debugName = debugName;
+
+    // Every resources and synchronization with this command buffer
+    // will use below new allocated fence.
+    _fenceToSignal = fenceToSignal;
+
+    VOX_ASSERT(_hasBegun == false, "Duplicated beginning on the same CommandBuffer({})", _debugName);
+
+    // Command buffer is reused after its pool is reset, so states of the previous recording are cleared
+    _boundRenderPass = nullptr;
+    _boundFrameBuffer = VK_NULL_HANDLE;
+    _boundPipeline = nullptr;
+    _isInRenderPassScope = false;
+    _isSecondary = false;
+    _currentSubpassIndex = 0;
+    _numSubpasses = 1;
+    for (std::vector<ShaderSlotBinding>& pendingBindings : _pendingResourceBindings)
+    {
+        pendingBindings.clear();
+    }
+    for (std::vector<ShaderVariableBinding>& pendingBindings : _pendingVariableBindings)
+    {
+        pendingBindings.clear();
+    }
+    _shadowState = ShadowState();
+    _stateCommandStats = StateCommandStats();
+}
+
 void CommandBuffer::endCommandBuffer()
 {
     vkEndCommandBuffer(_vkCommandBuffer);
@@ -74,6 +147,17 @@ void CommandBuffer::endCommandBuffer()
 
 void CommandBuffer::beginRenderPass(const AttachmentGroup& attachmentGroup, const RenderPassParams& passParams)
 {
+    // Pass merged into the bound render pass only steps to its subpass
+    if (passParams._subpassIndex > 0)
+    {
+        VOX_ASSERT(_isInRenderPassScope && (passParams._subpassIndex == _currentSubpassIndex + 1),
+                   "Subpass({}) must follow the previous subpass of the bound render pass", passParams._subpassIndex);
+
+        vkCmdNextSubpass(_vkCommandBuffer, getSubpassContents(passParams));
+        _currentSubpassIndex = passParams._subpassIndex;
+        return;
+    }
+
     RenderPassCollector* renderPassCollector = _logicalDevice->getRenderPassCollector();
 
     const uint32_t numColorAttachments = attachmentGroup.getNumColorAttachments();
@@ -111,6 +195,7 @@ void CommandBuffer::beginRenderPass(const AttachmentGroup& attachmentGroup, cons
     _resourceBarrierManager.commitPendingBarriers(false);
 
     rtLayoutKey._renderPassFlags = passParams._attachmentFlags;
+    rtLayoutKey._subpassLayouts = passParams._subpassLayouts;
 
     _boundRenderPass = renderPassCollector->getOrCreateRenderPass(rtLayoutKey);
     rtInfo._vkRenderPass = _boundRenderPass->get();
@@ -121,6 +206,7 @@ void CommandBuffer::beginRenderPass(const AttachmentGroup& attachmentGroup, cons
     // rtInfo._numSamples = 0;
 
     auto frameBuffer = renderPassCollector->getOrCreateFrameBuffer(rtInfo);
+    _boundFrameBuffer = frameBuffer->get();
 
     std::vector<VkClearValue> clearValues;
     for (uint32_t i = 0; i < numColorAttachments; ++i)
@@ -143,56 +229,123 @@ void CommandBuffer::beginRenderPass(const AttachmentGroup& attachmentGroup, cons
                                              .clearValueCount = static_cast<uint32_t>(clearValues.size()),
                                              .pClearValues = clearValues.data() };
 
-    vkCmdBeginRenderPass(_vkCommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(_vkCommandBuffer, &renderPassInfo, getSubpassContents(passParams));
 
     _isInRenderPassScope = true;
+    _currentSubpassIndex = 0;
+    _numSubpasses = std::max(static_cast<uint32_t>(passParams._subpassLayouts.size()), 1U);
 }
 
 void CommandBuffer::endRenderPass()
 {
+    // Render pass is ended by its last subpass
+    if (_currentSubpassIndex + 1 < _numSubpasses)
+    {
+        return;
+    }
+
     vkCmdEndRenderPass(_vkCommandBuffer);
     _boundRenderPass = nullptr;
+    _boundFrameBuffer = VK_NULL_HANDLE;
     _isInRenderPassScope = false;
 }
 
+void CommandBuffer::executeSecondaryCommandBuffers(const std::vector<std::shared_ptr<CommandBuffer>>& secondaryCmdBuffers)
+{
+    VOX_ASSERT(_isInRenderPassScope, "Secondary command buffers must be executed inside render pass of CommandBuffer({})", _debugName);
+
+    static thread_local std::vector<VkCommandBuffer> sTmpVkCommandBuffers;
+    sTmpVkCommandBuffers.clear();
+    for (const std::shared_ptr<CommandBuffer>& secondaryCmdBuffer : secondaryCmdBuffers)
+    {
+        if (secondaryCmdBuffer != nullptr)
+        {
+            sTmpVkCommandBuffers.push_back(secondaryCmdBuffer->get());
+        }
+    }
+
+    if (sTmpVkCommandBuffers.empty() == false)
+    {
+        vkCmdExecuteCommands(_vkCommandBuffer, static_cast<uint32_t>(sTmpVkCommandBuffers.size()), sTmpVkCommandBuffers.data());
+    }
+
+    // States bound by the primary command buffer are undefined after executing secondary ones
+    _boundPipeline = nullptr;
+    _shadowState = ShadowState();
+}
+
 void CommandBuffer::bindVertexBuffer(Buffer* vertexBuffer)
 {
     // TODO(snowapril) : must implement details
     VkBuffer vkVertexBuffer = vertexBuffer->get();
-    const VkDeviceSize offsets[] = { 0 };
-    vkCmdBindVertexBuffers(_vkCommandBuffer, 0, 1, &vkVertexBuffer, offsets);
+    if (filterStateCommand(StateCommandType::BindVertexBuffer, _shadowState._vertexBuffer == vkVertexBuffer))
+    {
+        const VkDeviceSize offsets[] = { 0 };
+        vkCmdBindVertexBuffers(_vkCommandBuffer, 0, 1, &vkVertexBuffer, offsets);
+        _shadowState._vertexBuffer = vkVertexBuffer;
+    }
 }
 
 void CommandBuffer::bindIndexBuffer(Buffer* indexBuffer)
 {
     // TODO(snowapril) : must implement details
     VkBuffer vkIndexBuffer = indexBuffer->get();
-    vkCmdBindIndexBuffer(_vkCommandBuffer, vkIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    if (filterStateCommand(StateCommandType::BindIndexBuffer, _shadowState._indexBuffer == vkIndexBuffer))
+    {
+        vkCmdBindIndexBuffer(_vkCommandBuffer, vkIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        _shadowState._indexBuffer = vkIndexBuffer;
+    }
 }
 
 void CommandBuffer::bindPipeline(BasePipeline* pipeline)
 {
+    // Pipeline already set into this command buffer has been initialized, so initialization lock is skipped too
+    if ((pipeline == _boundPipeline) && (_shadowState._pipeline != VK_NULL_HANDLE) && (_shadowState._pipeline == pipeline->get()))
+    {
+        filterStateCommand(StateCommandType::BindPipeline, true);
+        return;
+    }
+
     _boundPipeline = pipeline;
 
-    if (_boundPipeline->validatePipeline() == false)
+    // Pipeline shared by passes recorded on multiple threads must be initialized only once
     {
-        VkPipelineBindPoint bindPoint = _boundPipeline->getBindPoint();
-        switch (bindPoint)
+        static std::mutex sPipelineInitLock;
+        std::lock_guard<std::mutex> scopedLock(sPipelineInitLock);
+
+        if (_boundPipeline->validatePipeline() == false)
         {
-            case VK_PIPELINE_BIND_POINT_GRAPHICS:
-                static_cast<GraphicsPipeline*>(_boundPipeline)->initialize(_boundRenderPass);
-                break;
+            VkPipelineBindPoint bindPoint = _boundPipeline->getBindPoint();
+            switch (bindPoint)
+            {
+                case VK_PIPELINE_BIND_POINT_GRAPHICS:
+                    static_cast<GraphicsPipeline*>(_boundPipeline)->initialize(_boundRenderPass, _currentSubpassIndex);
+                    break;
 
-            case VK_PIPELINE_BIND_POINT_COMPUTE:
-                static_cast<ComputePipeline*>(_boundPipeline)->initialize();
-                break;
+                case VK_PIPELINE_BIND_POINT_COMPUTE:
+                    static_cast<ComputePipeline*>(_boundPipeline)->initialize();
+                    break;
 
-            default:
-                VOX_ASSERT(false, "Failed to find valid bind point");
+                default:
+                    VOX_ASSERT(false, "Failed to find valid bind point");
+            }
         }
     }
 
-    vkCmdBindPipeline(_vkCommandBuffer, _boundPipeline->getBindPoint(), _boundPipeline->get());
+    const VkPipeline vkPipeline = _boundPipeline->get();
+    if (filterStateCommand(StateCommandType::BindPipeline, _shadowState._pipeline == vkPipeline))
+    {
+        vkCmdBindPipeline(_vkCommandBuffer, _boundPipeline->getBindPoint(), vkPipeline);
+        _shadowState._pipeline = vkPipeline;
+    }
+
+    // Descriptor sets bound with the other pipeline layout may be disturbed, so they are bound again
+    const VkPipelineLayout vkPipelineLayout = _boundPipeline->getPipelineLayout()->get();
+    if (_shadowState._pipelineLayout != vkPipelineLayout)
+    {
+        _shadowState._pipelineLayout = vkPipelineLayout;
+        _shadowState._descriptorSets.fill(VK_NULL_HANDLE);
+    }
 }
 
 void CommandBuffer::unbindPipeline()
@@ -202,6 +355,11 @@ void CommandBuffer::unbindPipeline()
 
 void CommandBuffer::setViewport(const glm::uvec2& viewportSize)
 {
+    if (filterStateCommand(StateCommandType::SetViewport, _shadowState._hasViewport && (_shadowState._viewportSize == viewportSize)) == false)
+    {
+        return;
+    }
+
     VkViewport viewport = {
         .x = 0, .y = 0, .width = static_cast<float>(viewportSize.x), .height = static_cast<float>(viewportSize.y), .minDepth = 0.0f, .maxDepth = 1.0f
     };
@@ -209,6 +367,9 @@ void CommandBuffer::setViewport(const glm::uvec2& viewportSize)
 
     VkRect2D scissor = { .offset = { .x = 0, .y = 0 }, .extent = { .width = viewportSize.x, .height = viewportSize.y } };
     vkCmdSetScissor(_vkCommandBuffer, 0, 1, &scissor);
+
+    _shadowState._viewportSize = viewportSize;
+    _shadowState._hasViewport = true;
 }
 
 void CommandBuffer::makeSwapChainFinalLayout(SwapChain* swapChain, const uint32_t backBufferIndex)
@@ -222,7 +383,7 @@ void CommandBuffer::makeSwapChainFinalLayout(SwapChain* swapChain, const uint32_
 
 void CommandBuffer::bindResourceGroup(SetSlotCategory setSlotCategory, std::vector<ShaderVariableBinding>&& shaderVariables)
 {
-    std::vector<ShaderVariableBinding>& dstBindingResources = _pendingResourceBindings[static_cast<uint32_t>(setSlotCategory)];
+    std::vector<ShaderVariableBinding>& dstBindingResources = _pendingVariableBindings[static_cast<uint32_t>(setSlotCategory)];
 
     if (dstBindingResources.empty())
     {
@@ -235,6 +396,58 @@ void CommandBuffer::bindResourceGroup(SetSlotCategory setSlotCategory, std::vect
     }
 }
 
+void CommandBuffer::bindResourceSlots(std::span<const ShaderSlotBinding> bindings)
+{
+    for (const ShaderSlotBinding& binding : bindings)
+    {
+        VOX_ASSERT(binding._slot.isValid(), "Binding slot must be resolved from the pipeline");
+        _pendingResourceBindings[static_cast<uint32_t>(binding._slot._setCategory)].push_back(binding);
+    }
+}
+
+void CommandBuffer::pushConstants(const uint32_t offset, const uint32_t size, const void* data)
+{
+    VOX_ASSERT(_boundPipeline != nullptr, "Pipeline must be bound before pushing constants");
+
+    const PipelineLayout* pipelineLayout = _boundPipeline->getPipelineLayout();
+    const PushConstantRange& pushConstantRange = pipelineLayout->getPushConstantRange();
+    VOX_ASSERT((offset % 4 == 0) && (size % 4 == 0), "Offset({}) and size({}) of push constants must be multiple of 4", offset, size);
+    VOX_ASSERT((offset >= pushConstantRange._offset) && (offset + size <= pushConstantRange._offset + pushConstantRange._size),
+               "Push constants [{}, {}) exceed the range of the bound pipeline [{}, {})", offset, offset + size, pushConstantRange._offset,
+               pushConstantRange._offset + pushConstantRange._size);
+
+    vkCmdPushConstants(_vkCommandBuffer, pipelineLayout->get(), pushConstantRange._stageFlags, offset, size, data);
+}
+
+void CommandBuffer::resolvePendingVariableBindings()
+{
+    const PipelineLayout::ShaderVariableMap& shaderVariableMap = _boundPipeline->getPipelineLayout()->getShaderVariableMap();
+
+    for (std::vector<ShaderVariableBinding>& bindGroup : _pendingVariableBindings)
+    {
+        for (const ShaderVariableBinding& resourceBinding : bindGroup)
+        {
+            const std::string& resourceBindingName = resourceBinding._variableName;
+
+            auto shaderVariableIter = shaderVariableMap.find(resourceBindingName);
+            if (shaderVariableIter == shaderVariableMap.end())
+            {
+                VOX_ASSERT(false,
+                           "Given shader variable name ({}) does not exist in "
+                           "the current pipeline.",
+                           resourceBindingName);
+                continue;
+            }
+
+            const ShaderBindingSlot& bindingSlot = shaderVariableIter->second;
+            _pendingResourceBindings[static_cast<uint32_t>(bindingSlot._setCategory)].push_back(
+                ShaderSlotBinding{ ._slot = bindingSlot, ._view = resourceBinding._view, ._usage = resourceBinding._usage });
+        }
+
+        bindGroup.clear();
+    }
+}
+
 static VkPipelineStageFlags evaluatePipelineStageFlags(ResourceView* view, ResourceAccessMask accessMask, VkShaderStageFlags usedStages)
 {
     VkPipelineStageFlags pipelineStageFlags = VK_PIPELINE_STAGE_NONE;
@@ -322,15 +535,15 @@ void CommandBuffer::commitPendingResourceBindings()
 {
     // TODO(snowapril) : split update descriptor sets according to set frequency
     const PipelineLayout* pipelineLayout = _boundPipeline->getPipelineLayout();
-
-    const PipelineLayout::ShaderVariableMap& shaderVariableMap = pipelineLayout->getShaderVariableMap();
     const PipelineLayoutDescriptor& pipelineLayoutDesc = pipelineLayout->getPipelineLayoutDescriptor();
 
+    resolvePendingVariableBindings();
+
     for (uint32_t setIndex = 1; setIndex < MAX_NUM_SET_SLOTS; ++setIndex)
     {
         const SetSlotCategory setSlotCategory = static_cast<SetSlotCategory>(setIndex);
 
-        std::vector<ShaderVariableBinding>& bindGroup = _pendingResourceBindings[setIndex];
+        std::vector<ShaderSlotBinding>& bindGroup = _pendingResourceBindings[setIndex];
 
         DescriptorSetAllocator* setAllocator = pipelineLayout->getDescSetAllocator(setSlotCategory);
         const DescriptorSetLayoutDesc& setLayoutDesc = setAllocator->getDescriptorSetLayoutDesc();
@@ -341,97 +554,52 @@ void CommandBuffer::commitPendingResourceBindings()
             continue;
         }
 
-        VkDescriptorSet pooledDescriptorSet = static_cast<PooledDescriptorSetAllocator*>(setAllocator)->getOrCreatePooledDescriptorSet(_fenceToSignal);
+        // Descriptor set bound by the previous draw still holds the bindings when nothing new is bound
+        if (bindGroup.empty() && (_shadowState._descriptorSets[setIndex] != VK_NULL_HANDLE))
+        {
+            filterStateCommand(StateCommandType::BindDescriptorSet, true);
+            continue;
+        }
 
-        std::vector<VkWriteDescriptorSet> vkWrites;
-        vkWrites.reserve(bindGroup.size());
+        PooledDescriptorSetAllocator* pooledSetAllocator = static_cast<PooledDescriptorSetAllocator*>(setAllocator);
 
-        static thread_local std::vector<VkDescriptorImageInfo> sTmpImageInfos;
-        static thread_local std::vector<VkDescriptorBufferInfo> sTmpBufferInfos;
-        sTmpImageInfos.clear();
-        sTmpImageInfos.resize(numDescriptors);
-        sTmpBufferInfos.clear();
-        sTmpBufferInfos.resize(numDescriptors);
-        size_t currentDescriptorInfoIndex = 0;
+        static thread_local DescriptorSetBindingKey sTmpBindingKey;
+        sTmpBindingKey._entries.clear();
 
-        for (const ShaderVariableBinding& resourceBinding : bindGroup)
+        for (const ShaderSlotBinding& resourceBinding : bindGroup)
         {
-            const std::string& resourceBindingName = resourceBinding._variableName;
+            const ShaderBindingSlot& bindingSlot = resourceBinding._slot;
+            ResourceView* bindingResourceView = resourceBinding._view;
 
-            auto shaderVariableIter = shaderVariableMap.find(resourceBindingName);
-            if (shaderVariableIter == shaderVariableMap.end())
+            // Input attachment is transited by subpass dependency of the current render pass
+            const bool isInputAttachment = bindingSlot._descriptorCategory == DescriptorCategory::InputAttachment;
+            if (_isSecondary)
             {
-                VOX_ASSERT(false,
-                           "Given shader variable name ({}) does not exist in "
-                           "the current pipeline.",
-                           resourceBindingName);
-                continue;
+                // Layout transition is invalid inside render pass instance, and views are shared by chunks translated in parallel.
+                // So the view must have been transited by the primary command buffer, e.g. by barrier planned by frame graph.
+                VOX_ASSERT(isInputAttachment || (_resourceBarrierManager.isTransitionRequired(bindingResourceView, resourceBinding._usage) == false),
+                           "View({}) bound in secondary CommandBuffer({}) must be transited before the render pass begins",
+                           bindingResourceView->getViewId(), _debugName);
             }
-
-            const DescriptorInfo& descriptorInfo = shaderVariableIter->second;
-
-            ResourceView* bindingResourceView = resourceBinding._view;
-
-            const VkPipelineStageFlags stageFlags =
-                evaluatePipelineStageFlags(bindingResourceView, resourceBinding._usage, pipelineLayoutDesc._sets[setIndex]._stageFlags);
-            addMemoryBarrier(bindingResourceView, resourceBinding._usage, stageFlags);
-
-            const VkDescriptorImageInfo* imageInfo = nullptr;
-            const VkDescriptorBufferInfo* bufferInfo = nullptr;
-
-            uint32_t binding = descriptorInfo._binding;
-            uint32_t arraySize = descriptorInfo._arraySize;
-            VkDescriptorType vkDescriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
-            switch (descriptorInfo._descriptorCategory)
+            else if (isInputAttachment == false)
             {
-                case DescriptorCategory::CombinedImage:
-                    vkDescriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                    break;
-                case DescriptorCategory::UniformBuffer:
-                    vkDescriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-                    break;
-                case DescriptorCategory::StorageBuffer:
-                    vkDescriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-                    break;
-                default:
-                    VOX_ASSERT(false, "Unknown descriptor category must not be exist");
-                    break;
+                const VkPipelineStageFlags stageFlags =
+                    evaluatePipelineStageFlags(bindingResourceView, resourceBinding._usage, pipelineLayoutDesc._sets[setIndex]._stageFlags);
+                addMemoryBarrier(bindingResourceView, resourceBinding._usage, stageFlags);
             }
 
-            switch (bindingResourceView->getResourceViewType())
+            DescriptorBindingEntry bindingEntry{ ._binding = bindingSlot._binding, ._viewId = bindingResourceView->getViewId(), ._usage = resourceBinding._usage };
+            if (bindingResourceView->getResourceViewType() == ResourceViewType::ImageView)
             {
-                case ResourceViewType::BufferView:
-                    sTmpBufferInfos[currentDescriptorInfoIndex] = static_cast<BufferView*>(bindingResourceView)->getDescriptorBufferInfo();
-                    bufferInfo = &sTmpBufferInfos[currentDescriptorInfoIndex++];
-                    break;
-                case ResourceViewType::ImageView:
-                    sTmpImageInfos[currentDescriptorInfoIndex] = static_cast<TextureView*>(bindingResourceView)->getDescriptorImageInfo();
-
-                    sTmpImageInfos[currentDescriptorInfoIndex].imageLayout = static_cast<TextureView*>(bindingResourceView)->getCurrentVkImageLayout();
-
-                    if (descriptorInfo._descriptorCategory == DescriptorCategory::CombinedImage)
-                    {
-                        sTmpImageInfos[currentDescriptorInfoIndex].sampler = _sampler->get();
-                    }
-
-                    imageInfo = &sTmpImageInfos[currentDescriptorInfoIndex++];
-                    break;
-                case ResourceViewType::StagingBufferView:
-                default:
-                    VOX_ASSERT(false, "Unhandled resource view type");
-                    break;
+                bindingEntry._vkImageLayout =
+                    isInputAttachment ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : static_cast<TextureView*>(bindingResourceView)->getCurrentVkImageLayout();
+                if (bindingSlot._descriptorCategory == DescriptorCategory::CombinedImage)
+                {
+                    bindingEntry._vkSampler = _sampler->get();
+                }
             }
 
-            vkWrites.push_back(VkWriteDescriptorSet{ .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                                                     .pNext = nullptr,
-                                                     .dstSet = pooledDescriptorSet,
-                                                     .dstBinding = static_cast<uint32_t>(binding),
-                                                     .dstArrayElement = 0,
-                                                     .descriptorCount = arraySize,
-                                                     .descriptorType = vkDescriptorType,
-                                                     .pImageInfo = imageInfo,
-                                                     .pBufferInfo = bufferInfo,
-                                                     .pTexelBufferView = nullptr });
+            sTmpBindingKey._entries.push_back(bindingEntry);
         }
 
         // Note(snowapril) : As vulkan validation layer require that resource
@@ -439,15 +607,110 @@ void CommandBuffer::commitPendingResourceBindings()
         // before issuing draw/dispatch), commit barrier first.
         _resourceBarrierManager.commitPendingBarriers(_isInRenderPassScope);
 
-        vkUpdateDescriptorSets(_logicalDevice->get(), static_cast<uint32_t>(vkWrites.size()), vkWrites.data(), 0, nullptr);
+        // Descriptor set written with the same bindings is bound again without any descriptor write
+        VkDescriptorSet pooledDescriptorSet = pooledSetAllocator->getCachedDescriptorSet(sTmpBindingKey, _fenceToSignal);
+        if (pooledDescriptorSet != VK_NULL_HANDLE)
+        {
+            ++_stateCommandStats._numDescriptorSetCacheHits;
+        }
+        else
+        {
+            pooledDescriptorSet = pooledSetAllocator->getOrCreatePooledDescriptorSet(_fenceToSignal);
+            writeDescriptorSet(pooledDescriptorSet, sTmpBindingKey, bindGroup);
+            pooledSetAllocator->cacheDescriptorSet(sTmpBindingKey, pooledDescriptorSet);
+            ++_stateCommandStats._numDescriptorSetWrites;
+        }
 
-        vkCmdBindDescriptorSets(_vkCommandBuffer, _boundPipeline->getBindPoint(), pipelineLayout->get(), static_cast<uint32_t>(setSlotCategory), 1,
-                                &pooledDescriptorSet, 0, nullptr);
+        if (filterStateCommand(StateCommandType::BindDescriptorSet, _shadowState._descriptorSets[setIndex] == pooledDescriptorSet))
+        {
+            vkCmdBindDescriptorSets(_vkCommandBuffer, _boundPipeline->getBindPoint(), pipelineLayout->get(), static_cast<uint32_t>(setSlotCategory), 1,
+                                    &pooledDescriptorSet, 0, nullptr);
+            _shadowState._descriptorSets[setIndex] = pooledDescriptorSet;
+        }
 
         bindGroup.clear();
     }
 }
 
+void CommandBuffer::writeDescriptorSet(VkDescriptorSet vkDescriptorSet, const DescriptorSetBindingKey& bindingKey, const std::vector<ShaderSlotBinding>& bindGroup)
+{
+    const size_t numBindings = bindGroup.size();
+
+    std::vector<VkWriteDescriptorSet> vkWrites;
+    vkWrites.reserve(numBindings);
+
+    static thread_local std::vector<VkDescriptorImageInfo> sTmpImageInfos;
+    static thread_local std::vector<VkDescriptorBufferInfo> sTmpBufferInfos;
+    sTmpImageInfos.clear();
+    sTmpImageInfos.resize(numBindings);
+    sTmpBufferInfos.clear();
+    sTmpBufferInfos.resize(numBindings);
+
+    for (size_t bindingIndex = 0; bindingIndex < numBindings; ++bindingIndex)
+    {
+        const ShaderBindingSlot& bindingSlot = bindGroup[bindingIndex]._slot;
+        ResourceView* bindingResourceView = bindGroup[bindingIndex]._view;
+        const DescriptorBindingEntry& bindingEntry = bindingKey._entries[bindingIndex];
+
+        const VkDescriptorImageInfo* imageInfo = nullptr;
+        const VkDescriptorBufferInfo* bufferInfo = nullptr;
+
+        VkDescriptorType vkDescriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        switch (bindingSlot._descriptorCategory)
+        {
+            case DescriptorCategory::CombinedImage:
+                vkDescriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                break;
+            case DescriptorCategory::UniformBuffer:
+                vkDescriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                break;
+            case DescriptorCategory::StorageBuffer:
+                vkDescriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                break;
+            case DescriptorCategory::InputAttachment:
+                vkDescriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                break;
+            default:
+                VOX_ASSERT(false, "Unknown descriptor category must not be exist");
+                break;
+        }
+
+        switch (bindingResourceView->getResourceViewType())
+        {
+            case ResourceViewType::BufferView:
+                sTmpBufferInfos[bindingIndex] = static_cast<BufferView*>(bindingResourceView)->getDescriptorBufferInfo();
+                bufferInfo = &sTmpBufferInfos[bindingIndex];
+                break;
+            case ResourceViewType::ImageView:
+                sTmpImageInfos[bindingIndex] = static_cast<TextureView*>(bindingResourceView)->getDescriptorImageInfo();
+                sTmpImageInfos[bindingIndex].imageLayout = bindingEntry._vkImageLayout;
+                if (bindingEntry._vkSampler != VK_NULL_HANDLE)
+                {
+                    sTmpImageInfos[bindingIndex].sampler = bindingEntry._vkSampler;
+                }
+                imageInfo = &sTmpImageInfos[bindingIndex];
+                break;
+            case ResourceViewType::StagingBufferView:
+            default:
+                VOX_ASSERT(false, "Unhandled resource view type");
+                break;
+        }
+
+        vkWrites.push_back(VkWriteDescriptorSet{ .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                                 .pNext = nullptr,
+                                                 .dstSet = vkDescriptorSet,
+                                                 .dstBinding = bindingSlot._binding,
+                                                 .dstArrayElement = 0,
+                                                 .descriptorCount = bindingSlot._arraySize,
+                                                 .descriptorType = vkDescriptorType,
+                                                 .pImageInfo = imageInfo,
+                                                 .pBufferInfo = bufferInfo,
+                                                 .pTexelBufferView = nullptr });
+    }
+
+    vkUpdateDescriptorSets(_logicalDevice->get(), static_cast<uint32_t>(vkWrites.size()), vkWrites.data(), 0, nullptr);
+}
+
 void CommandBuffer::uploadBuffer(Buffer* dstBuffer, StagingBuffer* srcBuffer, const uint32_t dstOffset, const uint32_t srcOffset, const uint32_t size)
 {
     const VkBufferCopy bufferCopy = { .srcOffset = srcOffset, .dstOffset = dstOffset, .size = size };
@@ -514,4 +777,75 @@ void CommandBuffer::addExecutionBarrier(VkPipelineStageFlags prevStageFlags, VkP
     _resourceBarrierManager.addExecutionBarrier(prevStageFlags, nextStageFlags);
 }
 
+void CommandBuffer::releaseQueueOwnership(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex)
+{
+    addQueueOwnershipTransfer(view, srcQueueFamilyIndex, dstQueueFamilyIndex, true);
+    _resourceBarrierManager.commitPendingBarriers(_isInRenderPassScope);
+}
+
+void CommandBuffer::addPlannedMemoryBarrier(ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    const ResourceViewType viewType = view->getResourceViewType();
+    switch (viewType)
+    {
+        case ResourceViewType::BufferView:
+            _resourceBarrierManager.addPlannedBufferMemoryBarrier(static_cast<BufferView*>(view), accessMask, nextStageFlags);
+            break;
+        case ResourceViewType::ImageView:
+            _resourceBarrierManager.addPlannedTextureMemoryBarrier(static_cast<TextureView*>(view), accessMask, nextStageFlags);
+            break;
+        default:
+            VOX_ASSERT(false, "Planned barrier is not supported for view type({})", static_cast<uint32_t>(viewType));
+            break;
+    }
+}
+
+void CommandBuffer::addAliasingBarrier(ResourceView* view)
+{
+    const ResourceViewType viewType = view->getResourceViewType();
+    VOX_ASSERT(viewType == ResourceViewType::ImageView, "Aliasing barrier is not supported for view type({})", static_cast<uint32_t>(viewType));
+
+    _resourceBarrierManager.addTextureAliasingBarrier(static_cast<TextureView*>(view));
+    _resourceBarrierManager.commitPendingBarriers(_isInRenderPassScope);
+}
+
+void CommandBuffer::signalSplitBarrier(SplitBarrier* splitBarrier, ResourceView* view, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    _resourceBarrierManager.signalSplitBarrier(splitBarrier, view, accessMask, nextStageFlags);
+}
+
+void CommandBuffer::waitSplitBarrier(SplitBarrier* splitBarrier)
+{
+    _resourceBarrierManager.waitSplitBarrier(splitBarrier);
+}
+
+void CommandBuffer::commitPendingBarriers()
+{
+    _resourceBarrierManager.commitPendingBarriers(_isInRenderPassScope);
+}
+
+void CommandBuffer::acquireQueueOwnership(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex)
+{
+    addQueueOwnershipTransfer(view, srcQueueFamilyIndex, dstQueueFamilyIndex, false);
+    _resourceBarrierManager.commitPendingBarriers(_isInRenderPassScope);
+}
+
+void CommandBuffer::addQueueOwnershipTransfer(ResourceView* view, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                              const bool isRelease)
+{
+    const ResourceViewType viewType = view->getResourceViewType();
+    switch (viewType)
+    {
+        case ResourceViewType::BufferView:
+            _resourceBarrierManager.addBufferOwnershipTransfer(static_cast<BufferView*>(view), srcQueueFamilyIndex, dstQueueFamilyIndex, isRelease);
+            break;
+        case ResourceViewType::ImageView:
+            _resourceBarrierManager.addTextureOwnershipTransfer(static_cast<TextureView*>(view), srcQueueFamilyIndex, dstQueueFamilyIndex, isRelease);
+            break;
+        default:
+            VOX_ASSERT(false, "Queue ownership transfer is not supported for view type({})", static_cast<uint32_t>(viewType));
+            break;
+    }
+}
+
 }  // namespace VoxFlow
\ No newline at end of file
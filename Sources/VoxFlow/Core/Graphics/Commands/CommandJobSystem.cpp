@@ -1,93 +1,462 @@
 // Author : snowapril
 
+#include <VoxFlow/Core/Devices/LogicalDevice.hpp>
 #include <VoxFlow/Core/Devices/Queue.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandBuffer.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandPool.hpp>
+#include <VoxFlow/Core/Graphics/RenderPass/RenderTargetGroup.hpp>
+#include <VoxFlow/Core/Utils/ChromeTracer.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <taskflow/taskflow.hpp>
 
 namespace VoxFlow
 {
+namespace
+{
+template <typename PacketType>
+inline const PacketType& getPacket(const void* payload)
+{
+    return *static_cast<const PacketType*>(payload);
+}
+}  // namespace
+
+void SecondaryCommandGroup::reset(const uint32_t numChunks)
+{
+    // Packet buffers of chunks are never shrunk, so that their memory blocks are reused by the next group
+    while (_chunkPacketBuffers.size() < numChunks)
+    {
+        _chunkPacketBuffers.emplace_back(std::make_unique<CommandPacketBuffer>());
+    }
+
+    for (std::unique_ptr<CommandPacketBuffer>& packetBuffer : _chunkPacketBuffers)
+    {
+        packetBuffer->reset();
+    }
+
+    _secondaryCmdBuffers.clear();
+    _numChunks = numChunks;
+}
+
 CommandStream::CommandStream(LogicalDevice* logicalDevice, Queue* queue) : _logicalDevice(logicalDevice), _queue(queue)
 {
 }
 
 CommandStream::~CommandStream()
 {
+    for (std::unique_ptr<SplitBarrier>& splitBarrier : _splitBarriers)
+    {
+        vkDestroyEvent(_logicalDevice->get(), splitBarrier->_vkEvent, nullptr);
+    }
 }
 
 FenceObject CommandStream::flush(SwapChain* swapChain, const FrameContext* frameContext, const bool waitAllCompletion)
+{
+    return submitPendingCommandBuffers(swapChain, frameContext, swapChain != nullptr, waitAllCompletion);
+}
+
+FenceObject CommandStream::flushBeforePresent(SwapChain* swapChain, const FrameContext* frameContext)
+{
+    return submitPendingCommandBuffers(swapChain, frameContext, false, false);
+}
+
+FenceObject CommandStream::submitPendingCommandBuffers(SwapChain* swapChain, const FrameContext* frameContext, const bool signalPresentReady,
+                                                       const bool waitAllCompletion)
 {
     std::vector<std::shared_ptr<CommandBuffer>> cmdBufs;
+    std::vector<FenceObject> fencesToWait;
+    bool waitBackBufferReady = false;
     {
-        std::lock_guard<std::recursive_mutex> scopedLock(_streamMutex);
-        for (auto& [_, cmdBufPtr] : _cmdBufferStorage)
+        std::lock_guard<std::mutex> scopedLock(_streamMutex);
+        translatePendingPackets();
+
+        if (_sealedCmdBuffers.empty())
         {
-            cmdBufPtr->endCommandBuffer();
-            cmdBufs.emplace_back(std::move(cmdBufPtr));
+            // Keep waits for the next submission which will have command buffers
+            return FenceObject::Default();
         }
-        _cmdBufferStorage.clear();
-    }
 
-    if (cmdBufs.empty())
-    {
-        return FenceObject::Default();
+        cmdBufs.swap(_sealedCmdBuffers);
+        fencesToWait.swap(_pendingWaitFences);
+
+        waitBackBufferReady = (swapChain != nullptr) && (_isBackBufferReadyWaited == false);
+        _isBackBufferReadyWaited |= waitBackBufferReady;
     }
 
     // TODO(snowapril) : sort command buffer according and set dependency
-    FenceObject fenceToSignal = _queue->submitCommandBufferBatch(std::move(cmdBufs), swapChain, frameContext, waitAllCompletion);
+    FenceObject fenceToSignal = _queue->submitCommandBufferBatch(std::move(cmdBufs), swapChain, frameContext, waitBackBufferReady, signalPresentReady,
+                                                                 waitAllCompletion, fencesToWait);
 
     return fenceToSignal;
 }
 
-CommandBuffer* CommandStream::getOrAllocateCommandBuffer()
+void CommandStream::sealCommandBuffers()
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    translatePendingPackets();
+}
+
+void CommandStream::beginFrame()
 {
-    const auto threadId = std::this_thread::get_id();
+    SCOPED_CHROME_TRACING("CommandStream::beginFrame");
+
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+
+    VOX_ASSERT(_sealedCmdBuffers.empty(), "Sealed command buffers must be flushed before the next frame begins");
+
+    _isBackBufferReadyWaited = false;
+
+    _stats += _frameStats;
+    _lastFrameStats = _frameStats;
+    _frameStats = CommandStreamStats();
 
-    CommandBuffer* cmdBuffer = nullptr;
+    _currentFrameIndex = (_currentFrameIndex + 1) % FRAME_BUFFER_COUNT;
+    FrameCommandPools& frameCmdPools = _frameCmdPools[_currentFrameIndex];
+
+    // Usually completed already as the swap chain throttles frames in flight
+    if (frameCmdPools._lastFenceValue > 0)
     {
-        std::lock_guard<std::recursive_mutex> scopedLock(_streamMutex);
+        _queue->waitFenceValue(frameCmdPools._lastFenceValue);
+        frameCmdPools._lastFenceValue = 0;
+    }
 
-        auto cmdIter = _cmdBufferStorage.find(threadId);
-        if (cmdIter == _cmdBufferStorage.end())
+    for (std::unique_ptr<CommandPool>& cmdPool : frameCmdPools._cmdPoolSlots)
+    {
+        if (cmdPool != nullptr)
         {
-            CommandPool* cmdPool = getOrAllocateCommandPool();
-            std::shared_ptr<CommandBuffer> cmdBufferPtr = cmdPool->getOrCreateCommandBuffer();
-            // TODO(snowapril) : add thread_id to command buffer begin name
-            cmdBufferPtr->beginCommandBuffer(_queue->allocateFenceToSignal(), fmt::format("CommandStream"));
-
-            cmdBuffer = cmdBufferPtr.get();
-            _cmdBufferStorage.emplace(threadId, std::move(cmdBufferPtr));
+            cmdPool->reset();
         }
-        else
+    }
+}
+
+void CommandStream::addWaitFence(const FenceObject& fenceToWait)
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    _pendingWaitFences.push_back(fenceToWait);
+}
+
+void CommandStream::prepareSplitBarriers(const uint32_t numSplitBarriers)
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+
+    // Events are reset right after waited, so they can be reused across frames
+    // as long as the frames are submitted to this queue in order.
+    while (_splitBarriers.size() < numSplitBarriers)
+    {
+        std::unique_ptr<SplitBarrier> splitBarrier = std::make_unique<SplitBarrier>();
+
+        const VkEventCreateInfo eventCreateInfo = { .sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO, .pNext = nullptr, .flags = 0 };
+        VK_ASSERT(vkCreateEvent(_logicalDevice->get(), &eventCreateInfo, nullptr, &splitBarrier->_vkEvent));
+
+        _splitBarriers.emplace_back(std::move(splitBarrier));
+    }
+}
+
+SecondaryCommandGroup* CommandStream::acquireSecondaryCommandGroup(const uint32_t numChunks)
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+
+    SecondaryCommandGroup* secondaryCmdGroup = nullptr;
+    if (_freeSecondaryCmdGroups.empty())
+    {
+        _secondaryCmdGroups.emplace_back(std::make_unique<SecondaryCommandGroup>());
+        secondaryCmdGroup = _secondaryCmdGroups.back().get();
+    }
+    else
+    {
+        secondaryCmdGroup = _freeSecondaryCmdGroups.back();
+        _freeSecondaryCmdGroups.pop_back();
+    }
+
+    secondaryCmdGroup->reset(numChunks);
+    return secondaryCmdGroup;
+}
+
+void CommandStream::setTranslationExecutor(tf::Executor* translationExecutor)
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    _translationExecutor = translationExecutor;
+}
+
+CommandStreamStats CommandStream::getStats() const
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    CommandStreamStats stats = _stats;
+    stats += _frameStats;
+    return stats;
+}
+
+CommandStreamStats CommandStream::getLastFrameStats() const
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    return _lastFrameStats;
+}
+
+void CommandStream::resetStats()
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+    _stats = CommandStreamStats();
+    _frameStats = CommandStreamStats();
+    _lastFrameStats = CommandStreamStats();
+}
+
+CommandPacketBuffer* CommandStream::registerPacketBuffer(const uint32_t workerIndex)
+{
+    std::lock_guard<std::mutex> scopedLock(_streamMutex);
+
+    // Slot is only written by the worker itself, but translation iterates packet buffers under the lock
+    _packetBuffers.emplace_back(std::make_unique<CommandPacketBuffer>());
+    CommandPacketBuffer* packetBuffer = _packetBuffers.back().get();
+    _packetBufferSlots[workerIndex].store(packetBuffer, std::memory_order_release);
+
+    return packetBuffer;
+}
+
+void CommandStream::translatePendingPackets()
+{
+    SCOPED_CHROME_TRACING("CommandStream::translatePendingPackets");
+
+    const auto translationBegin = std::chrono::steady_clock::now();
+
+    // Packets of each recording thread are translated into its own command buffer as they
+    // were recorded without ordering against the other threads.
+    for (std::unique_ptr<CommandPacketBuffer>& packetBufferPtr : _packetBuffers)
+    {
+        CommandPacketBuffer* packetBuffer = packetBufferPtr.get();
+        if (packetBuffer->empty())
         {
-            cmdBuffer = cmdIter->second.get();
+            continue;
         }
+
+        CommandPool* cmdPool = getOrAllocateCommandPool();
+        const uint32_t numAllocatedCmdBuffers = cmdPool->getNumAllocatedCommandBuffers();
+
+        std::shared_ptr<CommandBuffer> cmdBufferPtr = cmdPool->getOrCreateCommandBuffer();
+        // Secondary command buffers allocated while translating are counted separately
+        _frameStats._numAllocatedCommandBuffers += cmdPool->getNumAllocatedCommandBuffers() - numAllocatedCmdBuffers;
+        // TODO(snowapril) : add thread_id to command buffer begin name
+        cmdBufferPtr->beginCommandBuffer(_queue->allocateFenceToSignal(), fmt::format("CommandStream"));
+        _frameCmdPools[_currentFrameIndex]._lastFenceValue = cmdBufferPtr->getFenceToSignal().getFenceValue();
+        translatePackets(*packetBuffer, cmdBufferPtr.get());
+        cmdBufferPtr->endCommandBuffer();
+        _frameStats._stateCommandStats += cmdBufferPtr->getStateCommandStats();
+
+        _frameStats._numTranslatedPackets += packetBuffer->getNumPackets();
+        _frameStats._numTranslatedBytes += packetBuffer->getNumBytes();
+        ++_frameStats._numTranslatedCommandBuffers;
+
+        packetBuffer->reset();
+        _sealedCmdBuffers.emplace_back(std::move(cmdBufferPtr));
     }
 
-    return cmdBuffer;
+    _frameStats._translationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - translationBegin);
 }
 
-CommandPool* CommandStream::getOrAllocateCommandPool()
+void CommandStream::translatePackets(const CommandPacketBuffer& packetBuffer, CommandBuffer* cmdBuffer)
 {
-    const auto threadId = std::this_thread::get_id();
+    packetBuffer.forEachPacket([this, cmdBuffer](CommandJobType jobType, const void* payload) {
+        switch (jobType)
+        {
+            case CommandJobType::BeginRenderPass:
+            {
+                const auto& packet = getPacket<BeginRenderPassPacket>(payload);
+                cmdBuffer->beginRenderPass(*packet._attachmentGroup, *packet._passParams);
+                break;
+            }
+            case CommandJobType::EndRenderPass:
+                cmdBuffer->endRenderPass();
+                break;
+
+            case CommandJobType::BindPipeline:
+                cmdBuffer->bindPipeline(getPacket<BindPipelinePacket>(payload)._pipeline);
+                break;
+
+            case CommandJobType::SetViewport:
+                cmdBuffer->setViewport(getPacket<SetViewportPacket>(payload)._viewportSize);
+                break;
+
+            case CommandJobType::BindResourceGroup:
+            {
+                const auto& packet = getPacket<BindResourceGroupPacket>(payload);
+                cmdBuffer->bindResourceGroup(packet._setSlotCategory, packet.unpackBindGroup());
+                break;
+            }
+            case CommandJobType::BindResourceSlots:
+            {
+                const auto& packet = getPacket<BindResourceSlotsPacket>(payload);
+                cmdBuffer->bindResourceSlots(packet.getBindings());
+                break;
+            }
+            case CommandJobType::PushConstants:
+            {
+                const auto& packet = getPacket<PushConstantsPacket>(payload);
+                cmdBuffer->pushConstants(packet._offset, packet._size, packet.getData());
+                break;
+            }
+            case CommandJobType::UploadBuffer:
+            {
+                const auto& packet = getPacket<UploadPacket>(payload);
+                cmdBuffer->uploadBuffer(packet._dstBuffer, packet._srcBuffer, packet._dstOffset, packet._srcOffset, packet._size);
+                break;
+            }
+            case CommandJobType::UploadTexture:
+            {
+                const auto& packet = getPacket<UploadPacket>(payload);
+                cmdBuffer->uploadTexture(packet._dstTexture, packet._srcBuffer, packet._dstOffset, packet._srcOffset, packet._size);
+                break;
+            }
+            case CommandJobType::Draw:
+            {
+                const auto& packet = getPacket<DrawPacket>(payload);
+                cmdBuffer->draw(packet._vertexCount, packet._instanceCount, packet._firstVertex, packet._firstInstance);
+                break;
+            }
+            case CommandJobType::DrawIndexed:
+            {
+                const auto& packet = getPacket<DrawIndexedPacket>(payload);
+                cmdBuffer->drawIndexed(packet._indexCount, packet._instanceCount, packet._firstIndex, packet._vertexOffset, packet._firstInstance);
+                break;
+            }
+            case CommandJobType::MakeSwapChainFinalLayout:
+            {
+                const auto& packet = getPacket<MakeSwapChainFinalLayoutPacket>(payload);
+                cmdBuffer->makeSwapChainFinalLayout(packet._swapChain, packet._backBufferIndex);
+                break;
+            }
+            case CommandJobType::BindVertexBuffer:
+                cmdBuffer->bindVertexBuffer(getPacket<BindBufferPacket>(payload)._buffer);
+                break;
+
+            case CommandJobType::BindIndexBuffer:
+                cmdBuffer->bindIndexBuffer(getPacket<BindBufferPacket>(payload)._buffer);
+                break;
+
+            case CommandJobType::ReleaseQueueOwnership:
+            {
+                const auto& packet = getPacket<QueueOwnershipPacket>(payload);
+                cmdBuffer->releaseQueueOwnership(packet._view, packet._srcQueueFamilyIndex, packet._dstQueueFamilyIndex);
+                break;
+            }
+            case CommandJobType::AcquireQueueOwnership:
+            {
+                const auto& packet = getPacket<QueueOwnershipPacket>(payload);
+                cmdBuffer->acquireQueueOwnership(packet._view, packet._srcQueueFamilyIndex, packet._dstQueueFamilyIndex);
+                break;
+            }
+            case CommandJobType::AddPlannedBarrier:
+            {
+                const auto& packet = getPacket<PlannedBarrierPacket>(payload);
+                cmdBuffer->addPlannedMemoryBarrier(packet._view, packet._accessMask, packet._nextStages);
+                break;
+            }
+            case CommandJobType::AddAliasingBarrier:
+                cmdBuffer->addAliasingBarrier(getPacket<AliasingBarrierPacket>(payload)._view);
+                break;
+
+            case CommandJobType::SignalSplitBarrier:
+            {
+                const auto& packet = getPacket<SignalSplitBarrierPacket>(payload);
+                cmdBuffer->signalSplitBarrier(packet._splitBarrier, packet._view, packet._accessMask, packet._nextStages);
+                break;
+            }
+            case CommandJobType::WaitSplitBarrier:
+                cmdBuffer->waitSplitBarrier(getPacket<WaitSplitBarrierPacket>(payload)._splitBarrier);
+                break;
+
+            case CommandJobType::CommitPendingBarriers:
+                cmdBuffer->commitPendingBarriers();
+                break;
+
+            case CommandJobType::ExecuteSecondaryCommands:
+                translateSecondaryCommandGroup(getPacket<ExecuteSecondaryCommandsPacket>(payload)._secondaryCmdGroup, cmdBuffer);
+                break;
+        }
+    });
+}
 
-    CommandPool* cmdPool = nullptr;
+void CommandStream::translateSecondaryCommandGroup(SecondaryCommandGroup* secondaryCmdGroup, CommandBuffer* primaryCmdBuffer)
+{
+    SCOPED_CHROME_TRACING("CommandStream::translateSecondaryCommandGroup");
+
+    const uint32_t numChunks = secondaryCmdGroup->getNumChunks();
+    secondaryCmdGroup->_secondaryCmdBuffers.resize(numChunks);
+    std::atomic<uint32_t> numAllocatedCmdBuffers{ 0 };
+
+    // Each chunk is translated with the command pool of the translating thread
+    const auto translateChunk = [this, secondaryCmdGroup, primaryCmdBuffer, &numAllocatedCmdBuffers](const uint32_t chunkIndex) {
+        const CommandPacketBuffer* packetBuffer = secondaryCmdGroup->_chunkPacketBuffers[chunkIndex].get();
+        if (packetBuffer->empty())
+        {
+            return;
+        }
+
+        CommandPool* cmdPool = getOrAllocateCommandPool();
+        const uint32_t numPrevAllocatedCmdBuffers = cmdPool->getNumAllocatedCommandBuffers();
+
+        std::shared_ptr<CommandBuffer> cmdBufferPtr = cmdPool->getOrCreateSecondaryCommandBuffer();
+        cmdBufferPtr->beginSecondaryCommandBuffer(*primaryCmdBuffer, fmt::format("SecondaryCommandStream_{}", chunkIndex));
+        translatePackets(*packetBuffer, cmdBufferPtr.get());
+        cmdBufferPtr->endCommandBuffer();
+
+        numAllocatedCmdBuffers.fetch_add(cmdPool->getNumAllocatedCommandBuffers() - numPrevAllocatedCmdBuffers, std::memory_order_relaxed);
+        secondaryCmdGroup->_secondaryCmdBuffers[chunkIndex] = std::move(cmdBufferPtr);
+    };
+
+    // Waiting on the executor from one of its own workers may block every worker, so it is translated in place
+    const bool canTranslateInParallel = (_translationExecutor != nullptr) && (_translationExecutor->this_worker_id() < 0) && (numChunks > 1);
+    if (canTranslateInParallel)
     {
-        std::lock_guard<std::recursive_mutex> scopedLock(_streamMutex);
-        auto cmdPoolIter = _cmdPoolStorage.find(threadId);
-        if (cmdPoolIter == _cmdPoolStorage.end())
+        tf::Taskflow taskflow;
+        for (uint32_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
         {
-            auto cmdPoolPtr = std::make_unique<CommandPool>(_logicalDevice, _queue);
-            cmdPool = cmdPoolPtr.get();
-            _cmdPoolStorage.emplace(threadId, std::move(cmdPoolPtr));
+            taskflow.emplace([&translateChunk, chunkIndex]() { translateChunk(chunkIndex); });
         }
-        else
+        _translationExecutor->run(taskflow).wait();
+    }
+    else
+    {
+        for (uint32_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
         {
-            cmdPool = cmdPoolIter->second.get();
+            translateChunk(chunkIndex);
         }
     }
 
-    return cmdPool;
+    primaryCmdBuffer->executeSecondaryCommandBuffers(secondaryCmdGroup->_secondaryCmdBuffers);
+
+    for (uint32_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+    {
+        const CommandPacketBuffer* packetBuffer = secondaryCmdGroup->_chunkPacketBuffers[chunkIndex].get();
+        _frameStats._numTranslatedPackets += packetBuffer->getNumPackets();
+        _frameStats._numTranslatedBytes += packetBuffer->getNumBytes();
+        if (packetBuffer->empty() == false)
+        {
+            ++_frameStats._numTranslatedCommandBuffers;
+            _frameStats._stateCommandStats += secondaryCmdGroup->_secondaryCmdBuffers[chunkIndex]->getStateCommandStats();
+        }
+    }
+    _frameStats._numAllocatedCommandBuffers += numAllocatedCmdBuffers.load(std::memory_order_relaxed);
+
+    // Secondary command buffers are kept alive by their pools until the frame in flight completes
+    secondaryCmdGroup->reset(0);
+    _freeSecondaryCmdGroups.push_back(secondaryCmdGroup);
+}
+
+CommandPool* CommandStream::getOrAllocateCommandPool()
+{
+    // Command pool is owned by the translating thread, not by the recording one. Slot is only accessed by
+    // the thread of its worker index, so workers translating secondary command buffers never share one.
+    std::unique_ptr<CommandPool>& cmdPoolPtr = _frameCmdPools[_currentFrameIndex]._cmdPoolSlots[Thread::GetWorkerIndex()];
+    if (cmdPoolPtr == nullptr)
+    {
+        cmdPoolPtr = std::make_unique<CommandPool>(_logicalDevice, _queue);
+    }
+    else if (cmdPoolPtr->getOwnerThreadId() != std::this_thread::get_id())
+    {
+        // Worker index is reused only after its previous thread exits, so the pool is never shared
+        cmdPoolPtr->transferOwnership();
+    }
+
+    return cmdPoolPtr.get();
 }
 
 CommandJobSystem::CommandJobSystem(LogicalDevice* logicalDevice) : _logicalDevice(logicalDevice)
@@ -113,4 +482,12 @@ CommandStream* CommandJobSystem::getCommandStream(const CommandStreamKey& stream
     return cmdStream;
 }
 
+void CommandJobSystem::beginFrame()
+{
+    for (auto& [_, cmdStream] : _cmdStreams)
+    {
+        cmdStream->beginFrame();
+    }
+}
+
 }  // namespace VoxFlow
@@ -0,0 +1,108 @@
+// Author : snowapril
+
+#include <VoxFlow/Core/Graphics/Commands/CommandPacket.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/ResourceBindingLayout.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <cstring>
+#include <type_traits>
+
+namespace VoxFlow
+{
+void BindResourceGroupPacket::record(CommandPacketBuffer* packetBuffer, SetSlotCategory setSlotCategory,
+                                     const std::vector<ShaderVariableBinding>& bindGroup)
+{
+    const uint32_t numBindings = static_cast<uint32_t>(bindGroup.size());
+    uint32_t payloadSize = static_cast<uint32_t>(sizeof(BindResourceGroupPacket) + sizeof(Binding) * numBindings);
+    for (const ShaderVariableBinding& binding : bindGroup)
+    {
+        payloadSize += static_cast<uint32_t>(binding._variableName.size());
+    }
+
+    std::byte* payload = static_cast<std::byte*>(packetBuffer->allocatePacket(CommandJobType::BindResourceGroup, payloadSize));
+    new (payload) BindResourceGroupPacket{ ._setSlotCategory = setSlotCategory, ._numBindings = numBindings };
+
+    Binding* bindings = reinterpret_cast<Binding*>(payload + sizeof(BindResourceGroupPacket));
+    char* variableNames = reinterpret_cast<char*>(bindings + numBindings);
+    for (uint32_t i = 0; i < numBindings; ++i)
+    {
+        const ShaderVariableBinding& binding = bindGroup[i];
+        const uint32_t variableNameLength = static_cast<uint32_t>(binding._variableName.size());
+        new (bindings + i) Binding{ ._view = binding._view, ._usage = binding._usage, ._variableNameLength = variableNameLength };
+
+        std::memcpy(variableNames, binding._variableName.data(), variableNameLength);
+        variableNames += variableNameLength;
+    }
+}
+
+std::vector<ShaderVariableBinding> BindResourceGroupPacket::unpackBindGroup() const
+{
+    const Binding* bindings = reinterpret_cast<const Binding*>(reinterpret_cast<const std::byte*>(this) + sizeof(BindResourceGroupPacket));
+    const char* variableNames = reinterpret_cast<const char*>(bindings + _numBindings);
+
+    std::vector<ShaderVariableBinding> bindGroup;
+    bindGroup.reserve(_numBindings);
+    for (uint32_t i = 0; i < _numBindings; ++i)
+    {
+        const Binding& binding = bindings[i];
+        bindGroup.push_back(ShaderVariableBinding{ ._variableName = std::string(variableNames, binding._variableNameLength),
+                                                   ._view = binding._view,
+                                                   ._usage = binding._usage });
+        variableNames += binding._variableNameLength;
+    }
+    return bindGroup;
+}
+
+void BindResourceSlotsPacket::record(CommandPacketBuffer* packetBuffer, std::span<const ShaderSlotBinding> bindings)
+{
+    static_assert(std::is_trivially_copyable_v<ShaderSlotBinding>, "Slot bindings are copied into packet as they are");
+    static_assert(sizeof(BindResourceSlotsPacket) % alignof(ShaderSlotBinding) == 0, "Bindings following packet must be aligned");
+
+    const uint32_t numBindings = static_cast<uint32_t>(bindings.size());
+    const uint32_t payloadSize = static_cast<uint32_t>(sizeof(BindResourceSlotsPacket) + sizeof(ShaderSlotBinding) * numBindings);
+
+    std::byte* payload = static_cast<std::byte*>(packetBuffer->allocatePacket(CommandJobType::BindResourceSlots, payloadSize));
+    new (payload) BindResourceSlotsPacket{ ._numBindings = numBindings };
+    std::memcpy(payload + sizeof(BindResourceSlotsPacket), bindings.data(), sizeof(ShaderSlotBinding) * numBindings);
+}
+
+std::span<const ShaderSlotBinding> BindResourceSlotsPacket::getBindings() const
+{
+    const ShaderSlotBinding* bindings =
+        reinterpret_cast<const ShaderSlotBinding*>(reinterpret_cast<const std::byte*>(this) + sizeof(BindResourceSlotsPacket));
+    return std::span<const ShaderSlotBinding>(bindings, _numBindings);
+}
+
+void PushConstantsPacket::record(CommandPacketBuffer* packetBuffer, const uint32_t offset, const void* data, const uint32_t size)
+{
+    std::byte* payload = static_cast<std::byte*>(packetBuffer->allocatePacket(CommandJobType::PushConstants, sizeof(PushConstantsPacket) + size));
+    new (payload) PushConstantsPacket{ ._offset = offset, ._size = size };
+    std::memcpy(payload + sizeof(PushConstantsPacket), data, size);
+}
+
+void CommandPacketBuffer::reset()
+{
+    for (uint32_t blockIndex = 0; blockIndex < _blocks.size() && blockIndex <= _currentBlockIndex; ++blockIndex)
+    {
+        _blocks[blockIndex]._usedBytes = 0;
+    }
+    _currentBlockIndex = 0;
+    _numPackets = 0;
+    _numBytes = 0;
+}
+
+void CommandPacketBuffer::advanceBlock(const uint32_t packetSize)
+{
+    VOX_ASSERT(packetSize <= BLOCK_SIZE, "Command packet({} bytes) exceeds the block size({} bytes)", packetSize, BLOCK_SIZE);
+
+    if (_blocks.empty() == false)
+    {
+        ++_currentBlockIndex;
+    }
+
+    if (_currentBlockIndex == _blocks.size())
+    {
+        // Block memory is left uninitialized as packets are always written before read
+        _blocks.push_back(Block{ ._memory = std::unique_ptr<std::byte[]>(new std::byte[BLOCK_SIZE]), ._usedBytes = 0 });
+    }
+}
+}  // namespace VoxFlow
@@ -14,7 +14,8 @@ CommandPool::CommandPool(LogicalDevice* logicalDevice, Queue* ownerQueue)
     VkCommandPoolCreateInfo poolInfo{
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .pNext = nullptr,
-        .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        // Command buffers are re-recorded every frame and reset together with the pool
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
         .queueFamilyIndex = _ownerQueue->getFamilyIndex(),
     };
     VK_ASSERT(vkCreateCommandPool(_logicalDevice->get(), &poolInfo, nullptr, &_commandPool));
@@ -35,6 +36,9 @@ CommandPool::CommandPool(LogicalDevice* logicalDevice, Queue* ownerQueue)
 
 CommandPool ::~CommandPool()
 {
+    // Command buffers are freed together with the pool
+    _commandBuffers.clear();
+    _secondaryCommandBuffers.clear();
     if (_commandPool != VK_NULL_HANDLE)
         vkDestroyCommandPool(_logicalDevice->get(), _commandPool, nullptr);
 }
@@ -53,7 +57,10 @@ CommandPool& CommandPool::operator=(CommandPool&& other) noexcept
         _logicalDevice = other._logicalDevice;
         _ownerQueue = other._ownerQueue;
         _commandPool = other._commandPool;
-        _freedCommandBuffers.swap(other._freedCommandBuffers);
+        _commandBuffers.swap(other._commandBuffers);
+        _secondaryCommandBuffers.swap(other._secondaryCommandBuffers);
+        _numUsedCommandBuffers = other._numUsedCommandBuffers;
+        _numUsedSecondaryCommandBuffers = other._numUsedSecondaryCommandBuffers;
 
         other._commandPool = VK_NULL_HANDLE;
     }
@@ -63,37 +70,61 @@ CommandPool& CommandPool::operator=(CommandPool&& other) noexcept
 std::shared_ptr<CommandBuffer> CommandPool::getOrCreateCommandBuffer()
 {
     VOX_ASSERT(std::this_thread::get_id() == _creationThreadId, "");
-    std::shared_ptr<CommandBuffer> outCommandBuffer = nullptr;
-    if (_freedCommandBuffers.empty() == false)
+
+    if (_numUsedCommandBuffers < _commandBuffers.size())
     {
-        if (_freedCommandBuffers.top()->getFenceToSignal().isCompleted())
-        {
-            outCommandBuffer = _freedCommandBuffers.top();
-            _freedCommandBuffers.pop();
-        }
+        return _commandBuffers[_numUsedCommandBuffers++];
     }
 
-    if (outCommandBuffer == nullptr)
+    _commandBuffers.emplace_back(allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+    ++_numUsedCommandBuffers;
+
+    return _commandBuffers.back();
+}
+
+std::shared_ptr<CommandBuffer> CommandPool::getOrCreateSecondaryCommandBuffer()
+{
+    VOX_ASSERT(std::this_thread::get_id() == _creationThreadId, "");
+
+    if (_numUsedSecondaryCommandBuffers < _secondaryCommandBuffers.size())
     {
-        VkCommandBufferAllocateInfo allocInfo{
-            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-            .pNext = nullptr,
-            .commandPool = _commandPool,
-            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-            .commandBufferCount = 1,
-        };
-
-        VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
-        VK_ASSERT(vkAllocateCommandBuffers(_logicalDevice->get(), &allocInfo, &vkCommandBuffer));
-        outCommandBuffer = std::make_shared<CommandBuffer>(_logicalDevice, vkCommandBuffer);
+        return _secondaryCommandBuffers[_numUsedSecondaryCommandBuffers++];
     }
 
-    return outCommandBuffer;
+    _secondaryCommandBuffers.emplace_back(allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY));
+    ++_numUsedSecondaryCommandBuffers;
+
+    return _secondaryCommandBuffers.back();
 }
 
-void CommandPool::releaseCommandBuffer(std::shared_ptr<CommandBuffer>&& commandBuffer)
+std::shared_ptr<CommandBuffer> CommandPool::allocateCommandBuffer(VkCommandBufferLevel level)
 {
-    VOX_ASSERT(std::this_thread::get_id() == _creationThreadId, "");
-    _freedCommandBuffers.push(std::move(commandBuffer));
+    VkCommandBufferAllocateInfo allocInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .commandPool = _commandPool,
+        .level = level,
+        .commandBufferCount = 1,
+    };
+
+    VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
+    VK_ASSERT(vkAllocateCommandBuffers(_logicalDevice->get(), &allocInfo, &vkCommandBuffer));
+
+    return std::make_shared<CommandBuffer>(_logicalDevice, vkCommandBuffer);
+}
+
+void CommandPool::reset()
+{
+    if ((_numUsedCommandBuffers > 0) || (_numUsedSecondaryCommandBuffers > 0))
+    {
+        VK_ASSERT(vkResetCommandPool(_logicalDevice->get(), _commandPool, 0));
+        _numUsedCommandBuffers = 0;
+        _numUsedSecondaryCommandBuffers = 0;
+    }
+}
+
+void CommandPool::transferOwnership()
+{
+    _creationThreadId = std::this_thread::get_id();
 }
 }  // namespace VoxFlow
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <VoxFlow/Core/Resources/Buffer.hpp>
 #include <VoxFlow/Core/Resources/StagingBuffer.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
+#include <mutex>
 
 namespace VoxFlow
 {
@@ -73,7 +74,8 @@ void ResourceBarrierManager::addGlobalMemoryBarrier(ResourceAccessMask prevAcces
     _globalMemoryBarrier._dstAccessFlags = estimateAccessFlags(nextAccessMasks);
 }
 
-void ResourceBarrierManager::addTextureMemoryBarrier(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+// Make barrier transiting the given texture from its last access to the next one, and update its access state
+static VkImageMemoryBarrier transitTextureAccessState(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
 {
     Texture* texture = static_cast<Texture*>(textureView->getOwnerResource());
     // TODO(snowapril) : get dstQueueFamilyIndex from command buffer
@@ -81,14 +83,12 @@ void ResourceBarrierManager::addTextureMemoryBarrier(TextureView* textureView, R
     const TextureViewInfo& textureViewInfo = textureView->getViewInfo();
     const VkImageLayout nextImageLayout = estimateImageLayout(accessMask);
 
-    _memoryBarrierGroup._srcStageFlags |= textureView->getLastusedShaderStageFlags();
-    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
-    _memoryBarrierGroup._imageBarriers.push_back(VkImageMemoryBarrier{
+    const VkImageMemoryBarrier imageBarrier = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         .pNext = nullptr,
         .srcAccessMask = estimateAccessFlags(textureView->getLastAccessMask()),
         .dstAccessMask = estimateAccessFlags(accessMask),
-        .oldLayout = estimateImageLayout(textureView->getLastAccessMask()),
+        .oldLayout = textureView->getCurrentVkImageLayout(),
         .newLayout = nextImageLayout,
         .srcQueueFamilyIndex = texture->getCurrentQueueFamilyIndex(),
         .dstQueueFamilyIndex = texture->getCurrentQueueFamilyIndex(),
@@ -98,23 +98,24 @@ void ResourceBarrierManager::addTextureMemoryBarrier(TextureView* textureView, R
                                                      .levelCount = textureViewInfo._levelCount,
                                                      .baseArrayLayer = textureViewInfo._baseMipLevel,
                                                      .layerCount = textureViewInfo._layerCount },
-    });
+    };
 
     textureView->setLastusedShaderStageFlags(nextStageFlags);
     textureView->setLastAccessMask(accessMask);
     textureView->setCurrentVkImageLayout(nextImageLayout);
+
+    return imageBarrier;
 }
 
-void ResourceBarrierManager::addBufferMemoryBarrier(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+// Make barrier transiting the given buffer region from its last access to the next one, and update its access state
+static VkBufferMemoryBarrier transitBufferAccessState(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
 {
     Buffer* buffer = static_cast<Buffer*>(bufferView->getOwnerResource());
     // TODO(snowapril) : get dstQueueFamilyIndex from command buffer
 
     const BufferViewInfo& bufferViewInfo = bufferView->getViewInfo();
 
-    _memoryBarrierGroup._srcStageFlags |= bufferView->getLastusedShaderStageFlags();
-    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
-    _memoryBarrierGroup._bufferBarriers.push_back(VkBufferMemoryBarrier{
+    const VkBufferMemoryBarrier bufferBarrier = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
         .pNext = nullptr,
         .srcAccessMask = estimateAccessFlags(bufferView->getLastAccessMask()),
@@ -124,15 +125,113 @@ void ResourceBarrierManager::addBufferMemoryBarrier(BufferView* bufferView, Reso
         .buffer = buffer->get(),
         .offset = bufferViewInfo._offset,
         .size = bufferViewInfo._range,
-    });
+    };
 
     bufferView->setLastusedShaderStageFlags(nextStageFlags);
     bufferView->setLastAccessMask(accessMask);
+
+    return bufferBarrier;
+}
+
+void ResourceBarrierManager::addTextureMemoryBarrier(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    std::lock_guard<std::mutex> scopedLock(textureView->getAccessStateLock());
+
+    if (textureView->consumePlannedAccess(accessMask))
+    {
+        return;
+    }
+
+    _memoryBarrierGroup._srcStageFlags |= textureView->getLastusedShaderStageFlags();
+    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
+    _memoryBarrierGroup._imageBarriers.push_back(transitTextureAccessState(textureView, accessMask, nextStageFlags));
+}
+
+void ResourceBarrierManager::addPlannedTextureMemoryBarrier(TextureView* textureView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    std::lock_guard<std::mutex> scopedLock(textureView->getAccessStateLock());
+
+    const VkPipelineStageFlags lastStageFlags = textureView->getLastusedShaderStageFlags();
+    _memoryBarrierGroup._srcStageFlags |= (lastStageFlags != VK_PIPELINE_STAGE_NONE) ? lastStageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
+    _memoryBarrierGroup._imageBarriers.push_back(transitTextureAccessState(textureView, accessMask, nextStageFlags));
+
+    textureView->setPlannedAccessMask(accessMask);
+}
+
+void ResourceBarrierManager::addTextureAliasingBarrier(TextureView* textureView)
+{
+    std::lock_guard<std::mutex> scopedLock(textureView->getAccessStateLock());
+
+    addGlobalMemoryBarrier(ResourceAccessMask::General, ResourceAccessMask::General);
+    addExecutionBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+    // Following barrier is chained to this one by its source stage
+    textureView->setLastAccessMask(ResourceAccessMask::Undefined);
+    textureView->setLastusedShaderStageFlags(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    textureView->setCurrentVkImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+    textureView->setPlannedAccessMask(ResourceAccessMask::Undefined);
+}
+
+void ResourceBarrierManager::signalSplitBarrier(SplitBarrier* splitBarrier, ResourceView* view, ResourceAccessMask accessMask,
+                                                VkPipelineStageFlags nextStageFlags)
+{
+    std::lock_guard<std::mutex> scopedLock(view->getAccessStateLock());
+
+    const VkPipelineStageFlags lastStageFlags = view->getLastusedShaderStageFlags();
+    splitBarrier->_srcStageFlags = (lastStageFlags != VK_PIPELINE_STAGE_NONE) ? lastStageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    splitBarrier->_dstStageFlags = nextStageFlags;
+    splitBarrier->_isBufferBarrier = (view->getResourceViewType() == ResourceViewType::BufferView);
+    if (splitBarrier->_isBufferBarrier)
+    {
+        splitBarrier->_bufferBarrier = transitBufferAccessState(static_cast<BufferView*>(view), accessMask, nextStageFlags);
+    }
+    else
+    {
+        splitBarrier->_imageBarrier = transitTextureAccessState(static_cast<TextureView*>(view), accessMask, nextStageFlags);
+    }
+
+    view->setPlannedAccessMask(accessMask);
+
+    vkCmdSetEvent(_commandBuffer->get(), splitBarrier->_vkEvent, splitBarrier->_srcStageFlags);
+}
+
+void ResourceBarrierManager::waitSplitBarrier(SplitBarrier* splitBarrier)
+{
+    _pendingSplitBarriers.push_back(splitBarrier);
+}
+
+void ResourceBarrierManager::addBufferMemoryBarrier(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    std::lock_guard<std::mutex> scopedLock(bufferView->getAccessStateLock());
+
+    if (bufferView->consumePlannedAccess(accessMask))
+    {
+        return;
+    }
+
+    _memoryBarrierGroup._srcStageFlags |= bufferView->getLastusedShaderStageFlags();
+    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
+    _memoryBarrierGroup._bufferBarriers.push_back(transitBufferAccessState(bufferView, accessMask, nextStageFlags));
+}
+
+void ResourceBarrierManager::addPlannedBufferMemoryBarrier(BufferView* bufferView, ResourceAccessMask accessMask, VkPipelineStageFlags nextStageFlags)
+{
+    std::lock_guard<std::mutex> scopedLock(bufferView->getAccessStateLock());
+
+    const VkPipelineStageFlags lastStageFlags = bufferView->getLastusedShaderStageFlags();
+    _memoryBarrierGroup._srcStageFlags |= (lastStageFlags != VK_PIPELINE_STAGE_NONE) ? lastStageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    _memoryBarrierGroup._dstStageFlags |= nextStageFlags;
+    _memoryBarrierGroup._bufferBarriers.push_back(transitBufferAccessState(bufferView, accessMask, nextStageFlags));
+
+    bufferView->setPlannedAccessMask(accessMask);
 }
 
 void ResourceBarrierManager::addStagingBufferMemoryBarrier(StagingBufferView* stagingBufferView, ResourceAccessMask accessMask,
                                                            VkPipelineStageFlags nextStageFlags)
 {
+    std::lock_guard<std::mutex> scopedLock(stagingBufferView->getAccessStateLock());
+
     StagingBuffer* stagingBuffer = static_cast<StagingBuffer*>(stagingBufferView->getOwnerResource());
     // TODO(snowapril) : get dstQueueFamilyIndex from command buffer
 
@@ -156,12 +255,110 @@ void ResourceBarrierManager::addStagingBufferMemoryBarrier(StagingBufferView* st
     stagingBufferView->setLastAccessMask(accessMask);
 }
 
+void ResourceBarrierManager::addTextureOwnershipTransfer(TextureView* textureView, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                                         const bool isRelease)
+{
+    std::lock_guard<std::mutex> scopedLock(textureView->getAccessStateLock());
+
+    Texture* texture = static_cast<Texture*>(textureView->getOwnerResource());
+
+    const TextureViewInfo& textureViewInfo = textureView->getViewInfo();
+    const VkImageLayout currentImageLayout = textureView->getCurrentVkImageLayout();
+
+    // Release half makes the last accesses available, and acquire half is followed by
+    // the usual barrier of the consumer on the destination queue.
+    if (isRelease)
+    {
+        const VkPipelineStageFlags lastStageFlags = textureView->getLastusedShaderStageFlags();
+        _memoryBarrierGroup._srcStageFlags |= (lastStageFlags != VK_PIPELINE_STAGE_NONE) ? lastStageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        _memoryBarrierGroup._dstStageFlags |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    }
+    else
+    {
+        _memoryBarrierGroup._srcStageFlags |= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        _memoryBarrierGroup._dstStageFlags |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    _memoryBarrierGroup._imageBarriers.push_back(VkImageMemoryBarrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = isRelease ? estimateAccessFlags(textureView->getLastAccessMask()) : VK_ACCESS_NONE,
+        .dstAccessMask = VK_ACCESS_NONE,
+        .oldLayout = currentImageLayout,
+        .newLayout = currentImageLayout,
+        .srcQueueFamilyIndex = srcQueueFamilyIndex,
+        .dstQueueFamilyIndex = dstQueueFamilyIndex,
+        .image = texture->get(),
+        .subresourceRange = VkImageSubresourceRange{ .aspectMask = textureViewInfo._aspectFlags,
+                                                     .baseMipLevel = textureViewInfo._baseMipLevel,
+                                                     .levelCount = textureViewInfo._levelCount,
+                                                     .baseArrayLayer = textureViewInfo._baseMipLevel,
+                                                     .layerCount = textureViewInfo._layerCount },
+    });
+}
+
+void ResourceBarrierManager::addBufferOwnershipTransfer(BufferView* bufferView, const uint32_t srcQueueFamilyIndex, const uint32_t dstQueueFamilyIndex,
+                                                        const bool isRelease)
+{
+    std::lock_guard<std::mutex> scopedLock(bufferView->getAccessStateLock());
+
+    Buffer* buffer = static_cast<Buffer*>(bufferView->getOwnerResource());
+
+    const BufferViewInfo& bufferViewInfo = bufferView->getViewInfo();
+
+    if (isRelease)
+    {
+        const VkPipelineStageFlags lastStageFlags = bufferView->getLastusedShaderStageFlags();
+        _memoryBarrierGroup._srcStageFlags |= (lastStageFlags != VK_PIPELINE_STAGE_NONE) ? lastStageFlags : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        _memoryBarrierGroup._dstStageFlags |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    }
+    else
+    {
+        _memoryBarrierGroup._srcStageFlags |= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        _memoryBarrierGroup._dstStageFlags |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    _memoryBarrierGroup._bufferBarriers.push_back(VkBufferMemoryBarrier{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = isRelease ? estimateAccessFlags(bufferView->getLastAccessMask()) : VK_ACCESS_NONE,
+        .dstAccessMask = VK_ACCESS_NONE,
+        .srcQueueFamilyIndex = srcQueueFamilyIndex,
+        .dstQueueFamilyIndex = dstQueueFamilyIndex,
+        .buffer = buffer->get(),
+        .offset = bufferViewInfo._offset,
+        .size = bufferViewInfo._range,
+    });
+}
+
 void ResourceBarrierManager::addExecutionBarrier(VkPipelineStageFlags prevStageFlags, VkPipelineStageFlags nextStageFlags)
 {
     _executionBarrier._srcStageFlags = prevStageFlags;
     _executionBarrier._dstStageFlags = nextStageFlags;
 }
 
+bool ResourceBarrierManager::isTransitionRequired(ResourceView* view, ResourceAccessMask accessMask) const
+{
+    std::lock_guard<std::mutex> scopedLock(view->getAccessStateLock());
+
+    if ((view->getResourceViewType() == ResourceViewType::ImageView) &&
+        (static_cast<TextureView*>(view)->getCurrentVkImageLayout() != estimateImageLayout(accessMask)))
+    {
+        return true;
+    }
+
+    if (view->hasPlannedAccess(accessMask))
+    {
+        return false;
+    }
+
+    const ResourceAccessMask writableAccessMasks = ResourceAccessMask::TransferDest | ResourceAccessMask::ColorAttachment |
+                                                   ResourceAccessMask::DepthAttachment | ResourceAccessMask::StencilAttachment |
+                                                   ResourceAccessMask::General | ResourceAccessMask::StorageBuffer | ResourceAccessMask::Present;
+    const bool isReadOnlyAccess = static_cast<uint32_t>(accessMask & writableAccessMasks) == 0;
+    return (isReadOnlyAccess == false) || (view->getLastAccessMask() != accessMask);
+}
+
 void ResourceBarrierManager::commitPendingBarriers(const bool inRenderPassScope)
 {
     const VkDependencyFlags dependencyFlag = inRenderPassScope ? VK_DEPENDENCY_BY_REGION_BIT : 0;
@@ -188,6 +385,42 @@ void ResourceBarrierManager::commitPendingBarriers(const bool inRenderPassScope)
 
         _memoryBarrierGroup.reset();
     }
+
+    if (_pendingSplitBarriers.empty() == false)
+    {
+        std::vector<VkEvent> vkEvents;
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        VkPipelineStageFlags srcStageFlags = VK_PIPELINE_STAGE_NONE;
+        VkPipelineStageFlags dstStageFlags = VK_PIPELINE_STAGE_NONE;
+
+        for (const SplitBarrier* splitBarrier : _pendingSplitBarriers)
+        {
+            vkEvents.push_back(splitBarrier->_vkEvent);
+            if (splitBarrier->_isBufferBarrier)
+            {
+                bufferBarriers.push_back(splitBarrier->_bufferBarrier);
+            }
+            else
+            {
+                imageBarriers.push_back(splitBarrier->_imageBarrier);
+            }
+            srcStageFlags |= splitBarrier->_srcStageFlags;
+            dstStageFlags |= splitBarrier->_dstStageFlags;
+        }
+
+        vkCmdWaitEvents(vkCommandBuffer, static_cast<uint32_t>(vkEvents.size()), vkEvents.data(), srcStageFlags, dstStageFlags, 0, nullptr,
+                        static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(), static_cast<uint32_t>(imageBarriers.size()),
+                        imageBarriers.data());
+
+        // Events are reused by the next frame, so unsignal them once waited
+        for (const SplitBarrier* splitBarrier : _pendingSplitBarriers)
+        {
+            vkCmdResetEvent(vkCommandBuffer, splitBarrier->_vkEvent, splitBarrier->_dstStageFlags);
+        }
+
+        _pendingSplitBarriers.clear();
+    }
 }
 
 }  // namespace VoxFlow
\ No newline at end of file
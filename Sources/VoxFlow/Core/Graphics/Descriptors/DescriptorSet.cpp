@@ -31,4 +31,19 @@ std::size_t std::hash<VoxFlow::DescriptorSetLayoutDesc>::operator()(VoxFlow::Des
 
     VoxFlow::hash_combine(seed, static_cast<uint32_t>(setLayout._stageFlags));
     return seed;
-}
\ No newline at end of file
+}
+std::size_t std::hash<VoxFlow::DescriptorSetBindingKey>::operator()(VoxFlow::DescriptorSetBindingKey const& bindingKey) const noexcept
+{
+    uint32_t seed = 0;
+
+    for (const VoxFlow::DescriptorBindingEntry& entry : bindingKey._entries)
+    {
+        VoxFlow::hash_combine(seed, entry._binding);
+        VoxFlow::hash_combine(seed, entry._viewId);
+        VoxFlow::hash_combine(seed, static_cast<uint32_t>(entry._usage));
+        VoxFlow::hash_combine(seed, static_cast<uint32_t>(entry._vkImageLayout));
+        VoxFlow::hash_combine(seed, entry._vkSampler);
+    }
+
+    return seed;
+}
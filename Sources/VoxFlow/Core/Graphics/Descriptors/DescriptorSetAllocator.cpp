@@ -3,6 +3,9 @@
 #include <VoxFlow/Core/Devices/LogicalDevice.hpp>
 #include <VoxFlow/Core/Graphics/Descriptors/DescriptorSetAllocator.hpp>
 #include <VoxFlow/Core/Utils/RendererCommon.hpp>
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -60,6 +63,9 @@ bool DescriptorSetAllocator::initialize(const DescriptorSetLayoutDesc& setLayout
             case DescriptorCategory::StorageBuffer:
                 descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
                 break;
+            case DescriptorCategory::InputAttachment:
+                descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                break;
             case DescriptorCategory::Undefined:
                 VOX_ASSERT(false, "Unknown descriptor type must not be given");
                 continue;
@@ -157,31 +163,113 @@ PooledDescriptorSetAllocator& PooledDescriptorSetAllocator::operator=(PooledDesc
 
 VkDescriptorSet PooledDescriptorSetAllocator::getOrCreatePooledDescriptorSet(const FenceObject& fenceObject)
 {
-    VkDescriptorSet vkPooledDescriptorSet = VK_NULL_HANDLE;
-    for (DescriptorSetNode& node : _descriptorSetNodes)
+    // Passes in the same dependency level bind resource groups on multiple threads at once
+    std::lock_guard<std::mutex> scopedLock(_pooledSetLock);
+
+    const uint32_t nodeIndex = acquireCompletedNode(fenceObject);
+    return _descriptorSetNodes[nodeIndex]._vkDescriptorSet;
+}
+
+VkDescriptorSet PooledDescriptorSetAllocator::getCachedDescriptorSet(const DescriptorSetBindingKey& bindingKey, const FenceObject& fenceObject)
+{
+    std::lock_guard<std::mutex> scopedLock(_pooledSetLock);
+
+    auto cachedIter = _cachedNodeIndices.find(bindingKey);
+    if (cachedIter == _cachedNodeIndices.end())
     {
-        if (node._lastAccessedFenceObject.isCompleted())
+        return VK_NULL_HANDLE;
+    }
+
+    DescriptorSetNode& node = _descriptorSetNodes[cachedIter->second];
+    FenceObject& lastAccessedFence = node._lastAccessedFenceObject;
+
+    // As only a single fence is tracked per set, set in flight on the other queue is not shared.
+    // It is written again into another set which replaces this one in the cache.
+    if (lastAccessedFence.getQueue() != fenceObject.getQueue())
+    {
+        if (lastAccessedFence.isCompleted() == false)
         {
-            node._lastAccessedFenceObject = fenceObject;
-            vkPooledDescriptorSet = node._vkDescriptorSet;
+            return VK_NULL_HANDLE;
         }
+        lastAccessedFence = fenceObject;
+    }
+    else if (lastAccessedFence.getFenceValue() < fenceObject.getFenceValue())
+    {
+        lastAccessedFence = fenceObject;
+    }
+
+    return node._vkDescriptorSet;
+}
+
+void PooledDescriptorSetAllocator::cacheDescriptorSet(const DescriptorSetBindingKey& bindingKey, VkDescriptorSet vkDescriptorSet)
+{
+    std::lock_guard<std::mutex> scopedLock(_pooledSetLock);
+
+    auto nodeIter = std::find_if(_descriptorSetNodes.begin(), _descriptorSetNodes.end(),
+                                 [vkDescriptorSet](const DescriptorSetNode& node) { return node._vkDescriptorSet == vkDescriptorSet; });
+    if (nodeIter == _descriptorSetNodes.end())
+    {
+        VOX_ASSERT(false, "Given descriptor set is not allocated from this allocator");
+        return;
     }
 
-    if (vkPooledDescriptorSet == VK_NULL_HANDLE)
+    const uint32_t nodeIndex = static_cast<uint32_t>(std::distance(_descriptorSetNodes.begin(), nodeIter));
+    auto [cachedIter, isInserted] = _cachedNodeIndices.try_emplace(bindingKey, nodeIndex);
+    if (isInserted == false)
     {
-        VkDescriptorSetAllocateInfo allocInfo = {
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-            .pNext = 0,
-            .descriptorPool = _vkDescPool,
-            .descriptorSetCount = 1,
-            .pSetLayouts = &_vkSetLayout,
-        };
-        VK_ASSERT(vkAllocateDescriptorSets(_logicalDevice->get(), &allocInfo, &vkPooledDescriptorSet));
-
-        _descriptorSetNodes.push_back({ ._vkDescriptorSet = vkPooledDescriptorSet, ._lastAccessedFenceObject = fenceObject });
+        // Same bindings might be written by the other thread in the meantime
+        _descriptorSetNodes[cachedIter->second]._cachedBindingKey = nullptr;
+        cachedIter->second = nodeIndex;
     }
 
-    return vkPooledDescriptorSet;
+    nodeIter->_cachedBindingKey = &cachedIter->first;
+}
+
+uint32_t PooledDescriptorSetAllocator::acquireCompletedNode(const FenceObject& fenceObject)
+{
+    // Prefer sets not cached for any bindings so that the ones likely to be bound again survive
+    std::optional<uint32_t> completedNodeIndex;
+    const uint32_t numNodes = static_cast<uint32_t>(_descriptorSetNodes.size());
+    for (uint32_t nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+    {
+        const DescriptorSetNode& node = _descriptorSetNodes[nodeIndex];
+        if (((node._cachedBindingKey != nullptr) && completedNodeIndex.has_value()) || (node._lastAccessedFenceObject.isCompleted() == false))
+        {
+            continue;
+        }
+
+        completedNodeIndex = nodeIndex;
+        if (node._cachedBindingKey == nullptr)
+        {
+            break;
+        }
+    }
+
+    if (completedNodeIndex.has_value())
+    {
+        DescriptorSetNode& node = _descriptorSetNodes[completedNodeIndex.value()];
+        if (node._cachedBindingKey != nullptr)
+        {
+            _cachedNodeIndices.erase(_cachedNodeIndices.find(*node._cachedBindingKey));
+            node._cachedBindingKey = nullptr;
+        }
+
+        node._lastAccessedFenceObject = fenceObject;
+        return completedNodeIndex.value();
+    }
+
+    VkDescriptorSet vkPooledDescriptorSet = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = 0,
+        .descriptorPool = _vkDescPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &_vkSetLayout,
+    };
+    VK_ASSERT(vkAllocateDescriptorSets(_logicalDevice->get(), &allocInfo, &vkPooledDescriptorSet));
+
+    _descriptorSetNodes.push_back({ ._vkDescriptorSet = vkPooledDescriptorSet, ._lastAccessedFenceObject = fenceObject });
+    return numNodes;
 }
 
 BindlessDescriptorSetAllocator::BindlessDescriptorSetAllocator(LogicalDevice* logicalDevice) : DescriptorSetAllocator(logicalDevice, true)
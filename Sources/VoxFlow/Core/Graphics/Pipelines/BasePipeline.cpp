@@ -20,6 +20,15 @@ BasePipeline::BasePipeline(PipelineStreamingContext* pipelineStreamingContext, s
     {
         _shaderModules.push_back(std::make_unique<ShaderModule>(_pipelineStreamingContext, shaderPath));
     }
+
+    // Variable declared by multiple shader modules is resolved into the first declaration as pipeline layout does
+    for (const std::unique_ptr<ShaderModule>& shaderModule : _shaderModules)
+    {
+        for (const auto& [descriptor, variableName] : shaderModule->getShaderReflectionDataGroup()->_descriptors)
+        {
+            _bindingSlots.emplace(variableName, descriptor);
+        }
+    }
 }
 
 BasePipeline::~BasePipeline()
@@ -39,12 +48,24 @@ BasePipeline& BasePipeline::operator=(BasePipeline&& other) noexcept
         _logicalDevice = other._logicalDevice;
         _pipelineLayout.swap(other._pipelineLayout);
         _shaderModules.swap(other._shaderModules);
+        _bindingSlots.swap(other._bindingSlots);
         _pipeline = other._pipeline;
         other._pipeline = VK_NULL_HANDLE;
     }
     return *this;
 }
 
+ShaderBindingSlot BasePipeline::findBindingSlot(const std::string& variableName) const
+{
+    auto slotIter = _bindingSlots.find(variableName);
+    if (slotIter == _bindingSlots.end())
+    {
+        VOX_ASSERT(false, "Given shader variable name ({}) does not exist in the pipeline", variableName);
+        return ShaderBindingSlot();
+    }
+    return slotIter->second;
+}
+
 void BasePipeline::setPipelineCache(std::unique_ptr<PipelineCache>&& pipelineCache)
 {
     _pipelineCache = std::move(pipelineCache);
@@ -35,7 +35,7 @@ GraphicsPipeline& GraphicsPipeline::operator=(GraphicsPipeline&& other) noexcept
     return *this;
 }
 
-bool GraphicsPipeline::initialize(RenderPass* renderPass)
+bool GraphicsPipeline::initialize(RenderPass* renderPass, const uint32_t subpassIndex)
 {
     _pipelineLayout = std::make_unique<PipelineLayout>(_logicalDevice);
 
@@ -251,7 +251,7 @@ bool GraphicsPipeline::initialize(RenderPass* renderPass)
                                                         .pDynamicState = &dynamicInfo,
                                                         .layout = _pipelineLayout->get(),
                                                         .renderPass = renderPass->get(),
-                                                        .subpass = 0,
+                                                        .subpass = subpassIndex,
                                                         .basePipelineHandle = VK_NULL_HANDLE,
                                                         .basePipelineIndex = -1 };
 
@@ -73,6 +73,24 @@ static void organizeCombinedDescSetLayouts(const std::vector<const ShaderReflect
 
             combinedPipelineLayoutDesc->_sets[set]._stageFlags |= reflectionDataGroup->_stageFlagBit;
         }
+
+        // Ranges of every stage are merged into one, which is pushed with all of the stages at once
+        const PushConstantRange& stageRange = reflectionDataGroup->_pushConstantRange;
+        if (stageRange.isValid())
+        {
+            PushConstantRange& combinedRange = combinedPipelineLayoutDesc->_pushConstantRange;
+            if (combinedRange.isValid())
+            {
+                const uint32_t rangeEnd = std::max(combinedRange._offset + combinedRange._size, stageRange._offset + stageRange._size);
+                combinedRange._offset = std::min(combinedRange._offset, stageRange._offset);
+                combinedRange._size = rangeEnd - combinedRange._offset;
+                combinedRange._stageFlags |= stageRange._stageFlags;
+            }
+            else
+            {
+                combinedRange = stageRange;
+            }
+        }
     }
 }
 
@@ -97,15 +115,19 @@ bool PipelineLayout::initialize(const std::vector<const ShaderReflectionDataGrou
         }
     }
 
-    // TODO(snowapril) : implement push constants
+    const PushConstantRange& pushConstantRange = _combinedPipelineLayoutDesc._pushConstantRange;
+    const VkPushConstantRange vkPushConstantRange = { .stageFlags = pushConstantRange._stageFlags,
+                                                      .offset = pushConstantRange._offset,
+                                                      .size = pushConstantRange._size };
+
     VkPipelineLayoutCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
         .setLayoutCount = static_cast<uint32_t>(vkSetLayouts.size()),
         .pSetLayouts = vkSetLayouts.data(),
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr,
+        .pushConstantRangeCount = pushConstantRange.isValid() ? 1U : 0U,
+        .pPushConstantRanges = pushConstantRange.isValid() ? &vkPushConstantRange : nullptr,
     };
 
     VK_ASSERT(vkCreatePipelineLayout(_logicalDevice->get(), &createInfo, nullptr, &_vkPipelineLayout));
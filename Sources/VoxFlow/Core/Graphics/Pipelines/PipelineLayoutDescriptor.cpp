@@ -84,6 +84,7 @@ ShaderReflectionDataGroup& ShaderReflectionDataGroup::operator=(const ShaderRefl
         _descriptors = rhs._descriptors;
         _vertexInputLayouts = rhs._vertexInputLayouts;
         _fragmentOutputLayouts = rhs._fragmentOutputLayouts;
+        _pushConstantRange = rhs._pushConstantRange;
         _stageFlagBit = rhs._stageFlagBit;
     }
     return *this;
@@ -96,6 +97,7 @@ ShaderReflectionDataGroup& ShaderReflectionDataGroup::operator=(ShaderReflection
         _descriptors.swap(rhs._descriptors);
         _vertexInputLayouts.swap(rhs._vertexInputLayouts);
         _fragmentOutputLayouts.swap(rhs._fragmentOutputLayouts);
+        _pushConstantRange = rhs._pushConstantRange;
         _stageFlagBit = rhs._stageFlagBit;
     }
     return *this;
@@ -133,6 +135,8 @@ std::size_t std::hash<VoxFlow::PipelineLayoutDescriptor>::operator()(VoxFlow::Pi
         VoxFlow::hash_combine(seed, desc);
     }
 
-    VoxFlow::hash_combine(seed, shaderLayout._pushConstantSize);
+    VoxFlow::hash_combine(seed, shaderLayout._pushConstantRange._offset);
+    VoxFlow::hash_combine(seed, shaderLayout._pushConstantRange._size);
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(shaderLayout._pushConstantRange._stageFlags));
     return seed;
 }
\ No newline at end of file
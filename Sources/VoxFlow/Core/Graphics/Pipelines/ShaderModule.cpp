@@ -8,6 +8,7 @@
 #include <VoxFlow/Core/Utils/VertexFormat.hpp>
 #include <spirv-cross/spirv_common.hpp>
 #include <spirv-cross/spirv_cross.hpp>
+#include <algorithm>
 
 namespace VoxFlow
 {
@@ -271,6 +272,22 @@ bool ShaderModule::reflectShaderLayoutBindings(ShaderReflectionDataGroup* reflec
         }
     }
 
+    for (const spirv_cross::Resource& resource : shaderResources.subpass_inputs)
+    {
+        const uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+        const uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+        VOX_ASSERT(set < MAX_NUM_SET_SLOTS, "Set number must be under {}", MAX_NUM_SET_SLOTS);
+        VOX_ASSERT(set != static_cast<uint32_t>(SetSlotCategory::Bindless), "Input attachment can not be bound in bindless set");
+
+        // Input attachment index must match with the order of input attachments declared in render pass descriptor
+        const uint32_t inputAttachmentIndex = compiler.get_decoration(resource.id, spv::DecorationInputAttachmentIndex);
+
+        spdlog::debug("\t {} (set : {}, binding : {}, input attachment index : {})", resource.name, set, binding, inputAttachmentIndex);
+
+        reflectionDataGroup->_descriptors.emplace(DescriptorInfo{ static_cast<SetSlotCategory>(set), DescriptorCategory::InputAttachment, 1, binding },
+                                                  resource.name);
+    }
+
     for (const spirv_cross::Resource& resource : shaderResources.uniform_buffers)
     {
         const uint32_t set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
@@ -372,10 +389,22 @@ bool ShaderModule::reflectShaderLayoutBindings(ShaderReflectionDataGroup* reflec
                   [](const auto& lhs, const auto& rhs) { return lhs._location <= rhs._location; });
     }
 
-    if (!shaderResources.push_constant_buffers.empty())
+    // Only members statically accessed by this stage are included in the range
+    for (const spirv_cross::Resource& resource : shaderResources.push_constant_buffers)
     {
-        reflectionDataGroup->_pushConstantSize =
-            static_cast<uint32_t>(compiler.get_declared_struct_size(compiler.get_type(shaderResources.push_constant_buffers.front().base_type_id)));
+        uint32_t rangeBegin = UINT32_MAX;
+        uint32_t rangeEnd = 0;
+        for (const spirv_cross::BufferRange& bufferRange : compiler.get_active_buffer_ranges(resource.id))
+        {
+            rangeBegin = std::min(rangeBegin, static_cast<uint32_t>(bufferRange.offset));
+            rangeEnd = std::max(rangeEnd, static_cast<uint32_t>(bufferRange.offset + bufferRange.range));
+        }
+
+        if (rangeEnd > 0)
+        {
+            spdlog::debug("\t {} (push constant, offset : {}, size : {})", resource.name, rangeBegin, rangeEnd - rangeBegin);
+            reflectionDataGroup->_pushConstantRange = PushConstantRange{ ._offset = rangeBegin, ._size = rangeEnd - rangeBegin, ._stageFlags = shaderStageBits };
+        }
     }
 
     reflectionDataGroup->_stageFlagBit = shaderStageBits;
@@ -3,6 +3,7 @@
 #include <VoxFlow/Core/Devices/LogicalDevice.hpp>
 #include <VoxFlow/Core/Graphics/RenderPass/RenderPass.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
 
 namespace VoxFlow
 {
@@ -37,7 +38,6 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
     const uint32_t numColorAttachments = static_cast<uint32_t>(rtLayoutKey._colorFormats.size());
     const bool hasDepthStencilAttachment = rtLayoutKey._depthStencilFormat.has_value();
     std::vector<VkAttachmentDescription> attachmentDescs;
-    std::vector<VkAttachmentReference> colorAttachments;
     VkAttachmentReference depthAttachment;
 
     uint32_t attachmentIndex = 0;
@@ -60,9 +60,7 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
             .finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         };
         attachmentDescs.push_back(colorAttachmentDesc);
-
-        VkAttachmentReference colorRef{ .attachment = attachmentIndex++, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
-        colorAttachments.push_back(colorRef);
+        ++attachmentIndex;
     }
 
     if (hasDepthStencilAttachment)
@@ -84,7 +82,7 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
             .loadOp = clearDepth ? VK_ATTACHMENT_LOAD_OP_CLEAR : (loadDepth ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE),
             .storeOp = storeDepth ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .stencilLoadOp = clearStencil ? VK_ATTACHMENT_LOAD_OP_CLEAR : (loadStencil ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE),
-            .stencilStoreOp = storeStencil ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .stencilStoreOp = storeStencil ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
             .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
         };
@@ -93,19 +91,85 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
         depthAttachment = VkAttachmentReference{ .attachment = attachmentIndex++, .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
     }
 
-    VkSubpassDescription subPassDesc{ .flags = 0,
-                                      .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                      .inputAttachmentCount = 0,
-                                      .pInputAttachments = nullptr,
-                                      .colorAttachmentCount = numColorAttachments,
-                                      .pColorAttachments = colorAttachments.data(),
-                                      .pResolveAttachments = nullptr,
-                                      .pDepthStencilAttachment = hasDepthStencilAttachment ? &depthAttachment : nullptr,
-                                      .preserveAttachmentCount = 0,
-                                      .pPreserveAttachments = nullptr };
-
-    // TODO(snowapril) : support multi-pass architecture. for now, use only
-    // single pass and self-dependency
+    // Render pass without subpass layouts has a single subpass which outputs to all attachments
+    std::vector<SubpassLayout> subpassLayouts = rtLayoutKey._subpassLayouts;
+    if (subpassLayouts.empty())
+    {
+        SubpassLayout defaultLayout;
+        defaultLayout._outputAttachments = hasDepthStencilAttachment ? AttachmentMaskFlags::DepthStencil : AttachmentMaskFlags::None;
+        for (uint32_t i = 0; i < numColorAttachments; ++i)
+        {
+            defaultLayout._outputAttachments |= static_cast<AttachmentMaskFlags>(static_cast<uint32_t>(AttachmentMaskFlags::Color0) << i);
+        }
+        subpassLayouts.push_back(defaultLayout);
+    }
+    const uint32_t numSubpasses = static_cast<uint32_t>(subpassLayouts.size());
+
+    const auto isAttachmentUsed = [&](const SubpassLayout& subpassLayout, const uint32_t attachment) {
+        if (attachment < numColorAttachments)
+        {
+            return hasColorAspect(subpassLayout._outputAttachments, attachment) || subpassLayout.hasInputAttachment(attachment);
+        }
+        return hasDepthAspect(subpassLayout._outputAttachments);
+    };
+
+    // Attachment references must be alive until render pass creation
+    std::vector<std::vector<VkAttachmentReference>> colorReferences(numSubpasses);
+    std::vector<std::vector<VkAttachmentReference>> inputReferences(numSubpasses);
+    std::vector<std::vector<uint32_t>> preserveReferences(numSubpasses);
+    std::vector<VkSubpassDescription> subpassDescs;
+    subpassDescs.reserve(numSubpasses);
+
+    for (uint32_t subpass = 0; subpass < numSubpasses; ++subpass)
+    {
+        const SubpassLayout& subpassLayout = subpassLayouts[subpass];
+
+        for (uint32_t i = 0; i < numColorAttachments; ++i)
+        {
+            if (hasColorAspect(subpassLayout._outputAttachments, i))
+            {
+                colorReferences[subpass].push_back(VkAttachmentReference{ .attachment = i, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+            }
+        }
+
+        for (uint8_t i = 0; i < subpassLayout._numInputAttachments; ++i)
+        {
+            inputReferences[subpass].push_back(
+                VkAttachmentReference{ .attachment = subpassLayout._inputAttachmentSlots[i], .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+        }
+
+        // Contents of attachment used before and after this subpass must be preserved while this subpass
+        for (uint32_t attachment = 0; attachment < attachmentIndex; ++attachment)
+        {
+            if (isAttachmentUsed(subpassLayout, attachment))
+            {
+                continue;
+            }
+
+            const bool isUsedBefore = std::any_of(subpassLayouts.begin(), subpassLayouts.begin() + subpass,
+                                                  [&](const SubpassLayout& layout) { return isAttachmentUsed(layout, attachment); });
+            const bool isUsedAfter = std::any_of(subpassLayouts.begin() + subpass + 1, subpassLayouts.end(),
+                                                 [&](const SubpassLayout& layout) { return isAttachmentUsed(layout, attachment); });
+            if (isUsedBefore && isUsedAfter)
+            {
+                preserveReferences[subpass].push_back(attachment);
+            }
+        }
+
+        const bool useDepthStencil = hasDepthStencilAttachment && hasDepthAspect(subpassLayout._outputAttachments);
+
+        subpassDescs.push_back(VkSubpassDescription{ .flags = 0,
+                                                     .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                     .inputAttachmentCount = static_cast<uint32_t>(inputReferences[subpass].size()),
+                                                     .pInputAttachments = inputReferences[subpass].data(),
+                                                     .colorAttachmentCount = static_cast<uint32_t>(colorReferences[subpass].size()),
+                                                     .pColorAttachments = colorReferences[subpass].data(),
+                                                     .pResolveAttachments = nullptr,
+                                                     .pDepthStencilAttachment = useDepthStencil ? &depthAttachment : nullptr,
+                                                     .preserveAttachmentCount = static_cast<uint32_t>(preserveReferences[subpass].size()),
+                                                     .pPreserveAttachments = preserveReferences[subpass].data() });
+    }
+
     std::vector<VkSubpassDependency> dependencies = {
         /* VkSubpassDependency */ { .srcSubpass = VK_SUBPASS_EXTERNAL,
                                     .dstSubpass = 0,
@@ -116,13 +180,35 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
                                     .dependencyFlags = 0 },
     };
 
+    // Attachment read as input attachment is transited out of attachment layout by render pass, so
+    // reads in the fragment shader must wait for the color output prior to the render pass.
+    if (inputReferences[0].empty() == false)
+    {
+        dependencies[0].dstStageMask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dependencies[0].dstAccessMask |= VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+    }
+
+    // Each subpass reads outputs of the previous subpass at the same pixel only
+    for (uint32_t subpass = 1; subpass < numSubpasses; ++subpass)
+    {
+        dependencies.push_back(VkSubpassDependency{
+            .srcSubpass = subpass - 1,
+            .dstSubpass = subpass,
+            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT });
+    }
+
     const VkRenderPassCreateInfo renderPassInfo = { .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
                                                     .pNext = nullptr,
                                                     .flags = 0,
                                                     .attachmentCount = static_cast<uint32_t>(attachmentDescs.size()),
                                                     .pAttachments = attachmentDescs.data(),
-                                                    .subpassCount = 1,
-                                                    .pSubpasses = &subPassDesc,
+                                                    .subpassCount = numSubpasses,
+                                                    .pSubpasses = subpassDescs.data(),
                                                     .dependencyCount = static_cast<uint32_t>(dependencies.size()),
                                                     .pDependencies = dependencies.data() };
 
@@ -137,8 +223,8 @@ bool RenderPass::initialize(const RenderTargetLayoutKey& rtLayoutKey)
     }
 
 #if defined(VK_DEBUG_NAME_ENABLED)
-    const std::string renderPassDebugName =
-        fmt::format("{}_Color(#{})_Depth(#{})", _renderTargetLayout._debugName, numColorAttachments, hasDepthStencilAttachment ? 1U : 0U);
+    const std::string renderPassDebugName = fmt::format("{}_Color(#{})_Depth(#{})_Subpass(#{})", _renderTargetLayout._debugName, numColorAttachments,
+                                                        hasDepthStencilAttachment ? 1U : 0U, numSubpasses);
     DebugUtil::setObjectName(_logicalDevice, _renderPass, renderPassDebugName.c_str());
 #endif
 
@@ -33,6 +33,9 @@ RenderPassCollector& RenderPassCollector::operator=(RenderPassCollector&& other)
 
 RenderPass* RenderPassCollector::getOrCreateRenderPass(RenderTargetLayoutKey layoutKey)
 {
+    // Render passes can be recorded on multiple threads at once
+    std::lock_guard<std::mutex> scopedLock(_collectionLock);
+
     auto it = _renderPassCollection.find(layoutKey);
 
     if (it == _renderPassCollection.end())
@@ -54,6 +57,8 @@ RenderPass* RenderPassCollector::getOrCreateRenderPass(RenderTargetLayoutKey lay
 
 FrameBuffer* RenderPassCollector::getOrCreateFrameBuffer(RenderTargetsInfo rtInfo)
 {
+    std::lock_guard<std::mutex> scopedLock(_collectionLock);
+
     auto it = _frameBufferCollection.find(rtInfo);
 
     if (it == _frameBufferCollection.end())
@@ -75,6 +80,7 @@ FrameBuffer* RenderPassCollector::getOrCreateFrameBuffer(RenderTargetsInfo rtInf
 
 void RenderPassCollector::release()
 {
+    std::lock_guard<std::mutex> scopedLock(_collectionLock);
     _renderPassCollection.clear();
     _frameBufferCollection.clear();
 }
@@ -14,5 +14,17 @@ std::size_t std::hash<VoxFlow::RenderPassFlags>::operator()(VoxFlow::RenderPassF
     VoxFlow::hash_combine(seed, static_cast<uint32_t>(passFlags._loadFlags));
     VoxFlow::hash_combine(seed, static_cast<uint32_t>(passFlags._storeFlags));
 
+    return seed;
+}
+std::size_t std::hash<VoxFlow::SubpassLayout>::operator()(VoxFlow::SubpassLayout const& subpassLayout) const noexcept
+{
+    uint32_t seed = 0;
+
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(subpassLayout._outputAttachments));
+    for (uint8_t i = 0; i < subpassLayout._numInputAttachments; ++i)
+    {
+        VoxFlow::hash_combine(seed, subpassLayout._inputAttachmentSlots[i]);
+    }
+
     return seed;
 }
\ No newline at end of file
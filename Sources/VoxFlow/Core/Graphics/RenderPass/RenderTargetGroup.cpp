@@ -9,7 +9,8 @@ namespace VoxFlow
 bool RenderTargetLayoutKey::operator==(const RenderTargetLayoutKey& other) const
 {
     return std::equal(_colorFormats.begin(), _colorFormats.end(), other._colorFormats.begin(), other._colorFormats.end()) &&
-           (_depthStencilFormat == other._depthStencilFormat) && (_renderPassFlags == other._renderPassFlags) && (_debugName == other._debugName);
+           (_depthStencilFormat == other._depthStencilFormat) && (_renderPassFlags == other._renderPassFlags) && (_subpassLayouts == other._subpassLayouts) &&
+           (_debugName == other._debugName);
 }
 
 bool RenderTargetsInfo::operator==(const RenderTargetsInfo& other) const
@@ -48,6 +49,10 @@ std::size_t std::hash<VoxFlow::RenderTargetLayoutKey>::operator()(VoxFlow::Rende
     }
 
     VoxFlow::hash_combine(seed, layoutKey._renderPassFlags);
+    for (const VoxFlow::SubpassLayout& subpassLayout : layoutKey._subpassLayouts)
+    {
+        VoxFlow::hash_combine(seed, subpassLayout);
+    }
 
     return seed;
 }
@@ -8,6 +8,7 @@
 #include <VoxFlow/Core/Resources/RenderResourceAllocator.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
 #include <VoxFlow/Core/Utils/ChromeTracer.hpp>
+#include <algorithm>
 
 namespace VoxFlow
 {
@@ -53,6 +54,12 @@ void SceneRenderer::beginFrameGraph(const FrameContext& frameContext)
     _currentFrameContext = frameContext;
 
     _frameGraph->reset(_commandJobSystem->getCommandStream(_renderCmdStreamKey), _renderResourceAllocator.get());
+    _frameGraph->setAsyncCommandStream(
+        CommandStreamUsage::Compute,
+        _commandJobSystem->getCommandStream({ ._cmdStreamName = ASYNC_COMPUTE_STREAM_NAME, ._cmdStreamUsage = CommandStreamUsage::Compute }));
+    _frameGraph->setAsyncCommandStream(
+        CommandStreamUsage::Transfer,
+        _commandJobSystem->getCommandStream({ ._cmdStreamName = ASYNC_UPLOAD_STREAM_NAME, ._cmdStreamUsage = CommandStreamUsage::Transfer }));
 
     SwapChain* swapChain = _mainLogicalDevice->getSwapChain(_currentFrameContext._swapChainIndex).get();
 
@@ -101,11 +108,55 @@ tf::Future<void> SceneRenderer::resolveSceneRenderPasses(SwapChain* swapChain)
     tf::Taskflow taskflow;
     std::unordered_map<std::string, tf::Task> tasks;
 
+    // Each scene render pass declares into its own scope on worker thread. Scopes are indexed in dependency
+    // order with ties broken by pass name, so the merged frame graph does not depend on thread scheduling.
+    std::vector<std::string> sortedPassNames;
+    sortedPassNames.reserve(_sceneRenderPasses.size());
+    for (const auto& [passName, _] : _sceneRenderPasses)
+    {
+        sortedPassNames.push_back(passName);
+    }
+    std::sort(sortedPassNames.begin(), sortedPassNames.end());
+
+    std::unordered_map<std::string, uint32_t> scopeIndices;
+    // Post-order depth first search with explicit stack of (pass name, index of next dependent pass)
+    std::vector<std::pair<const std::string*, uint32_t>> dfsStack;
+    for (const std::string& passName : sortedPassNames)
+    {
+        if (scopeIndices.find(passName) != scopeIndices.end())
+        {
+            continue;
+        }
+
+        dfsStack.emplace_back(&passName, 0);
+        while (dfsStack.empty() == false)
+        {
+            auto& [currentPassName, dependentIndex] = dfsStack.back();
+            const std::vector<std::string>* dependentPasses = _sceneRenderPasses.find(*currentPassName)->second->getDepenentPasses();
+
+            if (dependentIndex == dependentPasses->size())
+            {
+                scopeIndices.emplace(*currentPassName, static_cast<uint32_t>(scopeIndices.size()));
+                dfsStack.pop_back();
+                continue;
+            }
+
+            const std::string& dependentPassName = (*dependentPasses)[dependentIndex++];
+            if (scopeIndices.find(dependentPassName) == scopeIndices.end())
+            {
+                dfsStack.emplace_back(&dependentPassName, 0);
+            }
+        }
+    }
+
+    _frameGraph->beginConcurrentDeclaration(static_cast<uint32_t>(_sceneRenderPasses.size()));
+
     // Prepare tasks from registered scene render passes
     for (auto iter = _sceneRenderPasses.begin(); iter != _sceneRenderPasses.end(); ++iter)
     {
         SceneRenderPass* pass = iter->second.get();
-        tf::Task fgTask = taskflow.emplace([this, pass]() { pass->renderScene(_frameGraph); }).name(iter->first);
+        FrameGraphDeclarationScope* declarationScope = _frameGraph->getDeclarationScope(scopeIndices[iter->first]);
+        tf::Task fgTask = taskflow.emplace([pass, declarationScope]() { pass->renderScene(declarationScope); }).name(iter->first);
 
         tasks.emplace(iter->first, std::move(fgTask));
     }
@@ -115,13 +166,22 @@ tf::Future<void> SceneRenderer::resolveSceneRenderPasses(SwapChain* swapChain)
     {
         const std::vector<std::string>* dependentPasses = pass->getDepenentPasses();
         tf::Task& fgTask = tasks.find(passName)->second;
+        FrameGraphDeclarationScope* declarationScope = _frameGraph->getDeclarationScope(scopeIndices[passName]);
 
         for (const std::string& dependentPassName : *dependentPasses)
         {
             fgTask.succeed(tasks.find(dependentPassName)->second);
+            declarationScope->addPrecedingScope(_frameGraph->getDeclarationScope(scopeIndices[dependentPassName]));
         }
     }
 
+    // Merge declaration scopes once all scene render passes are declared
+    tf::Task mergeTask = taskflow.emplace([this]() { _frameGraph->endConcurrentDeclaration(); }).name("MergeDeclarations");
+    for (const auto& [passName, _] : _sceneRenderPasses)
+    {
+        tasks.find(passName)->second.precede(mergeTask);
+    }
+
     // Add present pass which followed by all other passes
     ResourceHandle backBufferHandle = _frameGraph->getBlackBoard().getHandle("BackBuffer");
 
@@ -134,12 +194,7 @@ tf::Future<void> SceneRenderer::resolveSceneRenderPasses(SwapChain* swapChain)
             })
             .name("PresentPass");
 
-    for (const auto& [passName, pass] : _sceneRenderPasses)
-    {
-        tf::Task& fgTask = tasks.find(passName)->second;
-
-        fgTask.precede(presentTask);
-    }
+    mergeTask.precede(presentTask);
 
     // Add frame graph compilation task
     taskflow.emplace([&]() { _frameGraph->compile(); }).name("Compilation").succeed(presentTask);
@@ -2,11 +2,31 @@
 
 #include <VoxFlow/Core/Resources/Buffer.hpp>
 #include <VoxFlow/Core/Resources/RenderResourceAllocator.hpp>
+#include <VoxFlow/Core/Resources/RenderResourceGarbageCollector.hpp>
 #include <VoxFlow/Core/Resources/RenderResourceMemoryPool.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
+#include <VoxFlow/Core/Utils/Logger.hpp>
+#include <algorithm>
+#include <iterator>
 
 namespace VoxFlow
 {
+namespace
+{
+// Resources used in a frame can be reused once submissions on every queue in the frame are completed
+bool isAllFencesCompleted(const std::vector<FenceObject>& fences)
+{
+    return std::all_of(fences.begin(), fences.end(), [](const FenceObject& fence) { return fence.isCompleted(); });
+}
+
+std::vector<FenceObject> collectValidFences(std::span<const FenceObject> fences)
+{
+    std::vector<FenceObject> validFences;
+    std::copy_if(fences.begin(), fences.end(), std::back_inserter(validFences), [](const FenceObject& fence) { return fence.isValid(); });
+    return validFences;
+}
+}  // namespace
+
 RenderResourceAllocator::RenderResourceAllocator(LogicalDevice* logicalDevice, RenderResourceMemoryPool* renderResourceMemoryPool)
     : _logicalDevice(logicalDevice), _renderResourceMemoryPool(renderResourceMemoryPool)
 {
@@ -14,6 +34,15 @@ RenderResourceAllocator::RenderResourceAllocator(LogicalDevice* logicalDevice, R
 
 RenderResourceAllocator::~RenderResourceAllocator()
 {
+    _releasedTransientTextures.clear();
+    _transientTexturePool.clear();
+    releaseTransientMemorySlots();
+
+    _transientBufferViews.clear();
+    _inFlightBufferRegions.clear();
+    _retiredBufferRings.clear();
+    _transientBufferRing.reset();
+
     if (_renderResourceMemoryPool != nullptr)
     {
         delete _renderResourceMemoryPool;
@@ -32,6 +61,270 @@ std::shared_ptr<Texture> RenderResourceAllocator::allocateTexture(const TextureI
     return texture;
 }
 
+std::shared_ptr<Texture> RenderResourceAllocator::acquireTransientTexture(const TextureInfo& textureInfo, std::string_view debugName)
+{
+    auto poolIter = _transientTexturePool.find(textureInfo);
+    if (poolIter != _transientTexturePool.end())
+    {
+        std::vector<PooledTexture>& pooledTextures = poolIter->second;
+        for (auto iter = pooledTextures.begin(); iter != pooledTextures.end(); ++iter)
+        {
+            if (isAllFencesCompleted(iter->_lastUsedFences))
+            {
+                std::shared_ptr<Texture> texture = std::move(iter->_texture);
+                pooledTextures.erase(iter);
+                return texture;
+            }
+        }
+    }
+
+    std::shared_ptr<Texture> texture = allocateTexture(textureInfo, std::string(debugName));
+    if (texture != nullptr)
+    {
+        ++_numAllocatedTransientTextures;
+    }
+    return texture;
+}
+
+void RenderResourceAllocator::releaseTransientTexture(std::shared_ptr<Texture>&& texture)
+{
+    if (texture != nullptr)
+    {
+        _releasedTransientTextures.emplace_back(std::move(texture));
+    }
+}
+
+void RenderResourceAllocator::endTransientResourceFrame(std::span<const FenceObject> frameFences)
+{
+    ++_transientFrameIndex;
+
+    const std::vector<FenceObject> validFrameFences = collectValidFences(frameFences);
+
+    for (std::shared_ptr<Texture>& texture : _releasedTransientTextures)
+    {
+        const TextureInfo& textureInfo = texture->getTextureInfo();
+        _transientTexturePool[textureInfo].push_back(
+            PooledTexture{ ._texture = std::move(texture), ._lastUsedFences = validFrameFences, ._lastUsedFrameIndex = _transientFrameIndex });
+    }
+    _releasedTransientTextures.clear();
+
+    // Evict textures not acquired for TRANSIENT_TEXTURE_MAX_AGE frames. Their destruction is deferred by garbage collector.
+    for (auto poolIter = _transientTexturePool.begin(); poolIter != _transientTexturePool.end();)
+    {
+        std::vector<PooledTexture>& pooledTextures = poolIter->second;
+        std::erase_if(pooledTextures, [this](const PooledTexture& pooledTexture) {
+            return (_transientFrameIndex - pooledTexture._lastUsedFrameIndex) > TRANSIENT_TEXTURE_MAX_AGE;
+        });
+
+        if (pooledTextures.empty())
+        {
+            poolIter = _transientTexturePool.erase(poolIter);
+        }
+        else
+        {
+            ++poolIter;
+        }
+    }
+
+    // Views are only referenced while recording this frame, but the regions they point must not be
+    // reused until GPU completes this frame.
+    _transientBufferViews.clear();
+    if (_transientBufferRing != nullptr)
+    {
+        _inFlightBufferRegions.push_back(TransientBufferRegion{
+            ._frameFences = validFrameFences, ._endOffset = _transientBufferRingHead, ._retiredRings = std::move(_retiredBufferRings) });
+        _retiredBufferRings.clear();
+    }
+    reclaimTransientBufferRegions();
+}
+
+BufferView* RenderResourceAllocator::allocateTransientBuffer(const uint64_t size, std::string&& debugName)
+{
+    VOX_ASSERT(size > 0, "Transient buffer({}) must not be empty", debugName);
+
+    const uint64_t alignedSize = (size + TRANSIENT_BUFFER_ALIGNMENT - 1) & ~(TRANSIENT_BUFFER_ALIGNMENT - 1);
+
+    reclaimTransientBufferRegions();
+
+    if ((_transientBufferRing == nullptr) && (growTransientBufferRing(alignedSize) == false))
+    {
+        return nullptr;
+    }
+
+    uint64_t ringHead = _transientBufferRingHead;
+    uint64_t offset = ringHead % _transientBufferRingCapacity;
+
+    // Region must be contiguous, so skip the remainder at the end of the ring
+    if (offset + alignedSize > _transientBufferRingCapacity)
+    {
+        ringHead += _transientBufferRingCapacity - offset;
+        offset = 0;
+    }
+
+    if ((ringHead + alignedSize - _transientBufferRingTail) > _transientBufferRingCapacity)
+    {
+        if (growTransientBufferRing(alignedSize) == false)
+        {
+            return nullptr;
+        }
+
+        ringHead = 0;
+        offset = 0;
+    }
+
+    _transientBufferRingHead = ringHead + alignedSize;
+
+    std::shared_ptr<BufferView> bufferView = std::make_shared<BufferView>(std::move(debugName), _logicalDevice, _transientBufferRing.get());
+    if (bufferView->initialize(BufferViewInfo{ ._offset = offset, ._range = size }) == false)
+    {
+        return nullptr;
+    }
+
+    _transientBufferViews.push_back(bufferView);
+    return bufferView.get();
+}
+
+bool RenderResourceAllocator::growTransientBufferRing(const uint64_t requiredSize)
+{
+    uint64_t newCapacity = std::max(_transientBufferRingCapacity * 2, TRANSIENT_BUFFER_RING_INITIAL_SIZE);
+    while (newCapacity < requiredSize)
+    {
+        newCapacity *= 2;
+    }
+
+    const BufferUsage ringUsage = BufferUsage::ConstantBuffer | BufferUsage::RwStructuredBuffer | BufferUsage::VertexBuffer | BufferUsage::IndexBuffer |
+                                  BufferUsage::IndirectCommand | BufferUsage::CopySrc | BufferUsage::CopyDst;
+
+    std::shared_ptr<Buffer> newRing = allocateBuffer(BufferInfo{ ._size = newCapacity, ._usage = ringUsage }, "TransientBufferRing");
+    if (newRing == nullptr)
+    {
+        VOX_ASSERT(false, "Failed to allocate transient buffer ring with size({})", newCapacity);
+        return false;
+    }
+
+    // Regions of this frame and in-flight frames still point the old ring.
+    // It is retired with the current frame which is completed after all of them.
+    if (_transientBufferRing != nullptr)
+    {
+        _retiredBufferRings.push_back(std::move(_transientBufferRing));
+    }
+
+    for (TransientBufferRegion& region : _inFlightBufferRegions)
+    {
+        region._endOffset = 0;
+    }
+
+    _transientBufferRing = std::move(newRing);
+    _transientBufferRingCapacity = newCapacity;
+    _transientBufferRingHead = 0;
+    _transientBufferRingTail = 0;
+
+    return true;
+}
+
+void RenderResourceAllocator::reclaimTransientBufferRegions()
+{
+    while (_inFlightBufferRegions.empty() == false)
+    {
+        const TransientBufferRegion& region = _inFlightBufferRegions.front();
+        if (isAllFencesCompleted(region._frameFences) == false)
+        {
+            break;
+        }
+
+        _transientBufferRingTail = std::max(_transientBufferRingTail, region._endOffset);
+        _inFlightBufferRegions.pop_front();
+    }
+}
+
+std::shared_ptr<Texture> RenderResourceAllocator::allocateAliasedTexture(const TextureInfo& textureInfo, const uint32_t transientSlot,
+                                                                        std::string_view debugName)
+{
+    if (_transientMemorySlots.size() <= transientSlot)
+    {
+        _transientMemorySlots.resize(transientSlot + 1);
+    }
+
+    TransientMemorySlot& memorySlot = _transientMemorySlots[transientSlot];
+
+    // Reuse already placed texture if exactly same one was requested on this slot before.
+    // Occupants of same slot never overlap their lifetimes, so sharing the image itself is safe.
+    for (const std::shared_ptr<Texture>& placedTexture : memorySlot._placedTextures)
+    {
+        if (placedTexture->getTextureInfo() == textureInfo)
+        {
+            return placedTexture;
+        }
+    }
+
+    std::shared_ptr<Texture> texture = std::make_shared<Texture>(std::string_view(debugName), _logicalDevice, _renderResourceMemoryPool);
+    const VkMemoryRequirements requirements = texture->getMemoryRequirements(textureInfo);
+
+    const bool isCompatibleSlot = (memorySlot._allocation != VK_NULL_HANDLE) && (memorySlot._memoryRequirements.size >= requirements.size) &&
+                                  (memorySlot._memoryRequirements.alignment >= requirements.alignment) &&
+                                  ((requirements.memoryTypeBits & (1U << memorySlot._memoryTypeIndex)) != 0);
+
+    if (isCompatibleSlot == false)
+    {
+        VmaAllocator vmaAllocator = _renderResourceMemoryPool->get();
+        if (memorySlot._allocation != VK_NULL_HANDLE)
+        {
+            // Placed textures must be destroyed before the memory they are bound to.
+            memorySlot._placedTextures.clear();
+
+            VmaAllocation vmaAllocation = memorySlot._allocation;
+            RenderResourceGarbageCollector::Get().pushRenderResourceGarbage(
+                RenderResourceGarbage({}, [vmaAllocator, vmaAllocation]() { vmaFreeMemory(vmaAllocator, vmaAllocation); }));
+            memorySlot._allocation = VK_NULL_HANDLE;
+        }
+
+        VkMemoryRequirements slotRequirements = requirements;
+        slotRequirements.size = std::max(requirements.size, memorySlot._memoryRequirements.size);
+        slotRequirements.alignment = std::max(requirements.alignment, memorySlot._memoryRequirements.alignment);
+
+        const VmaAllocationCreateInfo vmaInfo = { .flags = VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT,
+                                                  .usage = VMA_MEMORY_USAGE_UNKNOWN,
+                                                  .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                  .preferredFlags = 0,
+                                                  .memoryTypeBits = 0,
+                                                  .pool = VK_NULL_HANDLE,
+                                                  .pUserData = nullptr };
+
+        VmaAllocationInfo allocationInfo = {};
+        if (vmaAllocateMemory(vmaAllocator, &slotRequirements, &vmaInfo, &memorySlot._allocation, &allocationInfo) != VK_SUCCESS)
+        {
+            VOX_ASSERT(false, "Failed to allocate transient memory slot({}) with size({})", transientSlot, slotRequirements.size);
+            memorySlot = TransientMemorySlot();
+            return allocateTexture(textureInfo, std::string(debugName));
+        }
+
+        memorySlot._memoryRequirements = slotRequirements;
+        memorySlot._memoryTypeIndex = allocationInfo.memoryType;
+    }
+
+    if (texture->makeAliasedAllocationResident(textureInfo, memorySlot._allocation) == false)
+    {
+        return nullptr;
+    }
+
+    memorySlot._placedTextures.push_back(texture);
+    return texture;
+}
+
+void RenderResourceAllocator::releaseTransientMemorySlots()
+{
+    for (TransientMemorySlot& memorySlot : _transientMemorySlots)
+    {
+        memorySlot._placedTextures.clear();
+
+        if (memorySlot._allocation != VK_NULL_HANDLE)
+        {
+            vmaFreeMemory(_renderResourceMemoryPool->get(), memorySlot._allocation);
+        }
+    }
+    _transientMemorySlots.clear();
+}
+
 std::shared_ptr<Buffer> RenderResourceAllocator::allocateBuffer(const BufferInfo& bufferInfo, std::string&& debugName)
 {
     std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(std::move(debugName), _logicalDevice, _renderResourceMemoryPool);
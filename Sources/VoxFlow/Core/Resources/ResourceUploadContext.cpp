@@ -71,12 +71,12 @@ void ResourceUploadContext::uploadResource(PendingUploadInfo&& uploadInfo, Comma
     switch (resourceType)
     {
         case RenderResourceType::Buffer:
-            cmdStream->addJob(CommandJobType::UploadBuffer, static_cast<Buffer*>(uploadInfo._dstResource), uploadInfo._srcBuffer,
-                              uploadInfo._uploadData._dstOffset, uploadInfo._stagingBufferOffset, uploadInfo._uploadData._size);
+            cmdStream->addJob<CommandJobType::UploadBuffer>(static_cast<Buffer*>(uploadInfo._dstResource), uploadInfo._srcBuffer,
+                                                            uploadInfo._uploadData._dstOffset, uploadInfo._stagingBufferOffset, uploadInfo._uploadData._size);
             break;
         case RenderResourceType::Texture:
-            cmdStream->addJob(CommandJobType::UploadTexture, static_cast<Texture*>(uploadInfo._dstResource), uploadInfo._srcBuffer,
-                              uploadInfo._uploadData._dstOffset, uploadInfo._stagingBufferOffset, uploadInfo._uploadData._size);
+            cmdStream->addJob<CommandJobType::UploadTexture>(static_cast<Texture*>(uploadInfo._dstResource), uploadInfo._srcBuffer,
+                                                             uploadInfo._uploadData._dstOffset, uploadInfo._stagingBufferOffset, uploadInfo._uploadData._size);
             break;
         default:
             break;
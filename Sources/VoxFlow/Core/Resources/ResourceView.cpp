@@ -1,11 +1,15 @@
 // Author : snowapril
 
 #include <VoxFlow/Core/Resources/ResourceView.hpp>
+#include <atomic>
 
 namespace VoxFlow
 {
+static std::atomic<uint64_t> sNextViewId{ 1 };
+
 ResourceView::ResourceView(std::string&& debugName, LogicalDevice* logicalDevice, RenderResource* ownerResource)
-    : _debugName(debugName), _logicalDevice(logicalDevice), _ownerResource(ownerResource)
+    : _debugName(debugName), _logicalDevice(logicalDevice), _ownerResource(ownerResource),
+      _viewId(sNextViewId.fetch_add(1, std::memory_order_relaxed))
 {
 }
 
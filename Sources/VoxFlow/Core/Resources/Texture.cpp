@@ -6,6 +6,7 @@
 #include <VoxFlow/Core/Resources/RenderResourceMemoryPool.hpp>
 #include <VoxFlow/Core/Resources/Texture.hpp>
 #include <VoxFlow/Core/Utils/DebugUtil.hpp>
+#include <VoxFlow/Core/Utils/HashUtil.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
 
 namespace VoxFlow
@@ -25,9 +26,35 @@ static VkImageUsageFlags convertToImageUsage(TextureUsage textureUsage)
         resultUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     if (static_cast<uint32_t>(textureUsage & TextureUsage::CopyDst) > 0)
         resultUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (static_cast<uint32_t>(textureUsage & TextureUsage::InputAttachment) > 0)
+        resultUsage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    if (static_cast<uint32_t>(textureUsage & TextureUsage::TransientAttachment) > 0)
+        resultUsage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
     return resultUsage;
 }
 
+static VkImageCreateInfo makeImageCreateInfo(const TextureInfo& textureInfo)
+{
+    // TODO(snowapril) : mipLevels, arrayLayers
+    return VkImageCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .imageType = textureInfo._imageType,
+        .format = textureInfo._format,
+        .extent = VkExtent3D{ textureInfo._extent.x, textureInfo._extent.y, textureInfo._extent.z },
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = static_cast<VkSampleCountFlagBits>(textureInfo._numSamples),
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = convertToImageUsage(textureInfo._usage),
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+}
+
 VkImageAspectFlags convertToImageAspectFlags(VkFormat vkFormat)
 {
     VkImageAspectFlags aspectFlag = 0;
@@ -118,6 +145,78 @@ bool hasStencilAspect(VkFormat vkFormat)
     }
 }
 
+uint32_t getFormatByteSize(VkFormat vkFormat)
+{
+    switch (vkFormat)
+    {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SNORM:
+        case VK_FORMAT_R8_UINT:
+        case VK_FORMAT_R8_SINT:
+        case VK_FORMAT_S8_UINT:
+            return 1;
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R8G8_SNORM:
+        case VK_FORMAT_R8G8_UINT:
+        case VK_FORMAT_R8G8_SINT:
+        case VK_FORMAT_R16_UNORM:
+        case VK_FORMAT_R16_SNORM:
+        case VK_FORMAT_R16_UINT:
+        case VK_FORMAT_R16_SINT:
+        case VK_FORMAT_R16_SFLOAT:
+        case VK_FORMAT_D16_UNORM:
+            return 2;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+            return 3;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SNORM:
+        case VK_FORMAT_R8G8B8A8_UINT:
+        case VK_FORMAT_R8G8B8A8_SINT:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+        case VK_FORMAT_A2R10G10B10_UINT_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_R16G16_UNORM:
+        case VK_FORMAT_R16G16_SNORM:
+        case VK_FORMAT_R16G16_UINT:
+        case VK_FORMAT_R16G16_SINT:
+        case VK_FORMAT_R16G16_SFLOAT:
+        case VK_FORMAT_R32_UINT:
+        case VK_FORMAT_R32_SINT:
+        case VK_FORMAT_R32_SFLOAT:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+            return 4;
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return 5;
+        case VK_FORMAT_R16G16B16A16_UNORM:
+        case VK_FORMAT_R16G16B16A16_SNORM:
+        case VK_FORMAT_R16G16B16A16_UINT:
+        case VK_FORMAT_R16G16B16A16_SINT:
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_UINT:
+        case VK_FORMAT_R32G32_SINT:
+        case VK_FORMAT_R32G32_SFLOAT:
+        case VK_FORMAT_R64_UINT:
+        case VK_FORMAT_R64_SINT:
+            return 8;
+        case VK_FORMAT_R32G32B32_UINT:
+        case VK_FORMAT_R32G32B32_SINT:
+        case VK_FORMAT_R32G32B32_SFLOAT:
+            return 12;
+        case VK_FORMAT_R32G32B32A32_UINT:
+        case VK_FORMAT_R32G32B32A32_SINT:
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        default:
+            VOX_ASSERT(false, "Unhandled format({}) byte size is requested", static_cast<uint32_t>(vkFormat));
+            return 4;
+    }
+}
+
 Texture::Texture(std::string_view&& debugName, LogicalDevice* logicalDevice, RenderResourceMemoryPool* renderResourceMemoryPool)
     : RenderResource(std::move(debugName), logicalDevice, renderResourceMemoryPool)
 {
@@ -133,25 +232,8 @@ bool Texture::makeAllocationResident(const TextureInfo& textureInfo)
 
     VOX_ASSERT(textureInfo._usage != TextureUsage::Unknown, "TextureUsage must be specified");
 
-    // TODO(snowapril) : sample count, mipLevels, arrayLayers
     _textureInfo = textureInfo;
-    VkImageCreateInfo imageCreateInfo{
-        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .imageType = textureInfo._imageType,
-        .format = textureInfo._format,
-        .extent = VkExtent3D{ textureInfo._extent.x, textureInfo._extent.y, textureInfo._extent.z },
-        .mipLevels = 1,
-        .arrayLayers = 1,
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .tiling = VK_IMAGE_TILING_OPTIMAL,
-        .usage = convertToImageUsage(textureInfo._usage),
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-    };
+    const VkImageCreateInfo imageCreateInfo = makeImageCreateInfo(textureInfo);
 
     VmaAllocationCreateInfo vmaInfo = { .flags = VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT,  // TODO(snowapril) :
                                                                                                  // choose best one
@@ -162,6 +244,12 @@ bool Texture::makeAllocationResident(const TextureInfo& textureInfo)
                                         .pool = VK_NULL_HANDLE,
                                         .pUserData = nullptr };
 
+    // Transient attachment never leaves the render pass, so lazily allocated memory is preferred where available
+    if (static_cast<uint32_t>(textureInfo._usage & TextureUsage::TransientAttachment) > 0)
+    {
+        vmaInfo.preferredFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    }
+
     VK_ASSERT(vmaCreateImage(_renderResourceMemoryPool->get(), &imageCreateInfo, &vmaInfo, &_vkImage, &_allocation, nullptr));
 
     if (_vkImage == VK_NULL_HANDLE)
@@ -171,28 +259,64 @@ bool Texture::makeAllocationResident(const TextureInfo& textureInfo)
     }
 
     _isSwapChainBackBuffer = false;
+    _isAliasedAllocation = false;
 
 #if defined(VK_DEBUG_NAME_ENABLED)
     DebugUtil::setObjectName(_logicalDevice, _vkImage, _debugName.c_str());
 #endif
 
-    const std::optional<uint32_t> defaultViewIndex =
-        createTextureView(TextureViewInfo{ ._viewType = convertToImageViewType(_textureInfo._imageType, _textureInfo._extent),
-                                           ._format = _textureInfo._format,
-                                           ._aspectFlags = convertToImageAspectFlags(_textureInfo._format),
-                                           ._baseMipLevel = 0,
-                                           ._levelCount = 1,
-                                           ._baseArrayLayer = 0,
-                                           ._layerCount = 1 });
+    return createDefaultView();
+}
 
-    VOX_ASSERT(defaultViewIndex.has_value(), "Failed to create default texture view for texture({})", _debugName);
+bool Texture::makeAliasedAllocationResident(const TextureInfo& textureInfo, VmaAllocation aliasedAllocation)
+{
+    release();
 
-    if (defaultViewIndex.has_value())
+    VOX_ASSERT(textureInfo._usage != TextureUsage::Unknown, "TextureUsage must be specified");
+    VOX_ASSERT(aliasedAllocation != VK_NULL_HANDLE, "Aliased allocation must be given");
+
+    _textureInfo = textureInfo;
+    const VkImageCreateInfo imageCreateInfo = makeImageCreateInfo(textureInfo);
+
+    VK_ASSERT(vkCreateImage(_logicalDevice->get(), &imageCreateInfo, nullptr, &_vkImage));
+
+    if (_vkImage == VK_NULL_HANDLE)
     {
-        _defaultView = getView(defaultViewIndex.value()).get();
+        VOX_ASSERT(false, "Failed to initialize image({})", _debugName);
+        return false;
     }
 
-    return true;
+    VK_ASSERT(vmaBindImageMemory(_renderResourceMemoryPool->get(), aliasedAllocation, _vkImage));
+
+    _isSwapChainBackBuffer = false;
+    _isAliasedAllocation = true;
+
+#if defined(VK_DEBUG_NAME_ENABLED)
+    DebugUtil::setObjectName(_logicalDevice, _vkImage, _debugName.c_str());
+#endif
+
+    return createDefaultView();
+}
+
+VkMemoryRequirements Texture::getMemoryRequirements(const TextureInfo& textureInfo) const
+{
+    const VkImageCreateInfo imageCreateInfo = makeImageCreateInfo(textureInfo);
+
+    const VkDeviceImageMemoryRequirements imageMemoryRequirements = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+        .pNext = nullptr,
+        .pCreateInfo = &imageCreateInfo,
+        .planeAspect = static_cast<VkImageAspectFlagBits>(0),
+    };
+
+    VkMemoryRequirements2 memoryRequirements = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+        .pNext = nullptr,
+        .memoryRequirements = {},
+    };
+    vkGetDeviceImageMemoryRequirements(_logicalDevice->get(), &imageMemoryRequirements, &memoryRequirements);
+
+    return memoryRequirements.memoryRequirements;
 }
 
 bool Texture::initializeFromSwapChain(const TextureInfo& swapChainSurfaceInfo, VkImage swapChainImage)
@@ -203,11 +327,17 @@ bool Texture::initializeFromSwapChain(const TextureInfo& swapChainSurfaceInfo, V
     _vkImage = swapChainImage;
 
     _isSwapChainBackBuffer = true;
+    _isAliasedAllocation = false;
 
 #if defined(VK_DEBUG_NAME_ENABLED)
     DebugUtil::setObjectName(_logicalDevice, _vkImage, _debugName.c_str());
 #endif
 
+    return createDefaultView();
+}
+
+bool Texture::createDefaultView()
+{
     const std::optional<uint32_t> defaultViewIndex =
         createTextureView(TextureViewInfo{ ._viewType = convertToImageViewType(_textureInfo._imageType, _textureInfo._extent),
                                            ._format = _textureInfo._format,
@@ -244,7 +374,17 @@ std::optional<uint32_t> Texture::createTextureView(const TextureViewInfo& viewIn
 void Texture::release()
 {
     _ownedTextureViews.clear();
-    if ((_isSwapChainBackBuffer == false) && (_vkImage != VK_NULL_HANDLE))
+    if (_isAliasedAllocation && (_vkImage != VK_NULL_HANDLE))
+    {
+        // Memory of aliased image is owned by its transient memory slot
+        VkDevice vkDevice = _logicalDevice->get();
+        VkImage vkImage = _vkImage;
+        RenderResourceGarbageCollector::Get().pushRenderResourceGarbage(
+            RenderResourceGarbage(std::move(_accessedFences), [vkDevice, vkImage]() { vkDestroyImage(vkDevice, vkImage, nullptr); }));
+
+        _vkImage = VK_NULL_HANDLE;
+    }
+    else if ((_isSwapChainBackBuffer == false) && (_vkImage != VK_NULL_HANDLE))
     {
         VmaAllocator vmaAllocator = _renderResourceMemoryPool->get();
         VkImage vkImage = _vkImage;
@@ -322,4 +462,19 @@ VkDescriptorImageInfo TextureView::getDescriptorImageInfo() const
     };
 }
 
-}  // namespace VoxFlow
\ No newline at end of file
+}  // namespace VoxFlow
+
+std::size_t std::hash<VoxFlow::TextureInfo>::operator()(VoxFlow::TextureInfo const& textureInfo) const noexcept
+{
+    uint32_t seed = 0;
+
+    VoxFlow::hash_combine(seed, textureInfo._extent.x);
+    VoxFlow::hash_combine(seed, textureInfo._extent.y);
+    VoxFlow::hash_combine(seed, textureInfo._extent.z);
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(textureInfo._format));
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(textureInfo._imageType));
+    VoxFlow::hash_combine(seed, static_cast<uint32_t>(textureInfo._usage));
+    VoxFlow::hash_combine(seed, textureInfo._numSamples);
+
+    return seed;
+}
@@ -2,6 +2,7 @@
 
 #include <VoxFlow/Core/Utils/Logger.hpp>
 #include <VoxFlow/Core/Utils/MemoryAllocator.hpp>
+#include <algorithm>
 
 namespace VoxFlow
 {
@@ -153,4 +154,66 @@ void LinearMemoryAllocator::defragment()
 {
     _linearBlockAllocator.defragment();
 }
+ArenaAllocator::ArenaAllocator(const uint64_t blockSize) : _blockSize(blockSize)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    reset();
+}
+
+void* ArenaAllocator::allocate(const uint64_t size, const uint64_t alignment)
+{
+    ++_numAllocations;
+
+    while (true)
+    {
+        // Allocation larger than block size occupies dedicated block
+        if (_currentBlockIndex == _blocks.size())
+        {
+            const uint64_t newBlockSize = std::max(_blockSize, size + alignment);
+            _blocks.push_back({ ._data = std::make_unique<uint8_t[]>(newBlockSize), ._size = newBlockSize });
+        }
+
+        const Block& block = _blocks[_currentBlockIndex];
+        const uint64_t address = reinterpret_cast<uint64_t>(block._data.get()) + _currentOffset;
+        const uint64_t alignedOffset = _currentOffset + ((alignment - (address % alignment)) % alignment);
+
+        if (alignedOffset + size <= block._size)
+        {
+            _currentOffset = alignedOffset + size;
+            return block._data.get() + alignedOffset;
+        }
+
+        ++_currentBlockIndex;
+        _currentOffset = 0;
+    }
+}
+
+std::string_view ArenaAllocator::copyString(std::string_view str)
+{
+    if (str.empty())
+    {
+        return std::string_view();
+    }
+
+    char* data = static_cast<char*>(allocate(str.size(), alignof(char)));
+    std::copy(str.begin(), str.end(), data);
+    return std::string_view(data, str.size());
+}
+
+void ArenaAllocator::reset()
+{
+    for (DestructorNode* destructorNode = _destructorList; destructorNode != nullptr; destructorNode = destructorNode->_next)
+    {
+        destructorNode->_destruct(destructorNode->_object);
+    }
+
+    _destructorList = nullptr;
+    _currentBlockIndex = 0;
+    _currentOffset = 0;
+    _numAllocations = 0;
+}
+
 }  // namespace VoxFlow
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <VoxFlow/Core/Utils/Thread.hpp>
 
 #include <cstdlib>
+#include <vector>
 
 #if defined(_WIN32)
 #define NOMINMAX
@@ -13,6 +14,47 @@
 
 namespace VoxFlow
 {
+namespace
+{
+std::mutex sWorkerIndexMutex;
+std::vector<uint32_t> sFreeWorkerIndices;
+uint32_t sNumWorkerIndices = 0;
+
+// Worker index is acquired at the first query of each thread and returned when the thread exits
+struct WorkerIndexHolder
+{
+    WorkerIndexHolder()
+    {
+        std::lock_guard<std::mutex> scopedLock(sWorkerIndexMutex);
+        if (sFreeWorkerIndices.empty())
+        {
+            VOX_ASSERT(sNumWorkerIndices < Thread::MAX_NUM_WORKER_THREADS, "Number of running threads exceeds the limit({})",
+                       Thread::MAX_NUM_WORKER_THREADS);
+            _workerIndex = sNumWorkerIndices++;
+        }
+        else
+        {
+            _workerIndex = sFreeWorkerIndices.back();
+            sFreeWorkerIndices.pop_back();
+        }
+    }
+
+    ~WorkerIndexHolder()
+    {
+        std::lock_guard<std::mutex> scopedLock(sWorkerIndexMutex);
+        sFreeWorkerIndices.push_back(_workerIndex);
+    }
+
+    uint32_t _workerIndex = 0;
+};
+}  // namespace
+
+uint32_t Thread::GetWorkerIndex()
+{
+    thread_local WorkerIndexHolder tWorkerIndexHolder;
+    return tWorkerIndexHolder._workerIndex;
+}
+
 void Thread::SetThreadName(const char* threadName)
 {
 #if defined(_WIN32)
@@ -12,6 +12,7 @@
 #include <VoxFlow/Core/Resources/Texture.hpp>
 #include <VoxFlow/Core/Utils/Logger.hpp>
 #include <VoxFlow/Editor/RenderPass/PostProcessPass.hpp>
+#include <array>
 
 namespace VoxFlow
 {
@@ -35,6 +36,8 @@ bool PostProcessPass::initialize()
     pipelineState.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
     _toneMapPipeline->setPipelineState(pipelineState);
 
+    _sceneColorSlot = _toneMapPipeline->findBindingSlot("g_sceneColor");
+
     return true;
 }
 
@@ -43,52 +46,52 @@ void PostProcessPass::updateRender(ResourceUploadContext* uploadContext)
     (void)uploadContext;
 }
 
-void PostProcessPass::renderScene(RenderGraph::FrameGraph* frameGraph)
+void PostProcessPass::renderScene(RenderGraph::FrameGraphDeclarationScope* declarationScope)
 {
     using namespace RenderGraph;
 
-    BlackBoard& blackBoard = frameGraph->getBlackBoard();
-
-    _passData = frameGraph->addCallbackPass<PostProcessPassData>(
+    _passData = declarationScope->addCallbackPass<PostProcessPassData>(
         "PostProcessPass",
         [&](FrameGraphBuilder& builder, PostProcessPassData& passData) {
-            ResourceHandle backBufferHandle = blackBoard.getHandle("BackBuffer");
+            ResourceHandle backBufferHandle = declarationScope->getHandle("BackBuffer");
 
-            ResourceHandle sceneColorHandle = blackBoard.getHandle("SceneColor");
+            // Scene color is published by the scene object pass which is declared before this pass
+            ResourceHandle sceneColorHandle = declarationScope->getHandle("SceneColor");
+            passData._sceneColorHandle = sceneColorHandle;
 
-            const auto& sceneColorDesc = frameGraph->getResourceDescriptor<FrameGraphTexture>(sceneColorHandle);
+            const auto& sceneColorDesc = declarationScope->getFrameGraph()->getResourceDescriptor<FrameGraphTexture>(sceneColorHandle);
 
-            builder.read<FrameGraphTexture>(sceneColorHandle, TextureUsage::Sampled);
+            // Scene color is read at the same pixel, so post process can be merged into the scene render pass as a subpass
+            builder.read<FrameGraphTexture>(sceneColorHandle, TextureUsage::InputAttachment);
             builder.write<FrameGraphTexture>(backBufferHandle, TextureUsage::BackBuffer);
 
             auto descriptor = FrameGraphRenderPass::Descriptor{ ._viewportSize = glm::uvec2(sceneColorDesc._width, sceneColorDesc._height),
                                                                 ._writableAttachment = AttachmentMaskFlags::Color0,
                                                                 ._numSamples = 1 };
             descriptor._attachments[0] = backBufferHandle;
+            descriptor._inputAttachments[0] = sceneColorHandle;
 
             passData._renderPassID = builder.declareRenderPass("PostProcess RenderPass", std::move(descriptor));
         },
         [&](const FrameGraphResources* fgResources, PostProcessPassData& passData, CommandStream* cmdStream) {
             RenderPassData* rpData = fgResources->getRenderPassData(passData._renderPassID);
 
-            cmdStream->addJob(CommandJobType::BeginRenderPass, rpData->_attachmentGroup, rpData->_passParams);
+            cmdStream->addJob<CommandJobType::BeginRenderPass>(rpData->_attachmentGroup, rpData->_passParams);
 
-            cmdStream->addJob(CommandJobType::BindPipeline, _toneMapPipeline.get());
+            cmdStream->addJob<CommandJobType::BindPipeline>(_toneMapPipeline.get());
 
-            ResourceHandle sceneColorHandle = blackBoard.getHandle("SceneColor");
-            TextureView* sceneColorView = fgResources->getTextureView(sceneColorHandle);
+            TextureView* sceneColorView = fgResources->getTextureView(passData._sceneColorHandle);
 
-            cmdStream->addJob(CommandJobType::BindResourceGroup, SetSlotCategory::PerRenderPass,
-                              std::vector<ShaderVariableBinding>{ ShaderVariableBinding{
-                                  ._variableName = "g_sceneColor", ._view = sceneColorView, ._usage = ResourceAccessMask::ShaderReadOnly } });
+            cmdStream->addJob<CommandJobType::BindResourceSlots>(
+                std::array{ ShaderSlotBinding{ ._slot = _sceneColorSlot, ._view = sceneColorView, ._usage = ResourceAccessMask::ShaderReadOnly } });
 
-            const auto& sceneColorDesc = fgResources->getResourceDescriptor<FrameGraphTexture>(sceneColorHandle);
+            const auto& sceneColorDesc = fgResources->getResourceDescriptor<FrameGraphTexture>(passData._sceneColorHandle);
 
-            cmdStream->addJob(CommandJobType::SetViewport, glm::uvec2(sceneColorDesc._width, sceneColorDesc._height));
+            cmdStream->addJob<CommandJobType::SetViewport>(glm::uvec2(sceneColorDesc._width, sceneColorDesc._height));
 
-            cmdStream->addJob(CommandJobType::Draw, 4, 1, 0, 0);
+            cmdStream->addJob<CommandJobType::Draw>(4, 1, 0, 0);
 
-            cmdStream->addJob(CommandJobType::EndRenderPass);
+            cmdStream->addJob<CommandJobType::EndRenderPass>();
         });
 }
 
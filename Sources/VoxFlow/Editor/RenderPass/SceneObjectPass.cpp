@@ -68,16 +68,16 @@ void SceneObjectPass::updateRender(ResourceUploadContext* uploadContext)
                                     UploadData{ ._data = &cubeIndices[0], ._size = cubeIndices.size() * sizeof(uint32_t), ._dstOffset = 0 });
 }
 
-void SceneObjectPass::renderScene(RenderGraph::FrameGraph* frameGraph)
+void SceneObjectPass::renderScene(RenderGraph::FrameGraphDeclarationScope* declarationScope)
 {
     using namespace RenderGraph;
 
-    BlackBoard& blackBoard = frameGraph->getBlackBoard();
-    ResourceHandle backBufferHandle = blackBoard.getHandle("BackBuffer");
+    BlackBoard& blackBoard = declarationScope->getBlackBoard();
+    ResourceHandle backBufferHandle = declarationScope->getHandle("BackBuffer");
 
-    const auto& backBufferDesc = frameGraph->getResourceDescriptor<FrameGraphTexture>(backBufferHandle);
+    const auto& backBufferDesc = declarationScope->getFrameGraph()->getResourceDescriptor<FrameGraphTexture>(backBufferHandle);
 
-    _passData = frameGraph->addCallbackPass<SceneObjectPassData>(
+    _passData = declarationScope->addCallbackPass<SceneObjectPassData>(
         "SceneObjectPass",
         [&](FrameGraphBuilder& builder, SceneObjectPassData& passData) {
             passData._sceneColorHandle =
@@ -116,20 +116,20 @@ void SceneObjectPass::renderScene(RenderGraph::FrameGraph* frameGraph)
         [&](const FrameGraphResources* fgResources, SceneObjectPassData& passData, CommandStream* cmdStream) {
             RenderPassData* rpData = fgResources->getRenderPassData(passData._renderPassID);
 
-            cmdStream->addJob(CommandJobType::BeginRenderPass, rpData->_attachmentGroup, rpData->_passParams);
-            cmdStream->addJob(CommandJobType::BindPipeline, _sceneObjectPipeline.get());
+            cmdStream->addJob<CommandJobType::BeginRenderPass>(rpData->_attachmentGroup, rpData->_passParams);
+            cmdStream->addJob<CommandJobType::BindPipeline>(_sceneObjectPipeline.get());
 
-            cmdStream->addJob(CommandJobType::BindVertexBuffer, _cubeVertexBuffer);
+            cmdStream->addJob<CommandJobType::BindVertexBuffer>(_cubeVertexBuffer.get());
 
-            cmdStream->addJob(CommandJobType::BindIndexBuffer, _cubeIndexBuffer);
+            cmdStream->addJob<CommandJobType::BindIndexBuffer>(_cubeIndexBuffer.get());
 
             const auto& sceneColorDesc = fgResources->getResourceDescriptor<FrameGraphTexture>(passData._sceneColorHandle);
 
-            cmdStream->addJob(CommandJobType::SetViewport, glm::uvec2(sceneColorDesc._width, sceneColorDesc._height));
+            cmdStream->addJob<CommandJobType::SetViewport>(glm::uvec2(sceneColorDesc._width, sceneColorDesc._height));
 
-            cmdStream->addJob(CommandJobType::DrawIndexed, 36, 1, 0, 0, 0);
+            cmdStream->addJob<CommandJobType::DrawIndexed>(36, 1, 0, 0, 0);
 
-            cmdStream->addJob(CommandJobType::EndRenderPass);
+            cmdStream->addJob<CommandJobType::EndRenderPass>();
         });
 }
 
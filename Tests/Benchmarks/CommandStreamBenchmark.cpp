@@ -0,0 +1,216 @@
+// Author : snowapril
+
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace VoxFlow;
+
+struct BenchmarkConfig
+{
+    std::vector<uint32_t> _numThreadsList = { 1, 2, 4, 8, 16, 32 };
+    uint32_t _numJobsPerThread = 1 << 16;
+    // Recording threads interleave jobs of every stream as passes of each queue type do
+    uint32_t _numStreams = 3;
+    uint32_t _numIterations = 5;
+    std::string _outputPath;
+};
+
+struct IterationResult
+{
+    double _recordTime = 0.0;
+    double _maxThreadRecordTime = 0.0;
+};
+
+// Record jobs which carry typical payloads of a draw without touching any device object
+void recordJobs(const std::vector<std::unique_ptr<CommandStream>>& cmdStreams, const uint32_t numJobs)
+{
+    const uint32_t numStreams = static_cast<uint32_t>(cmdStreams.size());
+    for (uint32_t jobIndex = 0; jobIndex < numJobs; ++jobIndex)
+    {
+        CommandStream* cmdStream = cmdStreams[jobIndex % numStreams].get();
+        switch (jobIndex % 4)
+        {
+            case 0:
+                cmdStream->addJob<CommandJobType::BindPipeline>(nullptr);
+                break;
+            case 1:
+                cmdStream->addJob<CommandJobType::SetViewport>(glm::uvec2(1920, 1080));
+                break;
+            case 2:
+                cmdStream->addJob<CommandJobType::BindVertexBuffer>(nullptr);
+                break;
+            default:
+                cmdStream->addJob<CommandJobType::DrawIndexed>(36U, 1U, 0U, 0, jobIndex);
+                break;
+        }
+    }
+}
+
+IterationResult runIteration(const BenchmarkConfig& config, const uint32_t numThreads)
+{
+    // Streams without device only record packets, and fresh threads take worker indices as a new executor does
+    std::vector<std::unique_ptr<CommandStream>> cmdStreams;
+    for (uint32_t i = 0; i < config._numStreams; ++i)
+    {
+        cmdStreams.emplace_back(std::make_unique<CommandStream>(nullptr, nullptr));
+    }
+
+    std::atomic<uint32_t> numReadyThreads{ 0 };
+    std::atomic<bool> isStarted{ false };
+    std::vector<double> threadRecordTimes(numThreads, 0.0);
+
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            // Register packet buffers before the measurement as the first frame of a worker does
+            recordJobs(cmdStreams, config._numStreams);
+
+            numReadyThreads.fetch_add(1, std::memory_order_acq_rel);
+            while (isStarted.load(std::memory_order_acquire) == false)
+            {
+                std::this_thread::yield();
+            }
+
+            const auto startTime = std::chrono::steady_clock::now();
+            recordJobs(cmdStreams, config._numJobsPerThread);
+            const auto endTime = std::chrono::steady_clock::now();
+            threadRecordTimes[threadIndex] = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+        });
+    }
+
+    while (numReadyThreads.load(std::memory_order_acquire) < numThreads)
+    {
+        std::this_thread::yield();
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    isStarted.store(true, std::memory_order_release);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    const auto endTime = std::chrono::steady_clock::now();
+
+    IterationResult result;
+    result._recordTime = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+    result._maxThreadRecordTime = *std::max_element(threadRecordTimes.begin(), threadRecordTimes.end());
+    return result;
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkConfig& config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = (i + 1) < argc;
+
+        if ((argument == "--threads") && hasValue)
+        {
+            config._numThreadsList.clear();
+            std::istringstream isstr(argv[++i]);
+            std::string token;
+            while (std::getline(isstr, token, ','))
+            {
+                config._numThreadsList.push_back(std::max(static_cast<uint32_t>(std::stoul(token)), 1U));
+            }
+        }
+        else if ((argument == "--jobs") && hasValue)
+            config._numJobsPerThread = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--streams") && hasValue)
+            config._numStreams = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--iterations") && hasValue)
+            config._numIterations = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--output") && hasValue)
+            config._outputPath = argv[++i];
+        else
+            return false;
+    }
+
+    const bool exceedsWorkerLimit = std::any_of(config._numThreadsList.begin(), config._numThreadsList.end(),
+                                                [](const uint32_t numThreads) { return numThreads > Thread::MAX_NUM_WORKER_THREADS; });
+    return (config._numThreadsList.empty() == false) && (exceedsWorkerLimit == false);
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig config;
+    if (parseArguments(argc, argv, config) == false)
+    {
+        std::cerr << "Usage: CommandStreamBenchmark [--threads 1,2,4,8,16,32] [--jobs 65536] [--streams 3] [--iterations 5] [--output result.json]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    nlohmann::json report;
+    report["config"] = { { "jobsPerThread", config._numJobsPerThread },
+                         { "streams", config._numStreams },
+                         { "iterations", config._numIterations },
+                         { "hardwareConcurrency", std::thread::hardware_concurrency() } };
+    report["results"] = nlohmann::json::array();
+
+    double singleThreadJobsPerSecond = 0.0;
+    for (const uint32_t numThreads : config._numThreadsList)
+    {
+        std::vector<double> recordTimes;
+        std::vector<double> maxThreadRecordTimes;
+        for (uint32_t iteration = 0; iteration < config._numIterations; ++iteration)
+        {
+            const IterationResult result = runIteration(config, numThreads);
+            recordTimes.push_back(result._recordTime);
+            maxThreadRecordTimes.push_back(result._maxThreadRecordTime);
+        }
+
+        const double recordTime = median(recordTimes);
+        const double maxThreadRecordTime = median(maxThreadRecordTimes);
+        const double numJobs = static_cast<double>(numThreads) * config._numJobsPerThread;
+        const double jobsPerSecond = numJobs / (recordTime * 1e-6);
+        if (numThreads == 1)
+        {
+            singleThreadJobsPerSecond = jobsPerSecond;
+        }
+
+        // Scaling is 1.0 when throughput grows linearly with recording threads
+        const double scaling = singleThreadJobsPerSecond > 0.0 ? jobsPerSecond / (singleThreadJobsPerSecond * numThreads) : 0.0;
+
+        report["results"].push_back({ { "threads", numThreads },
+                                      { "jobs", static_cast<uint64_t>(numJobs) },
+                                      { "timeMicroseconds", { { "record", recordTime }, { "slowestThread", maxThreadRecordTime } } },
+                                      { "nanosecondsPerJob", (maxThreadRecordTime * 1e3) / config._numJobsPerThread },
+                                      { "jobsPerSecond", jobsPerSecond },
+                                      { "scaling", scaling } });
+    }
+
+    const std::string reportText = report.dump(4);
+    if (config._outputPath.empty())
+    {
+        std::cout << reportText << std::endl;
+    }
+    else
+    {
+        std::ofstream outputFile(config._outputPath);
+        outputFile << reportText << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
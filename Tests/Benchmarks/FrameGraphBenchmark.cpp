@@ -0,0 +1,359 @@
+// Author : snowapril
+
+#include <VoxFlow/Core/FrameGraph/FrameGraph.hpp>
+#include <VoxFlow/Core/FrameGraph/FrameGraphTexture.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Count every heap allocation of the process so that allocation regressions of the graph compiler
+// are caught together with timing ones.
+static std::atomic<uint64_t> sNumHeapAllocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    sNumHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+using namespace VoxFlow;
+
+struct BenchmarkConfig
+{
+    std::vector<uint32_t> _numPassesList = { 100, 1000, 10000, 50000 };
+    uint32_t _fanIn = 2;
+    uint32_t _fanOut = 1;
+    // Inputs of each pass are chosen among resources written by this number of previous passes
+    uint32_t _window = 32;
+    uint32_t _numIterations = 5;
+    uint32_t _seed = 1234;
+    std::string _outputPath;
+};
+
+/**
+ * Randomly generated DAG. Passes only read resources written by previous passes, so that
+ * the graph never has cycle. The last pass reads every resource in the window and writes back buffer.
+ */
+struct SyntheticGraph
+{
+    uint32_t _numPasses = 0;
+    uint32_t _fanOut = 0;
+    std::vector<uint32_t> _inputOffsets;
+    std::vector<uint32_t> _inputs;
+    std::vector<uint32_t> _sinkInputs;
+};
+
+struct FrameResult
+{
+    double _setupTime = 0.0;
+    double _compileTime = 0.0;
+    double _cachedCompileTime = 0.0;
+    double _graphVizTime = 0.0;
+    uint64_t _numSetupAllocations = 0;
+    uint64_t _numCompileAllocations = 0;
+    uint64_t _numCachedCompileAllocations = 0;
+    uint32_t _numEdges = 0;
+    uint32_t _numCulledResources = 0;
+    uint32_t _numExecutionBatches = 0;
+    uint32_t _numPlannedBarriers = 0;
+    uint32_t _numTransientMemorySlots = 0;
+    uint64_t _numArenaAllocations = 0;
+    uint64_t _numArenaHeapBlocks = 0;
+    uint64_t _graphVizBytes = 0;
+    bool _isCompiled = false;
+};
+
+SyntheticGraph generateGraph(const BenchmarkConfig& config, const uint32_t numPasses)
+{
+    SyntheticGraph graph;
+    graph._numPasses = numPasses;
+    graph._fanOut = config._fanOut;
+    graph._inputOffsets.reserve(numPasses + 1);
+    graph._inputs.reserve(static_cast<size_t>(numPasses) * config._fanIn);
+
+    std::mt19937 randomEngine(config._seed + numPasses);
+    std::vector<uint32_t> candidates;
+
+    for (uint32_t passIndex = 0; passIndex < numPasses; ++passIndex)
+    {
+        graph._inputOffsets.push_back(static_cast<uint32_t>(graph._inputs.size()));
+
+        const uint32_t windowBegin = passIndex > config._window ? (passIndex - config._window) * config._fanOut : 0;
+        const uint32_t windowEnd = passIndex * config._fanOut;
+
+        candidates.clear();
+        for (uint32_t resourceIndex = windowBegin; resourceIndex < windowEnd; ++resourceIndex)
+        {
+            candidates.push_back(resourceIndex);
+        }
+
+        const uint32_t numInputs = std::min(config._fanIn, static_cast<uint32_t>(candidates.size()));
+        for (uint32_t i = 0; i < numInputs; ++i)
+        {
+            std::uniform_int_distribution<uint32_t> distribution(i, static_cast<uint32_t>(candidates.size()) - 1);
+            std::swap(candidates[i], candidates[distribution(randomEngine)]);
+            graph._inputs.push_back(candidates[i]);
+        }
+    }
+    graph._inputOffsets.push_back(static_cast<uint32_t>(graph._inputs.size()));
+
+    // Resources outside of the window which no pass reads are culled with their producers
+    const uint32_t numResources = numPasses * config._fanOut;
+    const uint32_t sinkBegin = numPasses > config._window ? (numPasses - config._window) * config._fanOut : 0;
+    for (uint32_t resourceIndex = sinkBegin; resourceIndex < numResources; ++resourceIndex)
+    {
+        graph._sinkInputs.push_back(resourceIndex);
+    }
+
+    return graph;
+}
+
+void declareGraph(RenderGraph::FrameGraph& frameGraph, const SyntheticGraph& graph, std::vector<RenderGraph::ResourceHandle>& resourceHandles)
+{
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct BenchmarkPassData
+    {
+    };
+
+    resourceHandles.resize(static_cast<size_t>(graph._numPasses) * graph._fanOut);
+
+    for (uint32_t passIndex = 0; passIndex < graph._numPasses; ++passIndex)
+    {
+        frameGraph.addCallbackPass<BenchmarkPassData>(
+            "Synthetic Pass",
+            [&](RenderGraph::FrameGraphBuilder& builder, BenchmarkPassData&) {
+                for (uint32_t i = graph._inputOffsets[passIndex]; i < graph._inputOffsets[passIndex + 1]; ++i)
+                {
+                    builder.read<RenderGraph::FrameGraphTexture>(resourceHandles[graph._inputs[i]], TextureUsage::Sampled);
+                }
+
+                for (uint32_t i = 0; i < graph._fanOut; ++i)
+                {
+                    const uint32_t resourceIndex = passIndex * graph._fanOut + i;
+                    RenderGraph::ResourceHandle output = builder.allocate<RenderGraph::FrameGraphTexture>(
+                        "Synthetic Resource " + std::to_string(resourceIndex), RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                    resourceHandles[resourceIndex] = builder.write<RenderGraph::FrameGraphTexture>(output, TextureUsage::Storage);
+                }
+            },
+            [](const RenderGraph::FrameGraphResources*, BenchmarkPassData&, CommandStream*) {});
+    }
+
+    frameGraph.addCallbackPass<BenchmarkPassData>(
+        "Synthetic Sink Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, BenchmarkPassData&) {
+            for (const uint32_t resourceIndex : graph._sinkInputs)
+            {
+                builder.read<RenderGraph::FrameGraphTexture>(resourceHandles[resourceIndex], TextureUsage::Sampled);
+            }
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, BenchmarkPassData&, CommandStream*) {});
+}
+
+template <typename Function>
+double measureMicroseconds(uint64_t& numAllocations, Function&& function)
+{
+    const uint64_t allocationsBegin = sNumHeapAllocations.load(std::memory_order_relaxed);
+    const auto startTime = std::chrono::steady_clock::now();
+    function();
+    const auto endTime = std::chrono::steady_clock::now();
+    numAllocations = sNumHeapAllocations.load(std::memory_order_relaxed) - allocationsBegin;
+
+    return std::chrono::duration<double, std::micro>(endTime - startTime).count();
+}
+
+FrameResult runFrame(const SyntheticGraph& graph)
+{
+    FrameResult result;
+    std::vector<RenderGraph::ResourceHandle> resourceHandles;
+
+    // Fresh frame graph measures the full compile without any cache from the previous frames
+    RenderGraph::FrameGraph frameGraph;
+
+    result._setupTime = measureMicroseconds(result._numSetupAllocations, [&]() { declareGraph(frameGraph, graph, resourceHandles); });
+    result._compileTime = measureMicroseconds(result._numCompileAllocations, [&]() { result._isCompiled = frameGraph.compile(); });
+    if (result._isCompiled == false)
+    {
+        return result;
+    }
+
+    result._numEdges = static_cast<uint32_t>(graph._inputs.size() + graph._sinkInputs.size() + resourceHandles.size() + 1);
+    result._numExecutionBatches = frameGraph.getNumExecutionBatches();
+    result._numPlannedBarriers = frameGraph.getNumPlannedBarriers();
+    result._numTransientMemorySlots = frameGraph.getTransientMemoryStats()._numMemorySlots;
+    for (const RenderGraph::ResourceHandle handle : resourceHandles)
+    {
+        result._numCulledResources += frameGraph.getVirtualResource(handle)->isCulled() ? 1 : 0;
+    }
+
+    uint64_t numGraphVizAllocations = 0;
+    std::ostringstream osstr;
+    result._graphVizTime = measureMicroseconds(numGraphVizAllocations, [&]() { frameGraph.dumpGraphViz(osstr); });
+    result._graphVizBytes = osstr.str().size();
+
+    // Identical declaration in the next frame reuses the compile result of this frame
+    frameGraph.reset(nullptr, nullptr);
+    declareGraph(frameGraph, graph, resourceHandles);
+    result._cachedCompileTime = measureMicroseconds(result._numCachedCompileAllocations, [&]() { result._isCompiled = frameGraph.compile(); });
+    result._numArenaAllocations = frameGraph.getFrameArena().getNumAllocations();
+    result._numArenaHeapBlocks = frameGraph.getFrameArena().getNumHeapBlocks();
+
+    return result;
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkConfig& config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = (i + 1) < argc;
+
+        if ((argument == "--passes") && hasValue)
+        {
+            config._numPassesList.clear();
+            std::istringstream isstr(argv[++i]);
+            std::string token;
+            while (std::getline(isstr, token, ','))
+            {
+                config._numPassesList.push_back(static_cast<uint32_t>(std::stoul(token)));
+            }
+        }
+        else if ((argument == "--fan-in") && hasValue)
+            config._fanIn = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if ((argument == "--fan-out") && hasValue)
+            config._fanOut = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--window") && hasValue)
+            config._window = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--iterations") && hasValue)
+            config._numIterations = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1U);
+        else if ((argument == "--seed") && hasValue)
+            config._seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if ((argument == "--output") && hasValue)
+            config._outputPath = argv[++i];
+        else
+            return false;
+    }
+    return config._numPassesList.empty() == false;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig config;
+    if (parseArguments(argc, argv, config) == false)
+    {
+        std::cerr << "Usage: FrameGraphBenchmark [--passes 100,1000,10000,50000] [--fan-in 2] [--fan-out 1] [--window 32]"
+                     " [--iterations 5] [--seed 1234] [--output result.json]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    nlohmann::json report;
+    report["config"] = { { "fanIn", config._fanIn },
+                         { "fanOut", config._fanOut },
+                         { "window", config._window },
+                         { "iterations", config._numIterations },
+                         { "seed", config._seed } };
+    report["results"] = nlohmann::json::array();
+
+    bool isSucceeded = true;
+    for (const uint32_t numPasses : config._numPassesList)
+    {
+        const SyntheticGraph graph = generateGraph(config, numPasses);
+
+        std::vector<FrameResult> frameResults;
+        for (uint32_t iteration = 0; iteration < config._numIterations; ++iteration)
+        {
+            frameResults.push_back(runFrame(graph));
+            isSucceeded &= frameResults.back()._isCompiled;
+        }
+
+        const auto medianOf = [&frameResults](double FrameResult::*member) {
+            std::vector<double> values;
+            for (const FrameResult& frameResult : frameResults)
+            {
+                values.push_back(frameResult.*member);
+            }
+            return median(values);
+        };
+
+        // Structure is identical across iterations, so counts of the last frame represent all of them
+        const FrameResult& lastResult = frameResults.back();
+        report["results"].push_back({ { "passes", numPasses },
+                                      { "resources", numPasses * config._fanOut },
+                                      { "edges", lastResult._numEdges },
+                                      { "compiled", lastResult._isCompiled },
+                                      { "culledResources", lastResult._numCulledResources },
+                                      { "executionBatches", lastResult._numExecutionBatches },
+                                      { "plannedBarriers", lastResult._numPlannedBarriers },
+                                      { "transientMemorySlots", lastResult._numTransientMemorySlots },
+                                      { "graphVizBytes", lastResult._graphVizBytes },
+                                      { "timeMicroseconds",
+                                        { { "setup", medianOf(&FrameResult::_setupTime) },
+                                          { "compile", medianOf(&FrameResult::_compileTime) },
+                                          { "cachedCompile", medianOf(&FrameResult::_cachedCompileTime) },
+                                          { "dumpGraphViz", medianOf(&FrameResult::_graphVizTime) } } },
+                                      { "heapAllocations",
+                                        { { "setup", lastResult._numSetupAllocations },
+                                          { "compile", lastResult._numCompileAllocations },
+                                          { "cachedCompile", lastResult._numCachedCompileAllocations } } },
+                                      { "frameArena", { { "allocations", lastResult._numArenaAllocations }, { "heapBlocks", lastResult._numArenaHeapBlocks } } } });
+    }
+
+    const std::string reportText = report.dump(4);
+    if (config._outputPath.empty())
+    {
+        std::cout << reportText << std::endl;
+    }
+    else
+    {
+        std::ofstream outputFile(config._outputPath);
+        outputFile << reportText << std::endl;
+    }
+
+    return isSucceeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
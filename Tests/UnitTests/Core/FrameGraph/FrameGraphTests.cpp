@@ -1,13 +1,42 @@
 // Author : snowapril
 
 #include <VoxFlow/Core/FrameGraph/FrameGraph.hpp>
+#include <VoxFlow/Core/FrameGraph/FrameGraphBuffer.hpp>
 #include <VoxFlow/Core/FrameGraph/FrameGraphTexture.hpp>
 #include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <atomic>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 #include <fstream>
+#include <new>
+#include <thread>
+#include <tuple>
 #include "../../UnitTestUtils.hpp"
 
+// Count every heap allocation of the process so that steady-state frames can be checked to be allocation free.
+static std::atomic<uint64_t> sNumHeapAllocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    sNumHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 TEST_CASE("FrameGraph")
 {
     using namespace VoxFlow;
@@ -165,4 +194,1073 @@ TEST_CASE("FrameGraph")
     CHECK_EQ(samplePass1._isExecuted, true);
     CHECK_EQ(samplePass2._isExecuted, false);
     CHECK_EQ(samplePass3._isExecuted, true);
-}
\ No newline at end of file
+}
+
+static void buildChainedFrameGraph(VoxFlow::RenderGraph::FrameGraph& frameGraph, const uint32_t numPasses)
+{
+    using namespace VoxFlow;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct ChainPassData
+    {
+        RenderGraph::ResourceHandle _output;
+    };
+
+    // Each pass reads the output of the previous pass and the last pass writes to back buffer,
+    // so that no pass is culled and the number of edges grows linearly with the number of passes.
+    RenderGraph::ResourceHandle previousOutput;
+    for (uint32_t i = 0; i < numPasses; ++i)
+    {
+        const bool isLastPass = (i + 1) == numPasses;
+
+        const ChainPassData& passData = frameGraph.addCallbackPass<ChainPassData>(
+            "Chain Pass",
+            [&](RenderGraph::FrameGraphBuilder& builder, ChainPassData& data) {
+                if (previousOutput)
+                {
+                    builder.read<RenderGraph::FrameGraphTexture>(previousOutput, TextureUsage::Sampled);
+                }
+
+                if (isLastPass)
+                {
+                    data._output = builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+                }
+                else
+                {
+                    data._output = builder.allocate<RenderGraph::FrameGraphTexture>("Chain Output Texture",
+                                                                                    RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                    data._output = builder.write<RenderGraph::FrameGraphTexture>(data._output, TextureUsage::RenderTarget);
+                }
+            },
+            [](const RenderGraph::FrameGraphResources*, ChainPassData&, CommandStream*) {});
+
+        previousOutput = passData._output;
+    }
+}
+
+TEST_CASE("FrameGraph edge queries visit only edges adjacent to the node")
+{
+    using namespace VoxFlow;
+
+    constexpr uint32_t NUM_PASSES = 4096;
+
+    RenderGraph::FrameGraph frameGraph;
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+
+    const bool compileResult = frameGraph.compile();
+    CHECK_EQ(compileResult, true);
+
+    const DependencyGraph* dependencyGraph = frameGraph.getDependencyGraph();
+    const uint32_t numNodes = dependencyGraph->getNumNodes();
+    const DependencyGraph::EdgeContainer& linkedEdges = dependencyGraph->getLinkedEdges();
+
+    std::vector<uint32_t> inDegrees(numNodes, 0);
+    std::vector<uint32_t> outDegrees(numNodes, 0);
+    for (const DependencyGraph::Edge* edge : linkedEdges)
+    {
+        ++outDegrees[edge->_fromNodeID];
+        ++inDegrees[edge->_toNodeID];
+    }
+
+    // Queried spans hold exactly the adjacent edges, so walking every node visits each edge twice
+    // regardless of the graph size instead of scanning all edges per node.
+    size_t numVisitedEdges = 0;
+    for (DependencyGraph::NodeID nodeID = 0; nodeID < numNodes; ++nodeID)
+    {
+        const DependencyGraph::EdgeSpan incomingEdges = dependencyGraph->getIncomingEdges(nodeID);
+        const DependencyGraph::EdgeSpan outgoingEdges = dependencyGraph->getOutgoingEdges(nodeID);
+        CHECK_EQ(incomingEdges.size(), inDegrees[nodeID]);
+        CHECK_EQ(outgoingEdges.size(), outDegrees[nodeID]);
+
+        for (const DependencyGraph::Edge* edge : incomingEdges)
+        {
+            CHECK_EQ(edge->_toNodeID, nodeID);
+        }
+        for (const DependencyGraph::Edge* edge : outgoingEdges)
+        {
+            CHECK_EQ(edge->_fromNodeID, nodeID);
+        }
+
+        numVisitedEdges += incomingEdges.size() + outgoingEdges.size();
+    }
+
+    CHECK_EQ(numVisitedEdges, linkedEdges.size() * 2);
+    // Each chained pass reads the previous output and writes its own one
+    CHECK_LE(linkedEdges.size(), static_cast<size_t>(NUM_PASSES) * 2);
+}
+
+TEST_CASE("FrameGraph aliases transient textures with disjoint lifetimes")
+{
+    constexpr uint32_t NUM_PASSES = 5;
+    constexpr uint64_t TEXTURE_BYTES = 64 * 64 * 4;
+
+    VoxFlow::RenderGraph::FrameGraph frameGraph;
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+
+    const bool compileResult = frameGraph.compile();
+    CHECK_EQ(compileResult, true);
+
+    // Chain output i is alive only between pass i and i + 1, so every other output can share memory.
+    const VoxFlow::RenderGraph::FrameGraph::TransientMemoryStats& stats = frameGraph.getTransientMemoryStats();
+    CHECK_EQ(stats._numTransientResources, NUM_PASSES - 1);
+    CHECK_EQ(stats._numMemorySlots, 2);
+    CHECK_EQ(stats._peakBytesWithoutAliasing, TEXTURE_BYTES * (NUM_PASSES - 1));
+    CHECK_EQ(stats._peakBytesWithAliasing, TEXTURE_BYTES * 2);
+    CHECK_LT(stats._peakBytesWithAliasing, stats._peakBytesWithoutAliasing);
+}
+
+TEST_CASE("FrameGraph reuses compile result of identical structure")
+{
+    constexpr uint32_t NUM_PASSES = 5;
+
+    VoxFlow::RenderGraph::FrameGraph frameGraph;
+
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+    const uint64_t structureHash = frameGraph.getStructureHash();
+    CHECK_EQ(frameGraph.compile(), true);
+    const VoxFlow::RenderGraph::FrameGraph::TransientMemoryStats missStats = frameGraph.getTransientMemoryStats();
+
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 0);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numMisses, 1);
+
+    // Same declaration in the next frame must hit the cache and give the same compile result
+    frameGraph.reset(nullptr, nullptr);
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+    CHECK_EQ(frameGraph.getStructureHash(), structureHash);
+    CHECK_EQ(frameGraph.compile(), true);
+
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numMisses, 1);
+    CHECK_EQ(frameGraph.getTransientMemoryStats()._numMemorySlots, missStats._numMemorySlots);
+    CHECK_EQ(frameGraph.getTransientMemoryStats()._peakBytesWithAliasing, missStats._peakBytesWithAliasing);
+
+    // Structural change must invalidate the cache
+    frameGraph.reset(nullptr, nullptr);
+    buildChainedFrameGraph(frameGraph, NUM_PASSES + 1);
+    CHECK_NE(frameGraph.getStructureHash(), structureHash);
+    CHECK_EQ(frameGraph.compile(), true);
+
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numMisses, 2);
+}
+
+TEST_CASE("FrameGraph allocates per-frame graph from frame arena")
+{
+    constexpr uint32_t NUM_PASSES = 256;
+
+    VoxFlow::RenderGraph::FrameGraph frameGraph;
+
+    // The first frame grows the arena and the retained containers up to the size of the whole graph
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+    CHECK_EQ(frameGraph.compile(), true);
+    frameGraph.execute();
+    frameGraph.reset(nullptr, nullptr);
+
+    const uint64_t numHeapBlocks = frameGraph.getFrameArena().getNumHeapBlocks();
+    CHECK_GT(numHeapBlocks, 0);
+    CHECK_EQ(frameGraph.getFrameArena().getNumAllocations(), 0);
+
+    // Nodes, edges, passes, names and containers of the steady-state frame must not touch the heap at all.
+    // Passes of the chain are recorded in order, so that no recording task is spawned either.
+    const uint64_t numHeapAllocations = sNumHeapAllocations.load();
+
+    buildChainedFrameGraph(frameGraph, NUM_PASSES);
+    CHECK_EQ(frameGraph.compile(), true);
+    frameGraph.execute();
+    frameGraph.reset(nullptr, nullptr);
+
+    CHECK_EQ(sNumHeapAllocations.load() - numHeapAllocations, 0);
+    CHECK_EQ(frameGraph.getFrameArena().getNumHeapBlocks(), numHeapBlocks);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+}
+
+TEST_CASE("FrameGraph records independent passes in same execution batch")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct IndependentPassData
+    {
+        RenderGraph::ResourceHandle _output;
+        bool _isExecuted = false;
+    };
+
+    const auto addIndependentPass = [&](const char* outputName) -> const IndependentPassData& {
+        return frameGraph.addCallbackPass<IndependentPassData>(
+            "Independent Pass",
+            [&](RenderGraph::FrameGraphBuilder& builder, IndependentPassData& passData) {
+                passData._output =
+                    builder.allocate<RenderGraph::FrameGraphTexture>(outputName, RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::RenderTarget);
+            },
+            [](const RenderGraph::FrameGraphResources*, IndependentPassData& passData, CommandStream*) { passData._isExecuted = true; });
+    };
+
+    const IndependentPassData& independentPass1 = addIndependentPass("Independent Output 1");
+    const IndependentPassData& independentPass2 = addIndependentPass("Independent Output 2");
+
+    struct CompositePassData
+    {
+        bool _isExecuted = false;
+    };
+
+    const CompositePassData& compositePass = frameGraph.addCallbackPass<CompositePassData>(
+        "Composite Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, CompositePassData&) {
+            builder.read<RenderGraph::FrameGraphTexture>(independentPass1._output, TextureUsage::Sampled);
+            builder.read<RenderGraph::FrameGraphTexture>(independentPass2._output, TextureUsage::Sampled);
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, CompositePassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    CHECK_EQ(frameGraph.compile(), true);
+
+    // Two independent passes share the first batch and the composite pass waits for both of them
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 2);
+
+    // Outputs of concurrently recorded passes must not alias each other
+    CHECK_EQ(frameGraph.getTransientMemoryStats()._numMemorySlots, 2);
+
+    frameGraph.execute();
+
+    CHECK_EQ(independentPass1._isExecuted, true);
+    CHECK_EQ(independentPass2._isExecuted, true);
+    CHECK_EQ(compositePass._isExecuted, true);
+}
+
+TEST_CASE("FrameGraph transfers queue ownership only on cross queue edges")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct QueuePassData
+    {
+        RenderGraph::ResourceHandle _output;
+        bool _isExecuted = false;
+    };
+
+    const QueuePassData& gbufferPass = frameGraph.addCallbackPass<QueuePassData>(
+        "GBuffer Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, QueuePassData& passData) {
+            passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("GBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+            passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, QueuePassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    const QueuePassData& lightingPass = frameGraph.addCallbackPass<QueuePassData>(
+        "Async Lighting Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, QueuePassData& passData) {
+            builder.setQueueAffinity(CommandStreamUsage::Compute);
+            builder.read<RenderGraph::FrameGraphTexture>(gbufferPass._output, TextureUsage::Sampled);
+            passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("Lighting", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+            passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+        },
+        [](const RenderGraph::FrameGraphResources*, QueuePassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    const QueuePassData& compositePass = frameGraph.addCallbackPass<QueuePassData>(
+        "Composite Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, QueuePassData&) {
+            builder.read<RenderGraph::FrameGraphTexture>(lightingPass._output, TextureUsage::Sampled);
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, QueuePassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    CHECK_EQ(frameGraph.compile(), true);
+
+    // GBuffer is handed to compute queue and lighting result is handed back to graphics queue
+    CHECK_EQ(frameGraph.getNumQueueOwnershipTransfers(), 2);
+
+    // Without asynchronous command streams, every pass falls back to graphics one
+    frameGraph.execute();
+
+    CHECK_EQ(gbufferPass._isExecuted, true);
+    CHECK_EQ(lightingPass._isExecuted, true);
+    CHECK_EQ(compositePass._isExecuted, true);
+}
+
+TEST_CASE("FrameGraph plans split barriers across unrelated passes")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct BarrierPassData
+    {
+        RenderGraph::ResourceHandle _output;
+    };
+
+    const auto addWritePass = [&](const char* passName, const char* outputName, RenderGraph::ResourceHandle input) -> const BarrierPassData& {
+        return frameGraph.addCallbackPass<BarrierPassData>(
+            passName,
+            [&](RenderGraph::FrameGraphBuilder& builder, BarrierPassData& passData) {
+                if (input)
+                {
+                    builder.read<RenderGraph::FrameGraphTexture>(input, TextureUsage::Sampled);
+                }
+                passData._output = builder.allocate<RenderGraph::FrameGraphTexture>(outputName, RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::RenderTarget);
+            },
+            [](const RenderGraph::FrameGraphResources*, BarrierPassData&, CommandStream*) {});
+    };
+
+    // Shadow map is consumed two batches later, while bloom chain is processed between them
+    const BarrierPassData& shadowPass = addWritePass("Shadow Pass", "ShadowMap", RenderGraph::ResourceHandle());
+    const BarrierPassData& bloomPass = addWritePass("Bloom Pass", "Bloom", RenderGraph::ResourceHandle());
+    const BarrierPassData& blurPass = addWritePass("Blur Pass", "BlurredBloom", bloomPass._output);
+
+    frameGraph.addCallbackPass<BarrierPassData>(
+        "Composite Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, BarrierPassData&) {
+            builder.read<RenderGraph::FrameGraphTexture>(shadowPass._output, TextureUsage::Sampled);
+            builder.read<RenderGraph::FrameGraphTexture>(blurPass._output, TextureUsage::Sampled);
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, BarrierPassData&, CommandStream*) {});
+
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 3);
+
+    // One barrier per resource used by each pass, and only shadow map skips a batch
+    CHECK_EQ(frameGraph.getNumPlannedBarriers(), 7);
+    CHECK_EQ(frameGraph.getNumSplitBarriers(), 1);
+
+    frameGraph.execute();
+}
+
+TEST_CASE("FrameGraph merges render pass reading previous attachments into subpass")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor colorDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R16G16B16A16_SFLOAT
+    };
+    const RenderGraph::FrameGraphTexture::Descriptor depthDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_D32_SFLOAT_S8_UINT
+    };
+
+    struct SubpassTestData
+    {
+        RenderGraph::ResourceHandle _sceneColor;
+        RenderGraph::ResourceHandle _sceneDepth;
+        uint32_t _renderPassID = 0;
+    };
+
+    const auto buildSceneAndPostProcess = [&](TextureUsage sceneColorUsage) {
+        RenderGraph::ResourceHandle backBuffer = frameGraph.importRenderTarget(
+            "BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(colorDesc),
+            RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                   ._viewportSize = glm::uvec2(64, 64),
+                                                                   ._clearColor = glm::vec4(0.0f),
+                                                                   ._clearFlags = AttachmentMaskFlags::All,
+                                                                   ._writableAttachment = AttachmentMaskFlags::All,
+                                                                   ._numSamples = 1 },
+            nullptr);
+
+        const SubpassTestData& scenePass = frameGraph.addCallbackPass<SubpassTestData>(
+            "Scene Pass",
+            [&](RenderGraph::FrameGraphBuilder& builder, SubpassTestData& passData) {
+                passData._sceneColor = builder.allocate<RenderGraph::FrameGraphTexture>("SceneColor", RenderGraph::FrameGraphTexture::Descriptor(colorDesc));
+                passData._sceneDepth = builder.allocate<RenderGraph::FrameGraphTexture>("SceneDepth", RenderGraph::FrameGraphTexture::Descriptor(depthDesc));
+                builder.write<RenderGraph::FrameGraphTexture>(passData._sceneColor, TextureUsage::RenderTarget);
+                builder.write<RenderGraph::FrameGraphTexture>(passData._sceneDepth, TextureUsage::DepthStencil);
+
+                auto descriptor = RenderGraph::FrameGraphRenderPass::Descriptor{ ._viewportSize = glm::uvec2(64, 64), ._numSamples = 1 };
+                descriptor._attachments[0] = passData._sceneColor;
+                descriptor._attachments[MAX_RENDER_TARGET_COUNTS] = passData._sceneDepth;
+                descriptor._clearFlags = AttachmentMaskFlags::Color0 | AttachmentMaskFlags::DepthStencil;
+                passData._renderPassID = builder.declareRenderPass("Scene RenderPass", std::move(descriptor));
+            },
+            [](const RenderGraph::FrameGraphResources*, SubpassTestData&, CommandStream*) {});
+
+        frameGraph.addCallbackPass<SubpassTestData>(
+            "PostProcess Pass",
+            [&](RenderGraph::FrameGraphBuilder& builder, SubpassTestData& passData) {
+                builder.read<RenderGraph::FrameGraphTexture>(scenePass._sceneColor, sceneColorUsage);
+                builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+
+                auto descriptor = RenderGraph::FrameGraphRenderPass::Descriptor{ ._viewportSize = glm::uvec2(64, 64), ._numSamples = 1 };
+                descriptor._attachments[0] = backBuffer;
+                if (sceneColorUsage == TextureUsage::InputAttachment)
+                {
+                    descriptor._inputAttachments[0] = scenePass._sceneColor;
+                }
+                passData._renderPassID = builder.declareRenderPass("PostProcess RenderPass", std::move(descriptor));
+            },
+            [](const RenderGraph::FrameGraphResources*, SubpassTestData&, CommandStream*) {});
+    };
+
+    // Post process reading scene color at the same pixel becomes the second subpass of scene render pass
+    buildSceneAndPostProcess(TextureUsage::InputAttachment);
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getNumMergedSubpasses(), 1);
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 1);
+    frameGraph.execute();
+
+    // Merge must be applied to passes re-declared in the next frame as well
+    frameGraph.reset(nullptr, nullptr);
+    buildSceneAndPostProcess(TextureUsage::InputAttachment);
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+    CHECK_EQ(frameGraph.getNumMergedSubpasses(), 1);
+    frameGraph.execute();
+
+    // Sampling scene color may read the other pixels, so render passes are kept separated
+    frameGraph.reset(nullptr, nullptr);
+    buildSceneAndPostProcess(TextureUsage::Sampled);
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getNumMergedSubpasses(), 0);
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 2);
+    frameGraph.execute();
+}
+
+TEST_CASE("FrameGraph infers attachment load and store operations")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor colorDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R16G16B16A16_SFLOAT
+    };
+    const RenderGraph::FrameGraphTexture::Descriptor depthDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_D32_SFLOAT_S8_UINT
+    };
+
+    struct AttachmentTestData
+    {
+        RenderGraph::ResourceHandle _sceneColor;
+        RenderGraph::ResourceHandle _sceneDepth;
+        uint32_t _renderPassID = 0;
+    };
+
+    RenderGraph::ResourceHandle backBuffer = frameGraph.importRenderTarget(
+        "BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(colorDesc),
+        RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                               ._viewportSize = glm::uvec2(64, 64),
+                                                               ._clearColor = glm::vec4(0.0f),
+                                                               ._clearFlags = AttachmentMaskFlags::All,
+                                                               ._writableAttachment = AttachmentMaskFlags::All,
+                                                               ._numSamples = 1 },
+        nullptr);
+
+    RenderPassFlags scenePassFlags;
+    RenderPassFlags compositePassFlags;
+
+    const AttachmentTestData& scenePass = frameGraph.addCallbackPass<AttachmentTestData>(
+        "Scene Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, AttachmentTestData& passData) {
+            passData._sceneColor = builder.allocate<RenderGraph::FrameGraphTexture>("SceneColor", RenderGraph::FrameGraphTexture::Descriptor(colorDesc));
+            passData._sceneDepth = builder.allocate<RenderGraph::FrameGraphTexture>("SceneDepth", RenderGraph::FrameGraphTexture::Descriptor(depthDesc));
+            builder.write<RenderGraph::FrameGraphTexture>(passData._sceneColor, TextureUsage::RenderTarget);
+            builder.write<RenderGraph::FrameGraphTexture>(passData._sceneDepth, TextureUsage::DepthStencil);
+
+            auto descriptor = RenderGraph::FrameGraphRenderPass::Descriptor{ ._viewportSize = glm::uvec2(64, 64), ._numSamples = 1 };
+            descriptor._attachments[0] = passData._sceneColor;
+            descriptor._attachments[MAX_RENDER_TARGET_COUNTS] = passData._sceneDepth;
+            descriptor._clearFlags = AttachmentMaskFlags::Color0 | AttachmentMaskFlags::DepthStencil;
+            passData._renderPassID = builder.declareRenderPass("Scene RenderPass", std::move(descriptor));
+        },
+        [&](const RenderGraph::FrameGraphResources* fgResources, AttachmentTestData& passData, CommandStream*) {
+            scenePassFlags = fgResources->getRenderPassData(passData._renderPassID)->_passParams._attachmentFlags;
+        });
+
+    frameGraph.addCallbackPass<AttachmentTestData>(
+        "Composite Pass",
+        [&](RenderGraph::FrameGraphBuilder& builder, AttachmentTestData& passData) {
+            builder.read<RenderGraph::FrameGraphTexture>(scenePass._sceneColor, TextureUsage::Sampled);
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+
+            auto descriptor = RenderGraph::FrameGraphRenderPass::Descriptor{ ._viewportSize = glm::uvec2(64, 64), ._numSamples = 1 };
+            descriptor._attachments[0] = backBuffer;
+            passData._renderPassID = builder.declareRenderPass("Composite RenderPass", std::move(descriptor));
+        },
+        [&](const RenderGraph::FrameGraphResources* fgResources, AttachmentTestData& passData, CommandStream*) {
+            compositePassFlags = fgResources->getRenderPassData(passData._renderPassID)->_passParams._attachmentFlags;
+        });
+
+    CHECK_EQ(frameGraph.compile(), true);
+    frameGraph.execute();
+
+    // Scene attachments are first written in the scene pass, and only scene color is read later
+    CHECK_EQ(scenePassFlags._loadFlags, AttachmentMaskFlags::None);
+    CHECK_EQ(scenePassFlags._storeFlags, AttachmentMaskFlags::Color0);
+
+    // Imported back buffer keeps its content across the frame graph boundary
+    CHECK_EQ(compositePassFlags._loadFlags, AttachmentMaskFlags::Color0);
+    CHECK_EQ(compositePassFlags._storeFlags, AttachmentMaskFlags::Color0);
+
+    // Scene depth never leaves the scene render pass, while scene color is sampled by the composite pass
+    CHECK_EQ(frameGraph.getVirtualResource(scenePass._sceneDepth)->isTransientAttachment(), true);
+    CHECK_EQ(frameGraph.getVirtualResource(scenePass._sceneColor)->isTransientAttachment(), false);
+    CHECK_EQ(frameGraph.getVirtualResource(backBuffer)->isTransientAttachment(), false);
+}
+
+TEST_CASE("FrameGraph tracks transient buffers like textures")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct BufferPassData
+    {
+        RenderGraph::ResourceHandle _buffer;
+        bool _isExecuted = false;
+    };
+
+    const BufferPassData& simulatePass = frameGraph.addCallbackPass<BufferPassData>(
+        "Simulate Particles",
+        [&](RenderGraph::FrameGraphBuilder& builder, BufferPassData& passData) {
+            passData._buffer = builder.allocate<RenderGraph::FrameGraphBuffer>("ParticleBuffer", RenderGraph::FrameGraphBuffer::Descriptor{ ._size = 65536 });
+            passData._buffer = builder.write<RenderGraph::FrameGraphBuffer>(passData._buffer, BufferUsage::RwStructuredBuffer);
+        },
+        [](const RenderGraph::FrameGraphResources*, BufferPassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    const BufferPassData& scratchPass = frameGraph.addCallbackPass<BufferPassData>(
+        "Unused Scratch",
+        [&](RenderGraph::FrameGraphBuilder& builder, BufferPassData& passData) {
+            passData._buffer = builder.allocate<RenderGraph::FrameGraphBuffer>("ScratchBuffer", RenderGraph::FrameGraphBuffer::Descriptor{ ._size = 4096 });
+            passData._buffer = builder.write<RenderGraph::FrameGraphBuffer>(passData._buffer, BufferUsage::RwStructuredBuffer);
+        },
+        [](const RenderGraph::FrameGraphResources*, BufferPassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    const BufferPassData& drawPass = frameGraph.addCallbackPass<BufferPassData>(
+        "Draw Particles",
+        [&](RenderGraph::FrameGraphBuilder& builder, BufferPassData&) {
+            builder.read<RenderGraph::FrameGraphBuffer>(simulatePass._buffer, BufferUsage::VertexBuffer);
+            builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, BufferPassData& passData, CommandStream*) { passData._isExecuted = true; });
+
+    CHECK_EQ(frameGraph.compile(), true);
+
+    // Scratch buffer is never read, so its producer is culled as texture producers are
+    CHECK_EQ(frameGraph.getVirtualResource(scratchPass._buffer)->isCulled(), true);
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 2);
+
+    // Particle buffer transits from storage write to vertex input between simulation and draw
+    CHECK_EQ(frameGraph.getNumPlannedBarriers(), 3);
+
+    frameGraph.execute();
+
+    CHECK_EQ(simulatePass._isExecuted, true);
+    CHECK_EQ(scratchPass._isExecuted, false);
+    CHECK_EQ(drawPass._isExecuted, true);
+}
+
+TEST_CASE("FrameGraph versions resource on every write")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    RenderGraph::ResourceHandle backBuffer =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct VersionPassData
+    {
+        RenderGraph::ResourceHandle _output;
+        uint32_t _executionIndex = UINT32_MAX;
+    };
+
+    // Passes in the same batch are recorded concurrently
+    std::atomic<uint32_t> numExecutedPasses = 0;
+    const auto addPass = [&](const char* passName, auto&& setup) -> const VersionPassData& {
+        return frameGraph.addCallbackPass<VersionPassData>(
+            passName, std::forward<decltype(setup)>(setup),
+            [&](const RenderGraph::FrameGraphResources*, VersionPassData& passData, CommandStream*) { passData._executionIndex = numExecutedPasses++; });
+    };
+
+    // Lighting buffer is cleared, but fully overwritten by the lighting pass before anyone reads it
+    const VersionPassData& clearPass = addPass("Clear Lighting", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData& passData) {
+        passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("Lighting", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+        passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+    });
+    const VersionPassData& lightingPass = addPass("Lighting Pass", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData& passData) {
+        passData._output = builder.write<RenderGraph::FrameGraphTexture>(clearPass._output, TextureUsage::Storage);
+    });
+    const VersionPassData& shadowPass = addPass("Shadow Pass", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData& passData) {
+        passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("ShadowMap", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+        passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::RenderTarget);
+    });
+    const VersionPassData& bloomPass = addPass("Bloom Pass", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData& passData) {
+        builder.read<RenderGraph::FrameGraphTexture>(lightingPass._output, TextureUsage::Sampled);
+        passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("Bloom", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+        passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+    });
+    // Tone mapping overwrites lighting in place, so it only has to wait for the bloom pass reading the previous version
+    const VersionPassData& toneMapPass = addPass("ToneMap Pass", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData& passData) {
+        passData._output = builder.write<RenderGraph::FrameGraphTexture>(lightingPass._output, TextureUsage::Storage);
+    });
+    const VersionPassData& compositePass = addPass("Composite Pass", [&](RenderGraph::FrameGraphBuilder& builder, VersionPassData&) {
+        builder.read<RenderGraph::FrameGraphTexture>(toneMapPass._output, TextureUsage::Sampled);
+        builder.read<RenderGraph::FrameGraphTexture>(bloomPass._output, TextureUsage::Sampled);
+        builder.read<RenderGraph::FrameGraphTexture>(shadowPass._output, TextureUsage::Sampled);
+        builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+    });
+
+    CHECK_EQ(frameGraph.compile(), true);
+
+    // Lighting and shadow passes share the first level, followed by bloom, tone mapping and composite
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 4);
+    CHECK_EQ(frameGraph.getVirtualResource(clearPass._output)->isCulled(), false);
+
+    frameGraph.execute();
+
+    CHECK_EQ(clearPass._executionIndex, UINT32_MAX);
+    CHECK_LT(lightingPass._executionIndex, bloomPass._executionIndex);
+    CHECK_LT(shadowPass._executionIndex, bloomPass._executionIndex);
+    CHECK_LT(bloomPass._executionIndex, toneMapPass._executionIndex);
+    CHECK_LT(toneMapPass._executionIndex, compositePass._executionIndex);
+}
+
+static void declareFrameGraphConcurrently(VoxFlow::RenderGraph::FrameGraph& frameGraph, const bool isReversedLaunch)
+{
+    using namespace VoxFlow;
+
+    constexpr uint32_t NUM_CONCURRENT_SCOPES = 3;
+    constexpr const char* OUTPUT_NAMES[NUM_CONCURRENT_SCOPES] = { "GBuffer", "ShadowMap", "AmbientOcclusion" };
+    constexpr RenderGraph::BlackBoardKey OUTPUT_KEYS[NUM_CONCURRENT_SCOPES] = { "GBuffer", "ShadowMap", "AmbientOcclusion" };
+
+    const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+        ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+    };
+
+    frameGraph.getBlackBoard()["BackBuffer"] =
+        frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                      RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                             ._viewportSize = glm::uvec2(64, 64),
+                                                                                             ._clearColor = glm::vec4(0.0f),
+                                                                                             ._clearFlags = AttachmentMaskFlags::All,
+                                                                                             ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                             ._numSamples = 1 },
+                                      nullptr);
+
+    struct ScopePassData
+    {
+        RenderGraph::ResourceHandle _output;
+    };
+
+    // The last scope depends on the first one, and the others are declared at the same time
+    frameGraph.beginConcurrentDeclaration(NUM_CONCURRENT_SCOPES + 1);
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < NUM_CONCURRENT_SCOPES; ++i)
+    {
+        const uint32_t scopeIndex = isReversedLaunch ? (NUM_CONCURRENT_SCOPES - 1 - i) : i;
+        RenderGraph::FrameGraphDeclarationScope* scope = frameGraph.getDeclarationScope(scopeIndex);
+
+        threads.emplace_back([scope, outputName = OUTPUT_NAMES[scopeIndex], outputKey = OUTPUT_KEYS[scopeIndex], &textureDesc]() {
+            scope->addCallbackPass<ScopePassData>(
+                outputName,
+                [&](RenderGraph::FrameGraphBuilder& builder, ScopePassData& passData) {
+                    passData._output = builder.allocate<RenderGraph::FrameGraphTexture>(outputName, RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                    passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::RenderTarget);
+                    scope->getBlackBoard()[outputKey] = passData._output;
+                },
+                [](const RenderGraph::FrameGraphResources*, ScopePassData&, CommandStream*) {});
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    RenderGraph::FrameGraphDeclarationScope* lightingScope = frameGraph.getDeclarationScope(NUM_CONCURRENT_SCOPES);
+    lightingScope->addPrecedingScope(frameGraph.getDeclarationScope(0));
+    lightingScope->addCallbackPass<ScopePassData>(
+        "Lighting",
+        [&](RenderGraph::FrameGraphBuilder& builder, ScopePassData& passData) {
+            builder.read<RenderGraph::FrameGraphTexture>(lightingScope->getHandle(OUTPUT_KEYS[0]), TextureUsage::Sampled);
+            passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("Lighting", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+            passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+            lightingScope->getBlackBoard()["Lighting"] = passData._output;
+        },
+        [](const RenderGraph::FrameGraphResources*, ScopePassData&, CommandStream*) {});
+
+    frameGraph.endConcurrentDeclaration();
+
+    RenderGraph::BlackBoard& blackBoard = frameGraph.getBlackBoard();
+    frameGraph.addCallbackPass(
+        "Composite",
+        [&](RenderGraph::FrameGraphBuilder& builder) {
+            builder.read<RenderGraph::FrameGraphTexture>(blackBoard.getHandle("Lighting"), TextureUsage::Sampled);
+            builder.read<RenderGraph::FrameGraphTexture>(blackBoard.getHandle(OUTPUT_KEYS[1]), TextureUsage::Sampled);
+            builder.read<RenderGraph::FrameGraphTexture>(blackBoard.getHandle(OUTPUT_KEYS[2]), TextureUsage::Sampled);
+            builder.write<RenderGraph::FrameGraphTexture>(blackBoard.getHandle("BackBuffer"), TextureUsage::RenderTarget);
+        },
+        [](const RenderGraph::FrameGraphResources*, CommandStream*) {});
+}
+
+TEST_CASE("FrameGraph merges concurrent declarations in scope order")
+{
+    VoxFlow::RenderGraph::FrameGraph frameGraph;
+    VoxFlow::RenderGraph::FrameGraph reversedFrameGraph;
+
+    declareFrameGraphConcurrently(frameGraph, false);
+    declareFrameGraphConcurrently(reversedFrameGraph, true);
+
+    // Order of threads declaring the scopes must not affect the merged graph
+    CHECK_EQ(frameGraph.getStructureHash(), reversedFrameGraph.getStructureHash());
+
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(reversedFrameGraph.compile(), true);
+
+    std::ostringstream graphViz;
+    std::ostringstream reversedGraphViz;
+    frameGraph.dumpGraphViz(graphViz);
+    reversedFrameGraph.dumpGraphViz(reversedGraphViz);
+    CHECK_EQ(graphViz.str(), reversedGraphViz.str());
+
+    // Passes of the concurrent scopes share the first batch, followed by lighting and composite
+    CHECK_EQ(frameGraph.getNumExecutionBatches(), 3);
+
+    frameGraph.execute();
+
+    // Declaration scopes are reused in the next frame
+    frameGraph.reset(nullptr, nullptr);
+    declareFrameGraphConcurrently(frameGraph, true);
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+}
+
+TEST_CASE("FrameGraph ping-pongs history textures across frames")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+    std::atomic<uint32_t> numAccumulations = 0;
+
+    const auto declareFrame = [&](const uint32_t width, const TextureUsage usage = TextureUsage::Storage | TextureUsage::Sampled) {
+        const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+            ._width = width, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R16G16B16A16_SFLOAT
+        };
+
+        RenderGraph::FrameGraph::HistoryHandles historyHandles =
+            frameGraph.createHistory("Accumulation", RenderGraph::FrameGraphTexture::Descriptor(textureDesc), usage);
+
+        // Nothing reads the accumulated texture in this frame, but the pass must not be culled as the next frame does
+        frameGraph.addCallbackPass(
+            "Temporal Accumulation",
+            [&](RenderGraph::FrameGraphBuilder& builder) {
+                if (historyHandles._isHistoryValid)
+                {
+                    builder.readHistory<RenderGraph::FrameGraphTexture>(historyHandles._history, TextureUsage::Sampled);
+                }
+                builder.write<RenderGraph::FrameGraphTexture>(historyHandles._current, TextureUsage::Storage);
+            },
+            [&](const RenderGraph::FrameGraphResources*, CommandStream*) { ++numAccumulations; });
+
+        return historyHandles;
+    };
+
+    const auto getAllocationUsage = [&frameGraph](RenderGraph::ResourceHandle handle) {
+        return static_cast<const RenderGraph::HistoryTexture*>(frameGraph.getVirtualResource(handle))->getAllocationUsage();
+    };
+
+    RenderGraph::FrameGraph::HistoryHandles historyHandles = declareFrame(64);
+    CHECK_EQ(historyHandles._isHistoryValid, false);
+    CHECK_FALSE(historyHandles._current == historyHandles._history);
+    CHECK(frameGraph.getVirtualResource(historyHandles._current)->isPersistent());
+    CHECK_FALSE(frameGraph.getVirtualResource(historyHandles._current)->isReadOnly());
+    CHECK(frameGraph.getVirtualResource(historyHandles._history)->isReadOnly());
+    CHECK_EQ(frameGraph.compile(), true);
+
+    // History is not read in the first frame, but the textures are allocated with usage to be read in the next frame
+    const TextureUsage firstAllocationUsage = getAllocationUsage(historyHandles._current);
+    CHECK_EQ(firstAllocationUsage, TextureUsage::Storage | TextureUsage::Sampled);
+    frameGraph.execute();
+    CHECK_EQ(numAccumulations.load(), 1);
+
+    for (uint32_t frame = 1; frame < 3; ++frame)
+    {
+        frameGraph.reset(nullptr, nullptr);
+        historyHandles = declareFrame(64);
+        CHECK_EQ(historyHandles._isHistoryValid, true);
+        CHECK_EQ(frameGraph.compile(), true);
+
+        // Reading history must not change the usage, otherwise the textures are reallocated and the history is lost
+        CHECK_EQ(getAllocationUsage(historyHandles._current), firstAllocationUsage);
+        CHECK_EQ(getAllocationUsage(historyHandles._history), firstAllocationUsage);
+
+        // History textures have their own memory rather than being aliased with transient ones
+        CHECK_EQ(frameGraph.getTransientMemoryStats()._numTransientResources, 0);
+
+        frameGraph.execute();
+        CHECK_EQ(numAccumulations.load(), frame + 1);
+    }
+
+    // Changing descriptor reallocates the textures, so the history is lost
+    frameGraph.reset(nullptr, nullptr);
+    historyHandles = declareFrame(128);
+    CHECK_EQ(historyHandles._isHistoryValid, false);
+
+    // So does changing usage
+    frameGraph.reset(nullptr, nullptr);
+    historyHandles = declareFrame(128, TextureUsage::Storage | TextureUsage::Sampled | TextureUsage::CopySrc);
+    CHECK_EQ(historyHandles._isHistoryValid, false);
+
+    // Skipping a frame also invalidates the history
+    frameGraph.reset(nullptr, nullptr);
+    frameGraph.reset(nullptr, nullptr);
+    historyHandles = declareFrame(128, TextureUsage::Storage | TextureUsage::Sampled | TextureUsage::CopySrc);
+    CHECK_EQ(historyHandles._isHistoryValid, false);
+}
+
+TEST_CASE("FrameGraph skips disabled passes without recompiling")
+{
+    using namespace VoxFlow;
+
+    RenderGraph::FrameGraph frameGraph;
+    bool isDebugViewEnabled = false;
+    std::atomic<uint32_t> numSceneExecutions = 0;
+    std::atomic<uint32_t> numDebugExecutions = 0;
+
+    struct PassData
+    {
+        RenderGraph::ResourceHandle _output;
+    };
+
+    const auto declareFrame = [&]() {
+        const RenderGraph::FrameGraphTexture::Descriptor textureDesc{
+            ._width = 64, ._height = 64, ._depth = 1, ._level = 1, ._sampleCounts = 1, ._format = VK_FORMAT_R8G8B8A8_UNORM
+        };
+
+        RenderGraph::ResourceHandle backBuffer =
+            frameGraph.importRenderTarget("BackBuffer", RenderGraph::FrameGraphTexture::Descriptor(textureDesc),
+                                          RenderGraph::FrameGraphRenderPass::ImportedDescriptor{ ._attachmentSlot = AttachmentMaskFlags::All,
+                                                                                                 ._viewportSize = glm::uvec2(64, 64),
+                                                                                                 ._clearColor = glm::vec4(0.0f),
+                                                                                                 ._clearFlags = AttachmentMaskFlags::All,
+                                                                                                 ._writableAttachment = AttachmentMaskFlags::All,
+                                                                                                 ._numSamples = 1 },
+                                          nullptr);
+
+        const PassData& sceneData = frameGraph.addCallbackPass<PassData>(
+            "Scene",
+            [&](RenderGraph::FrameGraphBuilder& builder, PassData& passData) {
+                passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("SceneColor", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+            },
+            [&](const RenderGraph::FrameGraphResources*, PassData&, CommandStream*) { ++numSceneExecutions; });
+
+        frameGraph.addCallbackPass(
+            "Composite",
+            [&](RenderGraph::FrameGraphBuilder& builder) {
+                builder.read<RenderGraph::FrameGraphTexture>(sceneData._output, TextureUsage::Sampled);
+                builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+            },
+            [&](const RenderGraph::FrameGraphResources*, CommandStream*) { ++numSceneExecutions; });
+
+        // Scratch texture of debug view is referenced only by the predicated passes
+        const PassData& debugData = frameGraph.addCallbackPass<PassData>(
+            "Debug Prepass",
+            [&](RenderGraph::FrameGraphBuilder& builder, PassData& passData) {
+                builder.setEnablePredicate([&isDebugViewEnabled]() { return isDebugViewEnabled; });
+                passData._output = builder.allocate<RenderGraph::FrameGraphTexture>("DebugScratch", RenderGraph::FrameGraphTexture::Descriptor(textureDesc));
+                passData._output = builder.write<RenderGraph::FrameGraphTexture>(passData._output, TextureUsage::Storage);
+            },
+            [&](const RenderGraph::FrameGraphResources*, PassData&, CommandStream*) { ++numDebugExecutions; });
+
+        frameGraph.addCallbackPass(
+            "Debug View",
+            [&](RenderGraph::FrameGraphBuilder& builder) {
+                builder.setEnablePredicate([&isDebugViewEnabled]() { return isDebugViewEnabled; });
+                builder.read<RenderGraph::FrameGraphTexture>(debugData._output, TextureUsage::Sampled);
+                builder.write<RenderGraph::FrameGraphTexture>(backBuffer, TextureUsage::RenderTarget);
+            },
+            [&](const RenderGraph::FrameGraphResources*, CommandStream*) { ++numDebugExecutions; });
+
+        return std::make_pair(sceneData._output, debugData._output);
+    };
+
+    auto [sceneColor, debugScratch] = declareFrame();
+    CHECK_EQ(frameGraph.compile(), true);
+    frameGraph.execute();
+
+    CHECK_EQ(numSceneExecutions.load(), 2);
+    CHECK_EQ(numDebugExecutions.load(), 0);
+    CHECK(frameGraph.getVirtualResource(sceneColor)->isReferencedByEnabledPass());
+    CHECK_FALSE(frameGraph.getVirtualResource(debugScratch)->isReferencedByEnabledPass());
+
+    // Toggling predicate reuses the compile result of the previous frame
+    isDebugViewEnabled = true;
+    frameGraph.reset(nullptr, nullptr);
+    std::tie(sceneColor, debugScratch) = declareFrame();
+    CHECK_EQ(frameGraph.compile(), true);
+    CHECK_EQ(frameGraph.getCompileCacheStats()._numHits, 1);
+    frameGraph.execute();
+
+    CHECK_EQ(numSceneExecutions.load(), 4);
+    CHECK_EQ(numDebugExecutions.load(), 2);
+    CHECK(frameGraph.getVirtualResource(debugScratch)->isReferencedByEnabledPass());
+}
+
+TEST_CASE("FrameGraph keeps submit fences of the current frame only")
+{
+    using namespace VoxFlow;
+    using namespace RenderGraph;
+
+    // Fences are only compared, so queue instances are never dereferenced
+    Queue* graphicsQueue = reinterpret_cast<Queue*>(uintptr_t{ 0x10 });
+    Queue* computeQueue = reinterpret_cast<Queue*>(uintptr_t{ 0x20 });
+
+    FrameGraph frameGraph;
+    frameGraph.reset(nullptr, nullptr);
+    frameGraph.setFrameSubmitFence(CommandStreamUsage::Compute, FenceObject(computeQueue, 3));
+    frameGraph.setFrameSubmitFence(CommandStreamUsage::Graphics, FenceObject(graphicsQueue, 5));
+    frameGraph.setFrameSubmitFence(CommandStreamUsage::Graphics, FenceObject(graphicsQueue, 6));
+    frameGraph.setFrameSubmitFence(CommandStreamUsage::Graphics, FenceObject::Default());
+
+    const auto& frameFences = frameGraph.getFrameSubmitFences();
+    CHECK_EQ(frameFences[static_cast<uint32_t>(CommandStreamUsage::Graphics)].getFenceValue(), 6);
+    CHECK_EQ(frameFences[static_cast<uint32_t>(CommandStreamUsage::Compute)].getFenceValue(), 3);
+    CHECK_FALSE(frameFences[static_cast<uint32_t>(CommandStreamUsage::Transfer)].isValid());
+
+    // Frame without any submission must not carry the fences of the previous frame
+    frameGraph.reset(nullptr, nullptr);
+    for (const FenceObject& fence : frameGraph.getFrameSubmitFences())
+    {
+        CHECK_FALSE(fence.isValid());
+    }
+}
+
+TEST_CASE("BlackBoard stores typed entries with hashed keys")
+{
+    using namespace VoxFlow;
+
+    static_assert(RenderGraph::BlackBoardKey("BackBuffer").getHash() == hash_fnv1a("BackBuffer"), "Key must be hashed at compile time");
+
+    RenderGraph::BlackBoard blackBoard;
+    CHECK_EQ(blackBoard.getHandle("BackBuffer"), RenderGraph::INVALID_RESOURCE_HANDLE);
+
+    blackBoard["BackBuffer"] = RenderGraph::ResourceHandle(1U);
+    blackBoard["SceneColor"] = RenderGraph::ResourceHandle(2U);
+    CHECK_EQ(blackBoard.getHandle("BackBuffer"), RenderGraph::ResourceHandle(1U));
+    CHECK_EQ(blackBoard.getHandle("SceneColor"), RenderGraph::ResourceHandle(2U));
+
+    struct GBufferPassData
+    {
+        RenderGraph::ResourceHandle _albedo;
+        RenderGraph::ResourceHandle _normal;
+    };
+    const GBufferPassData gBufferData{ ._albedo = RenderGraph::ResourceHandle(3U), ._normal = RenderGraph::ResourceHandle(4U) };
+    blackBoard.setPassData("GBuffer", gBufferData);
+    CHECK_EQ(blackBoard.getPassData<GBufferPassData>("GBuffer"), &gBufferData);
+    CHECK_EQ(blackBoard.getHandle("GBuffer"), RenderGraph::INVALID_RESOURCE_HANDLE);
+    CHECK_EQ(blackBoard.getPassData<GBufferPassData>("SceneColor"), nullptr);
+
+    // Table grows while keeping published entries
+    constexpr RenderGraph::BlackBoardKey KEYS[] = { "Key0",  "Key1",  "Key2",  "Key3",  "Key4",  "Key5",  "Key6",  "Key7",
+                                                    "Key8",  "Key9",  "Key10", "Key11", "Key12", "Key13", "Key14", "Key15",
+                                                    "Key16", "Key17", "Key18", "Key19", "Key20", "Key21", "Key22", "Key23" };
+    for (uint32_t i = 0; i < std::size(KEYS); ++i)
+    {
+        blackBoard[KEYS[i]] = RenderGraph::ResourceHandle(100U + i);
+    }
+    CHECK_EQ(blackBoard.getNumEntries(), std::size(KEYS) + 3);
+    for (uint32_t i = 0; i < std::size(KEYS); ++i)
+    {
+        CHECK_EQ(blackBoard.getHandle(KEYS[i]), RenderGraph::ResourceHandle(100U + i));
+    }
+    CHECK_EQ(blackBoard.getPassData<GBufferPassData>("GBuffer"), &gBufferData);
+
+    CHECK(blackBoard.remove("SceneColor"));
+    CHECK_FALSE(blackBoard.remove("SceneColor"));
+    CHECK_EQ(blackBoard.getHandle("SceneColor"), RenderGraph::INVALID_RESOURCE_HANDLE);
+    CHECK_EQ(blackBoard.getHandle(KEYS[std::size(KEYS) - 1]), RenderGraph::ResourceHandle(100 + std::size(KEYS) - 1));
+
+    RenderGraph::BlackBoard scopeBlackBoard;
+    scopeBlackBoard["SceneColor"] = RenderGraph::ResourceHandle(5U);
+    scopeBlackBoard["BackBuffer"] = RenderGraph::ResourceHandle(6U);
+    blackBoard.merge(scopeBlackBoard);
+    CHECK_EQ(blackBoard.getHandle("SceneColor"), RenderGraph::ResourceHandle(5U));
+    CHECK_EQ(blackBoard.getHandle("BackBuffer"), RenderGraph::ResourceHandle(6U));
+
+    blackBoard.clear();
+    CHECK_EQ(blackBoard.getNumEntries(), 0);
+    CHECK_EQ(blackBoard.getHandle("BackBuffer"), RenderGraph::INVALID_RESOURCE_HANDLE);
+}
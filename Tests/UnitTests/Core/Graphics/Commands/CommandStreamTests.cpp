@@ -0,0 +1,179 @@
+// Author : snowapril
+
+#include <VoxFlow/Core/Devices/Instance.hpp>
+#include <VoxFlow/Core/Devices/LogicalDevice.hpp>
+#include <VoxFlow/Core/Devices/PhysicalDevice.hpp>
+#include <VoxFlow/Core/Devices/Queue.hpp>
+#include <VoxFlow/Core/Graphics/Commands/CommandJobSystem.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/GraphicsPipeline.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/PipelineStreamingContext.hpp>
+#include <VoxFlow/Core/Graphics/Pipelines/ResourceBindingLayout.hpp>
+#include <VoxFlow/Core/Graphics/RenderPass/RenderPassParams.hpp>
+#include <VoxFlow/Core/Graphics/RenderPass/RenderTargetGroup.hpp>
+#include <VoxFlow/Core/Resources/Texture.hpp>
+#include "../../../UnitTestUtils.hpp"
+
+TEST_CASE("CommandStream reuses command buffers of completed frames")
+{
+    VoxFlow::Instance instance(gVulkanContext);
+    VoxFlow::PhysicalDevice physicalDevice(&instance);
+    VoxFlow::LogicalDevice logicalDevice(gVulkanContext, &physicalDevice, &instance,
+        VoxFlow::LogicalDeviceType::MainDevice);
+
+    VoxFlow::Queue* gctQueue = logicalDevice.getQueuePtr("GCT");
+    {
+        VoxFlow::CommandStream cmdStream(&logicalDevice, gctQueue);
+
+        constexpr uint32_t NUM_FRAMES = VoxFlow::FRAME_BUFFER_COUNT * 4;
+        for (uint32_t frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+        {
+            cmdStream.beginFrame();
+            cmdStream.addJob<VoxFlow::CommandJobType::CommitPendingBarriers>();
+            cmdStream.flush(nullptr, nullptr, false);
+        }
+
+        // Only the first frame of each frame in flight allocates command buffer
+        const VoxFlow::CommandStreamStats stats = cmdStream.getStats();
+        CHECK_EQ(stats._numTranslatedCommandBuffers, NUM_FRAMES);
+        CHECK_EQ(stats._numAllocatedCommandBuffers, VoxFlow::FRAME_BUFFER_COUNT);
+
+        gctQueue->waitFenceValue(gctQueue->getLastExecutedFenceValue());
+    }
+    CHECK_EQ(VoxFlow::DebugUtil::NumValidationErrorDetected, 0);
+}
+
+TEST_CASE("CommandStream executes secondary command groups inside render pass")
+{
+    VoxFlow::Instance instance(gVulkanContext);
+    VoxFlow::PhysicalDevice physicalDevice(&instance);
+    VoxFlow::LogicalDevice logicalDevice(gVulkanContext, &physicalDevice, &instance,
+        VoxFlow::LogicalDeviceType::MainDevice);
+
+    VoxFlow::Queue* gctQueue = logicalDevice.getQueuePtr("GCT");
+    {
+        const glm::uvec2 resolution(64U, 64U);
+        VoxFlow::Texture colorTexture("SecondaryColor", &logicalDevice, logicalDevice.getDeviceDefaultResourceMemoryPool());
+        CHECK(colorTexture.makeAllocationResident(VoxFlow::TextureInfo{ ._extent = glm::uvec3(resolution.x, resolution.y, 1U),
+                                                                        ._format = VK_FORMAT_R8G8B8A8_UNORM,
+                                                                        ._imageType = VK_IMAGE_TYPE_2D,
+                                                                        ._usage = VoxFlow::TextureUsage::RenderTarget }));
+
+        std::vector<VoxFlow::Attachment> colorAttachments;
+        colorAttachments.emplace_back(colorTexture.getDefaultView());
+        const VoxFlow::AttachmentGroup attachmentGroup(std::move(colorAttachments), VoxFlow::Attachment(), 1);
+
+        VoxFlow::RenderPassParams passParams;
+        passParams._viewportSize = resolution;
+        passParams._useSecondaryCommandBuffers = true;
+
+        VoxFlow::CommandStream cmdStream(&logicalDevice, gctQueue);
+
+        constexpr uint32_t NUM_FRAMES = VoxFlow::FRAME_BUFFER_COUNT * 2;
+        constexpr uint32_t NUM_CHUNKS = 4;
+        for (uint32_t frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+        {
+            cmdStream.beginFrame();
+            cmdStream.addJob<VoxFlow::CommandJobType::BeginRenderPass>(attachmentGroup, passParams);
+
+            VoxFlow::SecondaryCommandGroup* secondaryCmdGroup = cmdStream.acquireSecondaryCommandGroup(NUM_CHUNKS);
+            for (uint32_t chunkIndex = 0; chunkIndex < NUM_CHUNKS; ++chunkIndex)
+            {
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::SetViewport>(chunkIndex, resolution);
+                // Dropped by shadow state of the secondary command buffer
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::SetViewport>(chunkIndex, resolution);
+            }
+            cmdStream.addJob<VoxFlow::CommandJobType::ExecuteSecondaryCommands>(secondaryCmdGroup);
+
+            cmdStream.addJob<VoxFlow::CommandJobType::EndRenderPass>();
+            cmdStream.flush(nullptr, nullptr, false);
+        }
+
+        // Secondary command buffers are reused together with the primary one of the same frame in flight
+        const VoxFlow::CommandStreamStats stats = cmdStream.getStats();
+        CHECK_EQ(stats._numTranslatedCommandBuffers, NUM_FRAMES * (NUM_CHUNKS + 1));
+        CHECK_EQ(stats._numAllocatedCommandBuffers, VoxFlow::FRAME_BUFFER_COUNT * (NUM_CHUNKS + 1));
+
+        const uint32_t viewportIndex = static_cast<uint32_t>(VoxFlow::StateCommandType::SetViewport);
+        CHECK_EQ(stats._stateCommandStats._numEmitted[viewportIndex], NUM_FRAMES * NUM_CHUNKS);
+        CHECK_EQ(stats._stateCommandStats._numSkipped[viewportIndex], NUM_FRAMES * NUM_CHUNKS);
+
+        // Statistics of the current frame are moved into the last frame ones when the next frame begins
+        cmdStream.beginFrame();
+        CHECK_EQ(cmdStream.getLastFrameStats()._stateCommandStats.getNumSkipped(), NUM_CHUNKS);
+
+        gctQueue->waitFenceValue(gctQueue->getLastExecutedFenceValue());
+    }
+    CHECK_EQ(VoxFlow::DebugUtil::NumValidationErrorDetected, 0);
+}
+
+TEST_CASE("CommandStream secondary chunks bind texture transited by the primary before render pass")
+{
+    VoxFlow::Instance instance(gVulkanContext);
+    VoxFlow::PhysicalDevice physicalDevice(&instance);
+    VoxFlow::LogicalDevice logicalDevice(gVulkanContext, &physicalDevice, &instance,
+        VoxFlow::LogicalDeviceType::MainDevice);
+
+    VoxFlow::Queue* gctQueue = logicalDevice.getQueuePtr("GCT");
+    {
+        const glm::uvec2 resolution(64U, 64U);
+        VoxFlow::Texture colorTexture("SecondaryColor", &logicalDevice, logicalDevice.getDeviceDefaultResourceMemoryPool());
+        CHECK(colorTexture.makeAllocationResident(VoxFlow::TextureInfo{ ._extent = glm::uvec3(resolution.x, resolution.y, 1U),
+                                                                        ._format = VK_FORMAT_R8G8B8A8_UNORM,
+                                                                        ._imageType = VK_IMAGE_TYPE_2D,
+                                                                        ._usage = VoxFlow::TextureUsage::RenderTarget }));
+        VoxFlow::Texture sampledTexture("SecondarySampled", &logicalDevice, logicalDevice.getDeviceDefaultResourceMemoryPool());
+        CHECK(sampledTexture.makeAllocationResident(VoxFlow::TextureInfo{ ._extent = glm::uvec3(resolution.x, resolution.y, 1U),
+                                                                          ._format = VK_FORMAT_R8G8B8A8_UNORM,
+                                                                          ._imageType = VK_IMAGE_TYPE_2D,
+                                                                          ._usage = VoxFlow::TextureUsage::Sampled }));
+        VoxFlow::TextureView* sampledView = sampledTexture.getDefaultView();
+
+        std::vector<VoxFlow::Attachment> colorAttachments;
+        colorAttachments.emplace_back(colorTexture.getDefaultView());
+        const VoxFlow::AttachmentGroup attachmentGroup(std::move(colorAttachments), VoxFlow::Attachment(), 1);
+
+        VoxFlow::RenderPassParams passParams;
+        passParams._viewportSize = resolution;
+        passParams._useSecondaryCommandBuffers = true;
+
+        std::shared_ptr<VoxFlow::GraphicsPipeline> pipeline =
+            logicalDevice.getPipelineStreamingContext()->createGraphicsPipeline({ "quad_screen.vert", "sampled_quad.frag" });
+
+        VoxFlow::CommandStream cmdStream(&logicalDevice, gctQueue);
+
+        constexpr uint32_t NUM_FRAMES = VoxFlow::FRAME_BUFFER_COUNT * 2;
+        constexpr uint32_t NUM_CHUNKS = 2;
+        for (uint32_t frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+        {
+            cmdStream.beginFrame();
+
+            // Same as the barrier planned by frame graph for the sampled texture of the pass
+            cmdStream.addJob<VoxFlow::CommandJobType::AddPlannedBarrier>(sampledView, VoxFlow::ResourceAccessMask::ShaderReadOnly,
+                                                                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            cmdStream.addJob<VoxFlow::CommandJobType::CommitPendingBarriers>();
+            cmdStream.addJob<VoxFlow::CommandJobType::BeginRenderPass>(attachmentGroup, passParams);
+
+            // Both chunks bind the same texture, so neither of them may transit it nor consume its planned barrier
+            VoxFlow::SecondaryCommandGroup* secondaryCmdGroup = cmdStream.acquireSecondaryCommandGroup(NUM_CHUNKS);
+            for (uint32_t chunkIndex = 0; chunkIndex < NUM_CHUNKS; ++chunkIndex)
+            {
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::BindPipeline>(chunkIndex, pipeline.get());
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::SetViewport>(chunkIndex, resolution);
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::BindResourceGroup>(
+                    chunkIndex, VoxFlow::SetSlotCategory::PerRenderPass,
+                    std::vector<VoxFlow::ShaderVariableBinding>{ { "uTex", sampledView, VoxFlow::ResourceAccessMask::ShaderReadOnly } });
+                secondaryCmdGroup->addJob<VoxFlow::CommandJobType::Draw>(chunkIndex, 3U, 1U, 0U, 0U);
+            }
+            cmdStream.addJob<VoxFlow::CommandJobType::ExecuteSecondaryCommands>(secondaryCmdGroup);
+
+            cmdStream.addJob<VoxFlow::CommandJobType::EndRenderPass>();
+            cmdStream.flush(nullptr, nullptr, false);
+
+            CHECK_EQ(sampledView->getCurrentVkImageLayout(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            CHECK(sampledView->hasPlannedAccess(VoxFlow::ResourceAccessMask::ShaderReadOnly));
+        }
+
+        gctQueue->waitFenceValue(gctQueue->getLastExecutedFenceValue());
+    }
+    CHECK_EQ(VoxFlow::DebugUtil::NumValidationErrorDetected, 0);
+}
@@ -35,8 +35,17 @@ TEST_CASE("Vulkan Graphics Pipeline Initialization")
         logicalDevice->getPipelineStreamingContext()->createGraphicsPipeline(
             { "test_shader.vert", "test_shader.frag" });
 
-    const bool result = testPipeline->initialize(renderPass.get());
+    const bool result = testPipeline->initialize(renderPass.get(), 0);
     CHECK_EQ(result, true);
     CHECK_NE(testPipeline.get(), VK_NULL_HANDLE);
+
+    // Vertex stage reads uScaleBias and fragment stage reads uTint of the same push constant block
+    const VoxFlow::PushConstantRange& pushConstantRange =
+        testPipeline->getPipelineLayout()->getPushConstantRange();
+    CHECK_EQ(pushConstantRange._offset, 0);
+    CHECK_EQ(pushConstantRange._size, 32);
+    CHECK_EQ(pushConstantRange._stageFlags,
+             static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT |
+                                             VK_SHADER_STAGE_FRAGMENT_BIT));
     CHECK_EQ(VoxFlow::DebugUtil::NumValidationErrorDetected, 0);
 }
\ No newline at end of file